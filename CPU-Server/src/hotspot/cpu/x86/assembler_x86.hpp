@@ -1665,6 +1665,10 @@ private:
   void evpmovwb(Address dst, KRegister mask, XMMRegister src, int vector_len);
 
   void vpmovzxwd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovzxwd(XMMRegister dst, Address src, int vector_len);
+  void vpmovsxwd(XMMRegister dst, Address src, int vector_len);
+  void vpmovzxbd(XMMRegister dst, Address src, int vector_len);
+  void vpmovsxbd(XMMRegister dst, Address src, int vector_len);
 
   void evpmovdb(Address dst, XMMRegister src, int vector_len);
 
@@ -2048,6 +2052,16 @@ private:
   void vpmulld(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
   void vpmullq(XMMRegister dst, XMMRegister nds, Address src, int vector_len);
 
+  // Minimum and maximum of packed signed integers (only ints)
+  void pminsd(XMMRegister dst, XMMRegister src);
+  void pmaxsd(XMMRegister dst, XMMRegister src);
+  void vpminsd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void vpmaxsd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+
+  // Absolute value of packed integers (only ints)
+  void pabsd(XMMRegister dst, XMMRegister src);
+  void vpabsd(XMMRegister dst, XMMRegister src, int vector_len);
+
   // Shift left packed integers
   void psllw(XMMRegister dst, int shift);
   void pslld(XMMRegister dst, int shift);
@@ -5188,6 +5188,166 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Loads eight elements of the given type, widened to ints, into dst.
+  void load_hash_elements(BasicType type, XMMRegister dst, Address src) {
+    switch (type) {
+    case T_BOOLEAN: __ vpmovzxbd(dst, src, Assembler::AVX_256bit); break;
+    case T_BYTE:    __ vpmovsxbd(dst, src, Assembler::AVX_256bit); break;
+    case T_CHAR:    __ vpmovzxwd(dst, src, Assembler::AVX_256bit); break;
+    case T_SHORT:   __ vpmovsxwd(dst, src, Assembler::AVX_256bit); break;
+    case T_INT:     __ vmovdqu(dst, src);                          break;
+    default:        ShouldNotReachHere();
+    }
+  }
+
+  // Loads a single element of the given type, widened to an int, into dst.
+  void load_hash_element(BasicType type, Register dst, Address src) {
+    switch (type) {
+    case T_BOOLEAN: __ movzbl(dst, src); break;
+    case T_BYTE:    __ movsbl(dst, src); break;
+    case T_CHAR:    __ movzwl(dst, src); break;
+    case T_SHORT:   __ movswl(dst, src); break;
+    case T_INT:     __ movl(dst, src);   break;
+    default:        ShouldNotReachHere();
+    }
+  }
+
+  // Hashes cnt elements of the given type at ary into result. Blocks of 32
+  // elements are accumulated lane-wise in four vectors which are scaled by
+  // 31^32 per block; the lanes are weighed by their power of 31 from the
+  // table at tbl and summed up once at the end. The remaining elements are
+  // hashed one at a time.
+  void vectorized_hash_loop(BasicType type, Register ary, Register cnt, Register result,
+                            Register tbl, Register tmp, Label& L_done) {
+    const int esize = type2aelembytes(type);
+    const XMMRegister vacc[] = { xmm0, xmm1, xmm2, xmm3 };
+    const XMMRegister vpow = xmm4;
+    const XMMRegister vtmp = xmm5;
+    Label L_vector_loop, L_tail, L_tail_loop;
+
+    __ cmpl(cnt, 32);
+    __ jcc(Assembler::less, L_tail);
+    for (int k = 0; k < 4; k++) {
+      __ vpxor(vacc[k], vacc[k], vacc[k], Assembler::AVX_256bit);
+    }
+    __ vpbroadcastd(vpow, Address(tbl, 32 * sizeof(jint)), Assembler::AVX_256bit);
+
+    __ align(OptoLoopAlignment);
+    __ bind(L_vector_loop);
+    __ imull(result, Address(tbl, 32 * sizeof(jint)));
+    for (int k = 0; k < 4; k++) {
+      load_hash_elements(type, vtmp, Address(ary, k * 8 * esize));
+      __ vpmulld(vacc[k], vacc[k], vpow, Assembler::AVX_256bit);
+      __ vpaddd(vacc[k], vacc[k], vtmp, Assembler::AVX_256bit);
+    }
+    __ addptr(ary, 32 * esize);
+    __ subl(cnt, 32);
+    __ cmpl(cnt, 32);
+    __ jcc(Assembler::greaterEqual, L_vector_loop);
+
+    // Weigh each lane by its power of 31 and add all lanes to result.
+    for (int k = 0; k < 4; k++) {
+      __ vpmulld(vacc[k], vacc[k], Address(tbl, k * 8 * sizeof(jint)), Assembler::AVX_256bit);
+    }
+    __ vpaddd(xmm0, xmm0, xmm1, Assembler::AVX_256bit);
+    __ vpaddd(xmm2, xmm2, xmm3, Assembler::AVX_256bit);
+    __ vpaddd(xmm0, xmm0, xmm2, Assembler::AVX_256bit);
+    __ vextracti128_high(vtmp, xmm0);
+    __ vpaddd(xmm0, xmm0, vtmp, Assembler::AVX_128bit);
+    __ pshufd(vtmp, xmm0, 0x4E);
+    __ vpaddd(xmm0, xmm0, vtmp, Assembler::AVX_128bit);
+    __ pshufd(vtmp, xmm0, 0xB1);
+    __ vpaddd(xmm0, xmm0, vtmp, Assembler::AVX_128bit);
+    __ movdl(tmp, xmm0);
+    __ addl(result, tmp);
+
+    __ bind(L_tail);
+    __ testl(cnt, cnt);
+    __ jcc(Assembler::zero, L_done);
+    __ bind(L_tail_loop);
+    __ imull(result, result, 31);
+    load_hash_element(type, tmp, Address(ary, 0));
+    __ addl(result, tmp);
+    __ addptr(ary, esize);
+    __ subl(cnt, 1);
+    __ jcc(Assembler::notZero, L_tail_loop);
+    __ jmp(L_done);
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - ary      address of the first element
+   *    c_rarg1   - cnt      number of elements
+   *    c_rarg2   - initial  initial hash value
+   *    c_rarg3   - type     BasicType of the elements
+   *
+   *  Output:
+   *        rax   - int hash, computed as h = 31 * h + e over all elements
+   */
+  address generate_vectorizedHashCode() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedHashCode");
+
+    // Powers of 31: entry i holds 31^(31-i), the weight of lane i of a
+    // 32-element block, and entry 32 holds 31^32, the weight of a block.
+    address powers = __ pc();
+    juint table[33];
+    juint power = 1;
+    for (int i = 31; i >= 0; i--) {
+      table[i] = power;
+      power *= 31;
+    }
+    table[32] = power;
+    for (int i = 0; i < 33; i++) {
+      __ emit_int32(table[i]);
+    }
+
+    __ align(CodeEntryAlignment);
+    address start = __ pc();
+
+    const Register ary    = c_rarg0;
+    const Register cnt    = c_rarg1;
+    const Register type   = c_rarg3;
+    const Register result = rax;
+    const Register tbl    = r10;
+    const Register tmp    = r11;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+
+    __ movl(result, c_rarg2);
+    __ lea(tbl, InternalAddress(powers));
+
+    Label L_boolean, L_byte, L_char, L_short, L_done;
+    __ cmpl(type, T_BOOLEAN);
+    __ jcc(Assembler::equal, L_boolean);
+    __ cmpl(type, T_BYTE);
+    __ jcc(Assembler::equal, L_byte);
+    __ cmpl(type, T_CHAR);
+    __ jcc(Assembler::equal, L_char);
+    __ cmpl(type, T_SHORT);
+    __ jcc(Assembler::equal, L_short);
+
+    vectorized_hash_loop(T_INT, ary, cnt, result, tbl, tmp, L_done);
+    __ bind(L_boolean);
+    vectorized_hash_loop(T_BOOLEAN, ary, cnt, result, tbl, tmp, L_done);
+    __ bind(L_byte);
+    vectorized_hash_loop(T_BYTE, ary, cnt, result, tbl, tmp, L_done);
+    __ bind(L_char);
+    vectorized_hash_loop(T_CHAR, ary, cnt, result, tbl, tmp, L_done);
+    __ bind(L_short);
+    vectorized_hash_loop(T_SHORT, ary, cnt, result, tbl, tmp, L_done);
+
+    __ bind(L_done);
+    __ vzeroupper();
+    __ leave();
+    __ ret(0);
+
+    return start;
+  }
+
 /**
    *  Arguments:
    *
@@ -5984,6 +6144,10 @@ address generate_avx_ghash_processBlocks() {
     if (UseVectorizedMismatchIntrinsic) {
       StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
     }
+
+    if (UseVectorizedHashCodeIntrinsic) {
+      StubRoutines::_vectorizedHashCode = generate_vectorizedHashCode();
+    }
   }
 
  public:
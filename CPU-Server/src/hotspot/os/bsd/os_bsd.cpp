@@ -1978,6 +1978,10 @@ int os::numa_get_group_id() {
   return 0;
 }
 
+int os::numa_get_group_id_for_address(const void* address) {
+  return 0;
+}
+
 size_t os::numa_get_leaf_groups(int *ids, size_t size) {
   if (size > 0) {
     ids[0] = 0;
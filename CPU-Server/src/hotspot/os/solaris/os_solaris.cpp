@@ -2383,6 +2383,15 @@ int os::numa_get_group_id() {
   return ids[os::random() % r];
 }
 
+// Get the lgroup id the page containing the given address is homed on.
+int os::numa_get_group_id_for_address(const void* address) {
+  page_info info;
+  if (os::get_page_info((char*)address, &info)) {
+    return info.lgrp_id;
+  }
+  return -1;
+}
+
 // Request information about the page.
 bool os::get_page_info(char *start, page_info* info) {
   const uint_t info_types[] = { MEMINFO_VLGRP, MEMINFO_VPAGESIZE };
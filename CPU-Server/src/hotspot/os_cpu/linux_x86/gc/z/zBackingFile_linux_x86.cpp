@@ -28,6 +28,7 @@
 #include "gc/z/zErrno.hpp"
 #include "gc/z/zLargePages.inline.hpp"
 #include "logging/log.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/os.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
@@ -65,6 +66,12 @@
 #ifndef O_TMPFILE
 #define O_TMPFILE                        (020000000 | O_DIRECTORY)
 #endif
+#ifndef FALLOC_FL_KEEP_SIZE
+#define FALLOC_FL_KEEP_SIZE              0x01
+#endif
+#ifndef FALLOC_FL_PUNCH_HOLE
+#define FALLOC_FL_PUNCH_HOLE             0x02
+#endif
 
 // Filesystem types, see statfs(2)
 #ifndef TMPFS_MAGIC
@@ -150,6 +157,12 @@ ZBackingFile::ZBackingFile() :
     return;
   }
 
+  // Make sure the filesystem supports uncommitting memory
+  if (ZUncommit && !try_punch_hole(0, granule_size())) {
+    log_info(gc, init)("Backing filesystem does not support uncommit");
+    FLAG_SET_ERGO(bool, ZUncommit, false);
+  }
+
   // Successfully initialized
   _initialized = true;
 }
@@ -280,6 +293,25 @@ bool ZBackingFile::tmpfs_supports_transparent_huge_pages() const {
   return access(ZFILENAME_SHMEM_ENABLED, R_OK) == 0;
 }
 
+size_t ZBackingFile::granule_size() const {
+  return is_hugetlbfs() ? os::large_page_size() : os::vm_page_size();
+}
+
+bool ZBackingFile::try_punch_hole(size_t offset, size_t length) const {
+  // Punching a hole deallocates the backing pages, without changing
+  // the file size, and is supported on tmpfs and, since kernel 4.3,
+  // also on hugetlbfs.
+  while (fallocate(_fd, FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE, offset, length) == -1) {
+    ZErrno err;
+    if (err != EINTR) {
+      log_debug(gc)("Failed to punch hole in backing file (%s)", err.to_string());
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool ZBackingFile::try_split_and_expand_tmpfs(size_t offset, size_t length, size_t alignment) const {
   // Try first smaller part.
   const size_t offset0 = offset;
@@ -332,8 +364,16 @@ bool ZBackingFile::try_expand_hugetlbfs(size_t offset, size_t length) const {
   // Instead of posix_fallocate() we can use a well-known workaround,
   // which involves truncating the file to requested size and then try
   // to map it to verify that there are enough huge pages available to
-  // back it.
-  while (ftruncate(_fd, offset + length) == -1) {
+  // back it. The requested range might be a hole left by an earlier
+  // uncommit, in which case the file must not be truncated.
+  struct stat stat_buf;
+  if (fstat(_fd, &stat_buf) == -1) {
+    ZErrno err;
+    log_error(gc)("Failed to determine size of backing file (%s)", err.to_string());
+    return false;
+  }
+
+  while ((size_t)stat_buf.st_size < offset + length && ftruncate(_fd, offset + length) == -1) {
     ZErrno err;
     if (err != EINTR) {
       log_error(gc)("Failed to truncate backing file (%s)", err.to_string());
@@ -424,3 +464,18 @@ size_t ZBackingFile::try_expand(size_t offset, size_t length, size_t alignment)
     }
   }
 }
+
+bool ZBackingFile::uncommit(size_t offset, size_t length) const {
+  assert(is_aligned(offset, granule_size()), "Invalid offset");
+  assert(is_aligned(length, granule_size()), "Invalid length");
+
+  log_debug(gc)("Uncommitting memory: " SIZE_FORMAT "M-" SIZE_FORMAT "M (" SIZE_FORMAT "M)",
+                offset / M, (offset + length) / M, length / M);
+
+  if (!try_punch_hole(offset, length)) {
+    log_error(gc)("Failed to uncommit memory");
+    return false;
+  }
+
+  return true;
+}
@@ -43,6 +43,9 @@ private:
   bool is_hugetlbfs() const;
   bool tmpfs_supports_transparent_huge_pages() const;
 
+  size_t granule_size() const;
+  bool try_punch_hole(size_t offset, size_t length) const;
+
   bool try_split_and_expand_tmpfs(size_t offset, size_t length, size_t alignment) const;
   bool try_expand_tmpfs(size_t offset, size_t length, size_t alignment) const;
   bool try_expand_tmpfs(size_t offset, size_t length) const;
@@ -58,6 +61,7 @@ public:
   size_t available() const;
 
   size_t try_expand(size_t offset, size_t length, size_t alignment) const;
+  bool uncommit(size_t offset, size_t length) const;
 };
 
 #endif // OS_CPU_LINUX_X86_ZBACKINGFILE_LINUX_X86_HPP
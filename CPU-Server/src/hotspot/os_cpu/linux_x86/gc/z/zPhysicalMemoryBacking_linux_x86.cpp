@@ -48,7 +48,8 @@
 #define ZFILENAME_PROC_MAX_MAP_COUNT         "/proc/sys/vm/max_map_count"
 
 ZPhysicalMemoryBacking::ZPhysicalMemoryBacking(size_t max_capacity, size_t granule_size) :
-    _manager(),
+    _committed(),
+    _uncommitted(),
     _file(),
     _granule_size(granule_size) {
 
@@ -56,6 +57,9 @@ ZPhysicalMemoryBacking::ZPhysicalMemoryBacking(size_t max_capacity, size_t granu
     return;
   }
 
+  // Initially, all of the backing file is uncommitted
+  _uncommitted.free(0, max_capacity);
+
   // Check and warn if max map count is too low
   check_max_map_count(max_capacity, granule_size);
 
@@ -132,16 +136,60 @@ bool ZPhysicalMemoryBacking::is_initialized() const {
   return _file.is_initialized();
 }
 
-size_t ZPhysicalMemoryBacking::try_expand(size_t old_capacity, size_t new_capacity) {
-  assert(old_capacity < new_capacity, "Invalid old/new capacity");
+size_t ZPhysicalMemoryBacking::commit(size_t size) {
+  size_t committed = 0;
+
+  // Fill holes in the backing file
+  while (committed < size) {
+    size_t allocated = 0;
+    const size_t remaining = size - committed;
+    const uintptr_t start = _uncommitted.alloc_from_front_at_most(remaining, &allocated);
+    if (start == UINTPTR_MAX) {
+      // No holes to commit
+      break;
+    }
+
+    // Try commit hole
+    const size_t end = _file.try_expand(start, allocated, _granule_size);
+    const size_t filled = end - start;
+    if (filled > 0) {
+      // Successful or partially successful
+      _committed.free(start, filled);
+      committed += filled;
+    }
+
+    if (filled < allocated) {
+      // Failed or partially failed
+      _uncommitted.free(start + filled, allocated - filled);
+      break;
+    }
+  }
+
+  return committed;
+}
+
+size_t ZPhysicalMemoryBacking::uncommit(size_t size) {
+  size_t uncommitted = 0;
+
+  // Punch holes in the backing file, starting from the
+  // end, to keep the committed memory compact.
+  while (uncommitted < size) {
+    size_t allocated = 0;
+    const size_t remaining = size - uncommitted;
+    const uintptr_t start = _committed.alloc_from_back_at_most(remaining, &allocated);
+    assert(start != UINTPTR_MAX, "Allocation should never fail");
+
+    if (!_file.uncommit(start, allocated)) {
+      // Failed, give the memory back
+      _committed.free(start, allocated);
+      break;
+    }
 
-  const size_t capacity = _file.try_expand(old_capacity, new_capacity - old_capacity, _granule_size);
-  if (capacity > old_capacity) {
-    // Add expanded capacity to free list
-    _manager.free(old_capacity, capacity - old_capacity);
+    _uncommitted.free(start, allocated);
+    uncommitted += allocated;
   }
 
-  return capacity;
+  return uncommitted;
 }
 
 ZPhysicalMemory ZPhysicalMemoryBacking::alloc(size_t size) {
@@ -151,7 +199,7 @@ ZPhysicalMemory ZPhysicalMemoryBacking::alloc(size_t size) {
 
   // Allocate segments
   for (size_t allocated = 0; allocated < size; allocated += _granule_size) {
-    const uintptr_t start = _manager.alloc_from_front(_granule_size);
+    const uintptr_t start = _committed.alloc_from_front(_granule_size);
     assert(start != UINTPTR_MAX, "Allocation should never fail");
     pmem.add_segment(ZPhysicalMemorySegment(start, _granule_size));
   }
@@ -165,7 +213,7 @@ void ZPhysicalMemoryBacking::free(ZPhysicalMemory pmem) {
   // Free segments
   for (size_t i = 0; i < nsegments; i++) {
     const ZPhysicalMemorySegment segment = pmem.segment(i);
-    _manager.free(segment.start(), segment.size());
+    _committed.free(segment.start(), segment.size());
   }
 }
 
@@ -32,7 +32,8 @@ class ZPhysicalMemory;
 
 class ZPhysicalMemoryBacking {
 private:
-  ZMemoryManager _manager;
+  ZMemoryManager _committed;
+  ZMemoryManager _uncommitted;
   ZBackingFile   _file;
   const size_t   _granule_size;
 
@@ -50,7 +51,8 @@ public:
 
   bool is_initialized() const;
 
-  size_t try_expand(size_t old_capacity, size_t new_capacity);
+  size_t commit(size_t size);
+  size_t uncommit(size_t size);
 
   ZPhysicalMemory alloc(size_t size);
   void free(ZPhysicalMemory pmem);
@@ -1566,37 +1566,53 @@ void LinearScan::sort_intervals_before_allocation() {
   int unsorted_len = unsorted_list->length();
   int sorted_len = 0;
   int unsorted_idx;
-  int sorted_idx = 0;
-  int sorted_from_max = -1;
+  int from_max = -1;
+  bool already_sorted = true;
 
   // calc number of items for sorted list (sorted list must not contain NULL values)
+  // and check if the original interval-list happens to be sorted already
   for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
-    if (unsorted_list->at(unsorted_idx) != NULL) {
+    Interval* cur_interval = unsorted_list->at(unsorted_idx);
+    if (cur_interval != NULL) {
+      int cur_from = cur_interval->from();
+      if (cur_from < from_max) {
+        already_sorted = false;
+      } else {
+        from_max = cur_from;
+      }
       sorted_len++;
     }
   }
   IntervalArray* sorted_list = new IntervalArray(sorted_len, sorted_len, NULL);
 
-  // special sorting algorithm: the original interval-list is almost sorted,
-  // only some intervals are swapped. So this is much faster than a complete QuickSort
-  for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
-    Interval* cur_interval = unsorted_list->at(unsorted_idx);
-
-    if (cur_interval != NULL) {
-      int cur_from = cur_interval->from();
-
-      if (sorted_from_max <= cur_from) {
+  if (already_sorted) {
+    int sorted_idx = 0;
+    for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
+      Interval* cur_interval = unsorted_list->at(unsorted_idx);
+      if (cur_interval != NULL) {
         sorted_list->at_put(sorted_idx++, cur_interval);
-        sorted_from_max = cur_interval->from();
-      } else {
-        // the asumption that the intervals are already sorted failed,
-        // so this interval must be sorted in manually
-        int j;
-        for (j = sorted_idx - 1; j >= 0 && cur_from < sorted_list->at(j)->from(); j--) {
-          sorted_list->at_put(j + 1, sorted_list->at(j));
-        }
-        sorted_list->at_put(j + 1, cur_interval);
-        sorted_idx++;
+      }
+    }
+  } else {
+    // The original interval-list is almost sorted, but in large methods even a
+    // few misplaced intervals make an insertion sort quadratic. Interval::from()
+    // is bounded by the number of LIR operations, so use a stable counting sort.
+    intArray start_idx(from_max + 2, from_max + 2, 0);
+    for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
+      Interval* cur_interval = unsorted_list->at(unsorted_idx);
+      if (cur_interval != NULL) {
+        start_idx.at_put(cur_interval->from() + 1, start_idx.at(cur_interval->from() + 1) + 1);
+      }
+    }
+    for (int from = 1; from <= from_max + 1; from++) {
+      start_idx.at_put(from, start_idx.at(from) + start_idx.at(from - 1));
+    }
+    for (unsorted_idx = 0; unsorted_idx < unsorted_len; unsorted_idx++) {
+      Interval* cur_interval = unsorted_list->at(unsorted_idx);
+      if (cur_interval != NULL) {
+        int sorted_idx = start_idx.at(cur_interval->from());
+        sorted_list->at_put(sorted_idx, cur_interval);
+        start_idx.at_put(cur_interval->from(), sorted_idx + 1);
       }
     }
   }
@@ -4312,11 +4328,30 @@ int Interval::first_usage(IntervalUseKind min_use_kind) const {
   return max_jint;
 }
 
+// Returns the index of the lowest use position >= from, or -2 if there is none.
+// Intervals of large methods can have thousands of use positions, so a binary
+// search is used instead of scanning the list from the first use position.
+int Interval::next_use_pos_index(int from) const {
+  int lo = 0;
+  int hi = _use_pos_and_kinds.length() / 2 - 1;
+  int found = -1;
+  while (lo <= hi) {
+    int mid = (lo + hi) >> 1;
+    if (_use_pos_and_kinds.at(mid * 2) >= from) {
+      found = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return found * 2;
+}
+
 int Interval::next_usage(IntervalUseKind min_use_kind, int from) const {
   assert(LinearScan::is_virtual_interval(this), "cannot access use positions for fixed intervals");
 
-  for (int i = _use_pos_and_kinds.length() - 2; i >= 0; i -= 2) {
-    if (_use_pos_and_kinds.at(i) >= from && _use_pos_and_kinds.at(i + 1) >= min_use_kind) {
+  for (int i = next_use_pos_index(from); i >= 0; i -= 2) {
+    if (_use_pos_and_kinds.at(i + 1) >= min_use_kind) {
       return _use_pos_and_kinds.at(i);
     }
   }
@@ -4326,8 +4361,8 @@ int Interval::next_usage(IntervalUseKind min_use_kind, int from) const {
 int Interval::next_usage_exact(IntervalUseKind exact_use_kind, int from) const {
   assert(LinearScan::is_virtual_interval(this), "cannot access use positions for fixed intervals");
 
-  for (int i = _use_pos_and_kinds.length() - 2; i >= 0; i -= 2) {
-    if (_use_pos_and_kinds.at(i) >= from && _use_pos_and_kinds.at(i + 1) == exact_use_kind) {
+  for (int i = next_use_pos_index(from); i >= 0; i -= 2) {
+    if (_use_pos_and_kinds.at(i + 1) == exact_use_kind) {
       return _use_pos_and_kinds.at(i);
     }
   }
@@ -4337,16 +4372,17 @@ int Interval::next_usage_exact(IntervalUseKind exact_use_kind, int from) const {
 int Interval::previous_usage(IntervalUseKind min_use_kind, int from) const {
   assert(LinearScan::is_virtual_interval(this), "cannot access use positions for fixed intervals");
 
-  int prev = 0;
-  for (int i = _use_pos_and_kinds.length() - 2; i >= 0; i -= 2) {
-    if (_use_pos_and_kinds.at(i) > from) {
-      return prev;
-    }
+  // start at the highest use position <= from and search downwards
+  int start = next_use_pos_index(from);
+  if (start < 0 || _use_pos_and_kinds.at(start) != from) {
+    start += 2;
+  }
+  for (int i = start; i < _use_pos_and_kinds.length(); i += 2) {
     if (_use_pos_and_kinds.at(i + 1) >= min_use_kind) {
-      prev = _use_pos_and_kinds.at(i);
+      return _use_pos_and_kinds.at(i);
     }
   }
-  return prev;
+  return 0;
 }
 
 void Interval::add_use_pos(int pos, IntervalUseKind use_kind) {
@@ -4855,6 +4891,7 @@ void IntervalWalker::interval_moved(Interval* interval, IntervalKind kind, Inter
 
 LinearScanWalker::LinearScanWalker(LinearScan* allocator, Interval* unhandled_fixed_first, Interval* unhandled_any_first)
   : IntervalWalker(allocator, unhandled_fixed_first, unhandled_any_first)
+  , _limit_split_search(LinearScanLargeMethodThreshold > 0 && allocator->interval_count() > LinearScanLargeMethodThreshold)
   , _move_resolver(allocator)
 {
   for (int i = 0; i < LinearScan::nof_regs; i++) {
@@ -5068,8 +5105,17 @@ int LinearScanWalker::find_optimal_split_pos(BlockBegin* min_block, BlockBegin*
     optimal_split_pos = max_block->first_lir_instruction_id();
   }
 
+  // In very large methods, searching all blocks for every split dominates the
+  // compile time, so only the blocks just before max_block are considered.
+  // Such methods are still allocated by the full linear scan; a split may
+  // just land in a block with a higher loop depth than necessary.
+  int first_block_nr = from_block_nr;
+  if (_limit_split_search) {
+    first_block_nr = MAX2(from_block_nr, to_block_nr - (int)split_search_limit);
+  }
+
   int min_loop_depth = max_block->loop_depth();
-  for (int i = to_block_nr - 1; i >= from_block_nr; i--) {
+  for (int i = to_block_nr - 1; i >= first_block_nr; i--) {
     BlockBegin* cur = block_at(i);
 
     if (cur->loop_depth() < min_loop_depth) {
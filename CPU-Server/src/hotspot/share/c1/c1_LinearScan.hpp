@@ -534,6 +534,7 @@ class Interval : public CompilationResourceObj {
 
   int              calc_to();
   Interval*        new_split_child();
+  int              next_use_pos_index(int from) const;
  public:
   Interval(int reg_num);
 
@@ -701,7 +702,8 @@ class IntervalWalker : public CompilationResourceObj {
 // The actual linear scan register allocator
 class LinearScanWalker : public IntervalWalker {
   enum {
-    any_reg = LinearScan::any_reg
+    any_reg = LinearScan::any_reg,
+    split_search_limit = 16  // blocks searched for a split position in very large methods
   };
 
  private:
@@ -709,6 +711,7 @@ class LinearScanWalker : public IntervalWalker {
   int              _last_reg;        // the reg. nmber of the last phys. register
   int              _num_phys_regs;   // required by current interval
   bool             _adjacent_regs;   // have lo/hi words of phys. regs be adjacent
+  bool             _limit_split_search; // true if the method has more than LinearScanLargeMethodThreshold intervals
 
   int              _use_pos[LinearScan::nof_regs];
   int              _block_pos[LinearScan::nof_regs];
@@ -212,6 +212,12 @@
   product(bool, TimeLinearScan, false,                                      \
           "detailed timing of LinearScan phases")                           \
                                                                             \
+  product(intx, LinearScanLargeMethodThreshold, 20000,                      \
+          "Number of intervals above which LinearScan searches only the "   \
+          "16 blocks before a split block for a split position with a "     \
+          "lower loop depth, to reduce compile time (0 means no limit)")    \
+          range(0, max_jint)                                                \
+                                                                            \
   develop(bool, TimeEachLinearScan, false,                                  \
           "print detailed timing of each LinearScan run")                   \
                                                                             \
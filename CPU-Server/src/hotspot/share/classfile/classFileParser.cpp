@@ -40,6 +40,7 @@
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.hpp"
+#include "memory/dynamicArchive.hpp"
 #include "memory/metadataFactory.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -6174,6 +6175,7 @@ void ClassFileParser::parse_stream(const ClassFileStream* const stream,
         } else {
           classlist_file->print_cr("%s", _class_name->as_C_string());
           classlist_file->flush();
+          DynamicArchive::record_unarchived_class();
         }
       }
     }
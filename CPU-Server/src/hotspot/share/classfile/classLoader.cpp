@@ -84,6 +84,8 @@ typedef jboolean (*ReadEntry_t)(jzfile *zip, jzentry *entry, unsigned char *buf,
 typedef jzentry* (*GetNextEntry_t)(jzfile *zip, jint n);
 typedef jboolean (*ZipInflateFully_t)(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pmsg);
 typedef jint     (*Crc32_t)(jint crc, const jbyte *buf, jint len);
+typedef jlong    (*GZipBound_t)(jlong inLen, jint level);
+typedef jlong    (*GZipFully_t)(void *inBuf, jlong inLen, void *outBuf, jlong outLen, jint level, char **pmsg);
 
 static ZipOpen_t         ZipOpen            = NULL;
 static ZipClose_t        ZipClose           = NULL;
@@ -93,6 +95,8 @@ static GetNextEntry_t    GetNextEntry       = NULL;
 static canonicalize_fn_t CanonicalizeEntry  = NULL;
 static ZipInflateFully_t ZipInflateFully    = NULL;
 static Crc32_t           Crc32              = NULL;
+static GZipBound_t       GZipBound          = NULL;
+static GZipFully_t       GZipFully          = NULL;
 
 // Entry points for jimage.dll for loading jimage file entries
 
@@ -1051,6 +1055,9 @@ void ClassLoader::load_zip_library() {
   GetNextEntry = CAST_TO_FN_PTR(GetNextEntry_t, os::dll_lookup(handle, "ZIP_GetNextEntry"));
   ZipInflateFully = CAST_TO_FN_PTR(ZipInflateFully_t, os::dll_lookup(handle, "ZIP_InflateFully"));
   Crc32        = CAST_TO_FN_PTR(Crc32_t, os::dll_lookup(handle, "ZIP_CRC32"));
+  // Only used to compress heap dumps, so don't abort if they are missing
+  GZipBound    = CAST_TO_FN_PTR(GZipBound_t, os::dll_lookup(handle, "ZIP_GZip_Bound"));
+  GZipFully    = CAST_TO_FN_PTR(GZipFully_t, os::dll_lookup(handle, "ZIP_GZip_Fully"));
 
   // ZIP_Close is not exported on Windows in JDK5.0 so don't abort if ZIP_Close is NULL
   if (ZipOpen == NULL || FindEntry == NULL || ReadEntry == NULL ||
@@ -1108,6 +1115,20 @@ int ClassLoader::crc32(int crc, const char* buf, int len) {
   return (*Crc32)(crc, (const jbyte*)buf, len);
 }
 
+bool ClassLoader::supports_gzip() {
+  return GZipBound != NULL && GZipFully != NULL;
+}
+
+jlong ClassLoader::gzip_bound(jlong in_len, int level) {
+  assert(supports_gzip(), "ZIP_GZip_Bound is not found");
+  return (*GZipBound)(in_len, level);
+}
+
+jlong ClassLoader::gzip(void* in, jlong in_len, void* out, jlong out_len, int level, char** pmsg) {
+  assert(supports_gzip(), "ZIP_GZip_Fully is not found");
+  return (*GZipFully)(in, in_len, out, out_len, level, pmsg);
+}
+
 // Function add_package extracts the package from the fully qualified class name
 // and checks if the package is in the boot loader's package entry table.  If so,
 // then it sets the classpath_index in the package entry record.
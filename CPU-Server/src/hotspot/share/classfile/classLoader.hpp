@@ -272,6 +272,10 @@ class ClassLoader: AllStatic {
  public:
   static jboolean decompress(void *in, u8 inSize, void *out, u8 outSize, char **pmsg);
   static int crc32(int crc, const char* buf, int len);
+  // Compresses the input into a single gzip member, see ZIP_GZip_Fully
+  static bool supports_gzip();
+  static jlong gzip_bound(jlong in_len, int level);
+  static jlong gzip(void* in, jlong in_len, void* out, jlong out_len, int level, char** pmsg);
   static bool update_class_path_entry_list(const char *path,
                                            bool check_for_duplicates,
                                            bool is_boot_append,
@@ -39,13 +39,18 @@
 #include "classfile/vmSymbols.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
+#include "memory/metadataFactory.hpp"
+#include "memory/metaspaceClosure.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/instanceKlass.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/reflection.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/stringUtils.hpp"
 #include "utilities/utf8.hpp"
 
@@ -166,8 +171,16 @@ static void define_javabase_module(jobject module, jstring version,
 
 
   // Check that the packages are syntactically ok.
+  bool log_time = log_is_enabled(Debug, cds, module);
+  jlong pkg_list_start = log_time ? os::javaTimeNanos() : 0;
+  Array<Symbol*>* archived_pkgs =
+    CDS_ONLY(Modules::archived_packages(JAVA_BASE_NAME, Handle(), packages, num_packages)) NOT_CDS(NULL);
   GrowableArray<Symbol*>* pkg_list = new GrowableArray<Symbol*>(num_packages);
   for (int x = 0; x < num_packages; x++) {
+    if (archived_pkgs != NULL) {
+      pkg_list->append(archived_pkgs->at(x));
+      continue;
+    }
     const char *package_name = packages[x];
     if (!Modules::verify_package_name(package_name)) {
       THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(),
@@ -176,6 +189,7 @@ static void define_javabase_module(jobject module, jstring version,
     Symbol* pkg_symbol = SymbolTable::new_symbol(package_name, CHECK);
     pkg_list->append(pkg_symbol);
   }
+  jlong pkg_list_ns = log_time ? os::javaTimeNanos() - pkg_list_start : 0;
 
   // Validate java_base's loader is the boot loader.
   oop loader = java_lang_Module::loader(module_handle());
@@ -236,6 +250,8 @@ static void define_javabase_module(jobject module, jstring version,
 
   log_info(module, load)(JAVA_BASE_NAME " location: %s",
                          module_location != NULL ? module_location : "NULL");
+  log_debug(cds, module)("Defined module " JAVA_BASE_NAME " with %d %s packages in " JLONG_FORMAT " ns",
+                         num_packages, archived_pkgs != NULL ? "archived" : "checked", pkg_list_ns);
   log_debug(module)("define_javabase_module(): Definition of module: "
                     JAVA_BASE_NAME ", version: %s, location: %s, package #: %d",
                     module_version != NULL ? module_version : "NULL",
@@ -318,9 +334,18 @@ void Modules::define_module(jobject module, jboolean is_open, jstring version,
   assert(loader_data != NULL, "class loader data shouldn't be null");
 
   // Check that the list of packages has no duplicates and that the
-  // packages are syntactically ok.
+  // packages are syntactically ok. Packages that match the ones archived
+  // for this module were already checked when the archive was dumped.
+  bool log_time = log_is_enabled(Debug, cds, module);
+  jlong pkg_list_start = log_time ? os::javaTimeNanos() : 0;
+  Array<Symbol*>* archived_pkgs =
+    CDS_ONLY(archived_packages(module_name, h_loader, packages, num_packages)) NOT_CDS(NULL);
   GrowableArray<Symbol*>* pkg_list = new GrowableArray<Symbol*>(num_packages);
   for (int x = 0; x < num_packages; x++) {
+    if (archived_pkgs != NULL) {
+      pkg_list->append(archived_pkgs->at(x));
+      continue;
+    }
     const char* package_name = packages[x];
     if (!verify_package_name(package_name)) {
       THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(),
@@ -349,6 +374,7 @@ void Modules::define_module(jobject module, jboolean is_open, jstring version,
     Symbol* pkg_symbol = SymbolTable::new_symbol(package_name, CHECK);
     pkg_list->append(pkg_symbol);
   }
+  jlong pkg_list_ns = log_time ? os::javaTimeNanos() - pkg_list_start : 0;
 
   ModuleEntryTable* module_table = get_module_entry_table(h_loader);
   assert(module_table != NULL, "module entry table shouldn't be null");
@@ -439,6 +465,8 @@ void Modules::define_module(jobject module, jboolean is_open, jstring version,
 
   log_info(module, load)("%s location: %s", module_name,
                          module_location != NULL ? module_location : "NULL");
+  log_debug(cds, module)("Defined module %s with %d %s packages in " JLONG_FORMAT " ns",
+                         module_name, num_packages, archived_pkgs != NULL ? "archived" : "checked", pkg_list_ns);
   LogTarget(Debug, module) lt;
   if (lt.is_enabled()) {
     LogStream ls(lt);
@@ -727,3 +755,167 @@ void Modules::add_module_exports_to_all_unnamed(jobject module, const char* pack
     package_entry->set_is_exported_allUnnamed();
   }
 }
+
+#if INCLUDE_CDS
+Array<Symbol*>*         Modules::_archived_module_names    = NULL;
+Array<u1>*              Modules::_archived_module_loaders  = NULL;
+Array<Array<Symbol*>*>* Modules::_archived_module_packages = NULL;
+
+static const int num_builtin_loaders = 3;
+
+// Returns ClassLoader::BOOT_LOADER, PLATFORM_LOADER or APP_LOADER, or 0 if
+// the loader is not one of the builtin loaders.
+static u1 builtin_loader_type(oop loader) {
+  if (loader == NULL) {
+    return ClassLoader::BOOT_LOADER;
+  } else if (SystemDictionary::is_platform_class_loader(loader)) {
+    return ClassLoader::PLATFORM_LOADER;
+  } else if (SystemDictionary::is_system_class_loader(loader)) {
+    return ClassLoader::APP_LOADER;
+  }
+  return 0;
+}
+
+// Orders package names by their utf8 bytes. The addresses of the Symbols
+// change when they are copied into the archive, so Symbol::fast_compare
+// cannot be used.
+static int compare_package_name(const char* name, int len, Symbol* sym) {
+  int sym_len = sym->utf8_length();
+  int cmp = memcmp(name, sym->bytes(), MIN2(len, sym_len));
+  return (cmp != 0) ? cmp : len - sym_len;
+}
+
+static int compare_package_symbols(Symbol** a, Symbol** b) {
+  return compare_package_name((const char*)(*a)->bytes(), (*a)->utf8_length(), *b);
+}
+
+static int find_archived_package(Array<Symbol*>* pkgs, const char* name) {
+  int len = (int)strlen(name);
+  int low = 0;
+  int high = pkgs->length() - 1;
+  while (low <= high) {
+    int mid = (low + high) >> 1;
+    int cmp = compare_package_name(name, len, pkgs->at(mid));
+    if (cmp == 0) {
+      return mid;
+    } else if (cmp < 0) {
+      high = mid - 1;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return -1;
+}
+
+// Returns the archived packages of module_name if it was defined to the same
+// builtin loader with exactly the same packages when the archive was dumped,
+// NULL otherwise. The archived packages were validated at dump time, so they
+// can be used without checking them again. This only saves the package name
+// checks and the symbol table lookups; the match still compares every
+// package name, and the module and package entries are created as before.
+// Caller needs ResourceMark.
+Array<Symbol*>* Modules::archived_packages(const char* module_name, Handle h_loader,
+                                           const char* const* packages, jsize num_packages) {
+  if (_archived_module_names == NULL || num_packages == 0) {
+    return NULL;
+  }
+  u1 loader_type = builtin_loader_type(h_loader());
+  if (loader_type == 0) {
+    return NULL;
+  }
+
+  int name_len = (int)strlen(module_name);
+  for (int i = 0; i < _archived_module_names->length(); i++) {
+    if (_archived_module_loaders->at(i) != loader_type ||
+        !_archived_module_names->at(i)->equals(module_name, name_len)) {
+      continue;
+    }
+    Array<Symbol*>* pkgs = _archived_module_packages->at(i);
+    if (pkgs->length() != num_packages) {
+      return NULL;
+    }
+    ResourceBitMap found(num_packages);
+    for (int x = 0; x < num_packages; x++) {
+      int index = find_archived_package(pkgs, packages[x]);
+      if (index < 0 || found.at(index)) {
+        return NULL;
+      }
+      found.set_bit(index);
+    }
+    return pkgs;
+  }
+  return NULL;
+}
+
+void Modules::archive_module_packages(TRAPS) {
+  assert(DumpSharedSpaces, "dump time only");
+  ResourceMark rm(THREAD);
+
+  oop loaders[num_builtin_loaders] = { NULL,
+                                       SystemDictionary::java_platform_loader(),
+                                       SystemDictionary::java_system_loader() };
+  PackageEntryTable* package_tables[num_builtin_loaders];
+  for (int l = 0; l < num_builtin_loaders; l++) {
+    package_tables[l] = get_package_entry_table(Handle(THREAD, loaders[l]));
+  }
+
+  // Group the packages of the named modules by module.
+  GrowableArray<ModuleEntry*> modules;
+  GrowableArray<u1> module_loaders;
+  GrowableArray<GrowableArray<Symbol*>*> module_packages;
+  {
+    MutexLocker ml(Module_lock, THREAD);
+    for (int l = 0; l < num_builtin_loaders; l++) {
+      PackageEntryTable* package_table = package_tables[l];
+      for (int i = 0; i < package_table->table_size(); i++) {
+        for (PackageEntry* pkg = package_table->bucket(i); pkg != NULL; pkg = pkg->next()) {
+          ModuleEntry* module = pkg->module();
+          if (!module->is_named()) {
+            continue;
+          }
+          int index = modules.find(module);
+          if (index < 0) {
+            index = modules.append(module);
+            module_loaders.append(builtin_loader_type(loaders[l]));
+            module_packages.append(new GrowableArray<Symbol*>());
+          }
+          module_packages.at(index)->append(pkg->name());
+        }
+      }
+    }
+  }
+
+  ClassLoaderData* loader_data = ClassLoaderData::the_null_class_loader_data();
+  int num_modules = modules.length();
+  _archived_module_names = MetadataFactory::new_array<Symbol*>(loader_data, num_modules, CHECK);
+  _archived_module_loaders = MetadataFactory::new_array<u1>(loader_data, num_modules, CHECK);
+  _archived_module_packages = MetadataFactory::new_array<Array<Symbol*>*>(loader_data, num_modules, CHECK);
+
+  int num_packages = 0;
+  for (int i = 0; i < num_modules; i++) {
+    GrowableArray<Symbol*>* pkg_list = module_packages.at(i);
+    pkg_list->sort(compare_package_symbols);
+    Array<Symbol*>* pkgs = MetadataFactory::new_array<Symbol*>(loader_data, pkg_list->length(), CHECK);
+    for (int x = 0; x < pkg_list->length(); x++) {
+      pkgs->at_put(x, pkg_list->at(x));
+    }
+    _archived_module_names->at_put(i, modules.at(i)->name());
+    _archived_module_loaders->at_put(i, module_loaders.at(i));
+    _archived_module_packages->at_put(i, pkgs);
+    num_packages += pkg_list->length();
+  }
+  log_info(cds, module)("Archived %d packages of %d modules", num_packages, num_modules);
+}
+
+void Modules::metaspace_pointers_do(MetaspaceClosure* it) {
+  it->push(&_archived_module_names);
+  it->push(&_archived_module_loaders);
+  it->push(&_archived_module_packages);
+}
+
+void Modules::serialize(SerializeClosure* soc) {
+  soc->do_ptr((void**)&_archived_module_names);
+  soc->do_ptr((void**)&_archived_module_loaders);
+  soc->do_ptr((void**)&_archived_module_packages);
+}
+#endif // INCLUDE_CDS
@@ -28,10 +28,22 @@
 #include "memory/allocation.hpp"
 #include "runtime/handles.hpp"
 
+class MetaspaceClosure;
 class ModuleEntryTable;
+class SerializeClosure;
 class Symbol;
+template <typename T> class Array;
 
 class Modules : AllStatic {
+#if INCLUDE_CDS
+  // The package names of the named modules defined to the builtin loaders,
+  // recorded in the CDS archive at dump time. Each module's packages are
+  // sorted by name so that they can be matched against the packages that
+  // are passed to define_module at run time.
+  static Array<Symbol*>*         _archived_module_names;
+  static Array<u1>*              _archived_module_loaders;
+  static Array<Array<Symbol*>*>* _archived_module_packages;
+#endif
 
 public:
   // define_module defines a module containing the specified packages. It binds the
@@ -124,6 +136,18 @@ public:
   // Return TRUE iff package is defined by loader
   static bool is_package_defined(Symbol* package_name, Handle h_loader, TRAPS);
   static ModuleEntryTable* get_module_entry_table(Handle h_loader);
+
+  // Record the packages of the modules in the boot layer so that the next
+  // run that maps the archive can define the same modules without validating
+  // the package names and looking them up in the symbol table again. The
+  // time spent on the package lists is logged with -Xlog:cds+module=debug.
+  static void archive_module_packages(TRAPS) NOT_CDS_RETURN;
+  static void metaspace_pointers_do(MetaspaceClosure* it) NOT_CDS_RETURN;
+  static void serialize(SerializeClosure* soc) NOT_CDS_RETURN;
+#if INCLUDE_CDS
+  static Array<Symbol*>* archived_packages(const char* module_name, Handle h_loader,
+                                           const char* const* packages, jsize num_packages);
+#endif
 };
 
 #endif // SHARE_VM_CLASSFILE_MODULES_HPP
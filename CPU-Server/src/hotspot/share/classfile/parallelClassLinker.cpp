@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/parallelClassLinker.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/java.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+
+// A queued class, kept alive by a global handle to its mirror until a
+// linker thread picks it up.
+class ParallelClassLinker::Request : public CHeapObj<mtClass> {
+ public:
+  jobject  _mirror;
+  Request* _next;
+
+  Request(jobject mirror) : _mirror(mirror), _next(NULL) {}
+};
+
+ParallelClassLinker::Request* ParallelClassLinker::_head = NULL;
+ParallelClassLinker::Request* ParallelClassLinker::_tail = NULL;
+uint ParallelClassLinker::_pending = 0;
+bool ParallelClassLinker::_started = false;
+
+void ParallelClassLinker::initialize(TRAPS) {
+  assert(ParallelClassLinking, "sanity");
+
+  Handle thread_group(THREAD, Universe::system_thread_group());
+  for (uintx i = 0; i < ParallelClassLinkingThreads; i++) {
+    char name[32];
+    jio_snprintf(name, sizeof(name), "Class Linker %d", (int)i);
+    Handle string = java_lang_String::create_from_str(name, CHECK);
+
+    // Initialize thread_oop to put it into the system threadGroup
+    Handle thread_oop = JavaCalls::construct_new_instance(
+                            SystemDictionary::Thread_klass(),
+                            vmSymbols::threadgroup_string_void_signature(),
+                            thread_group,
+                            string,
+                            CHECK);
+
+    JavaThread* thread;
+    {
+      MutexLocker mu(Threads_lock);
+      thread = new JavaThread(&linker_thread_entry);
+      if (thread != NULL && thread->osthread() != NULL) {
+        java_lang_Thread::set_thread(thread_oop(), thread);
+        java_lang_Thread::set_daemon(thread_oop());
+        thread->set_threadObj(thread_oop());
+
+        Threads::add(thread);
+        Thread::start(thread);
+        continue;
+      }
+    }
+
+    // Eager linking is only an optimization, so do without the
+    // remaining threads if one cannot be created.
+    log_warning(class, init)("Could not create %s thread for ParallelClassLinking", name);
+    if (thread != NULL) {
+      thread->smr_delete();
+    }
+    break;
+  }
+
+  OrderAccess::release_store(&_started, true);
+}
+
+void ParallelClassLinker::enqueue(InstanceKlass* ik, TRAPS) {
+  assert(ik->class_loader_data()->is_builtin_class_loader_data(), "must be");
+  if (!OrderAccess::load_acquire(&_started) || ik->is_linked()) {
+    return;
+  }
+  if (_pending >= ParallelClassLinkingQueueSize) {
+    // The linker threads are behind; link this class on demand.
+    return;
+  }
+
+  jobject mirror = JNIHandles::make_global(Handle(THREAD, ik->java_mirror()));
+  Request* request = new Request(mirror);
+
+  MutexLocker ml(ParallelClassLinker_lock, THREAD);
+  if (_tail == NULL) {
+    _head = request;
+  } else {
+    _tail->_next = request;
+  }
+  _tail = request;
+  _pending++;
+  ParallelClassLinker_lock->notify();
+}
+
+Handle ParallelClassLinker::dequeue(JavaThread* thread) {
+  jobject mirror;
+  {
+    MutexLocker ml(ParallelClassLinker_lock, thread);
+    while (_head == NULL) {
+      ParallelClassLinker_lock->wait();
+    }
+    Request* request = _head;
+    _head = request->_next;
+    if (_head == NULL) {
+      _tail = NULL;
+    }
+    _pending--;
+    mirror = request->_mirror;
+    delete request;
+  }
+
+  // The returned handle keeps the class alive while it is linked.
+  Handle result(thread, JNIHandles::resolve_non_null(mirror));
+  JNIHandles::destroy_global(mirror);
+  return result;
+}
+
+void ParallelClassLinker::linker_thread_entry(JavaThread* thread, TRAPS) {
+  while (true) {
+    HandleMark hm(THREAD);
+    ResourceMark rm(THREAD);
+
+    Handle mirror = dequeue(thread);
+    InstanceKlass* ik = InstanceKlass::cast(java_lang_Class::as_Klass(mirror()));
+    if (ik->is_linked()) {
+      continue;
+    }
+
+    ik->link_class(THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      // The class stays unlinked; the error is raised again when the class
+      // is linked on demand by a thread that uses it.
+      log_debug(class, init)("Background linking of %s failed: %s",
+                             ik->external_name(),
+                             PENDING_EXCEPTION->klass()->external_name());
+      CLEAR_PENDING_EXCEPTION;
+    } else {
+      log_trace(class, init)("Linked %s in the background", ik->external_name());
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_CLASSFILE_PARALLELCLASSLINKER_HPP
+#define SHARE_VM_CLASSFILE_PARALLELCLASSLINKER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/handles.hpp"
+
+class InstanceKlass;
+class JavaThread;
+
+// With -XX:+ParallelClassLinking, classes defined by the builtin class
+// loaders (boot, platform and app) are queued and linked (verified and
+// rewritten) by a pool of background Java threads, so that the bursts of
+// class definitions at startup are verified on otherwise idle cores instead
+// of serially by the loading thread when it first needs each class.
+//
+// Linking is already safe against concurrent callers (see
+// InstanceKlass::link_class_impl): a thread that needs a class while a
+// linker thread is verifying it waits for the result. A class that fails
+// to link in the background is left unlinked, and the error is raised
+// when the class is linked on demand.
+//
+// Verification loads the classes it needs through the defining loader
+// while the linker thread holds the init lock of the class. Only the
+// builtin loaders are trusted not to wait for other threads in loadClass,
+// so classes of user defined loaders are always linked on demand.
+class ParallelClassLinker : AllStatic {
+ private:
+  class Request;
+
+  static Request* _head;
+  static Request* _tail;
+  static uint     _pending;
+  static bool     _started;
+
+  static Handle dequeue(JavaThread* thread);
+  static void linker_thread_entry(JavaThread* thread, TRAPS);
+
+ public:
+  // Starts the linker threads, once the system class loader is set up.
+  static void initialize(TRAPS);
+
+  // Queues a class that was just defined by a builtin class loader for
+  // linking.
+  static void enqueue(InstanceKlass* ik, TRAPS);
+};
+
+#endif // SHARE_VM_CLASSFILE_PARALLELCLASSLINKER_HPP
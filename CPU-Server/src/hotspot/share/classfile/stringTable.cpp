@@ -199,6 +199,7 @@ StringTable::StringTable() : _local_table(NULL), _current_size(0), _has_work(0),
   _weak_handles = new OopStorage("StringTable weak",
                                  StringTableWeakAlloc_lock,
                                  StringTableWeakActive_lock);
+  _weak_handles->register_num_dead_callback(&gc_notification);
   size_t start_size_log_2 = ceil_log2(StringTableSize);
   _current_size = ((size_t)1) << start_size_log_2;
   log_trace(stringtable)("Start size: " SIZE_FORMAT " (" SIZE_FORMAT ")",
@@ -216,12 +217,10 @@ size_t StringTable::item_added() {
   return Atomic::add((size_t)1, &(the_table()->_items_count));
 }
 
-size_t StringTable::add_items_to_clean(size_t ndead) {
-  size_t total = Atomic::add((size_t)ndead, &(the_table()->_uncleaned_items_count));
-  log_trace(stringtable)(
-     "Uncleaned items:" SIZE_FORMAT " added: " SIZE_FORMAT " total:" SIZE_FORMAT,
-     the_table()->_uncleaned_items_count, ndead, total);
-  return total;
+void StringTable::gc_notification(size_t num_dead) {
+  log_trace(stringtable)("Uncleaned items:" SIZE_FORMAT, num_dead);
+  the_table()->_uncleaned_items_count = num_dead;
+  the_table()->check_concurrent_work();
 }
 
 void StringTable::item_removed() {
@@ -435,8 +434,9 @@ void StringTable::possibly_parallel_unlink(
 
   _par_state_string->weak_oops_do(&stiac, &dnc);
 
-  // Accumulate the dead strings.
-  the_table()->add_items_to_clean(stiac._count);
+  // Accumulate the dead strings; they are reported to the table through
+  // the storage's dead entry callback once the iteration completes.
+  _par_state_string->increment_num_dead(stiac._count);
 
   *processed = stiac._count_total;
   *removed = stiac._count;
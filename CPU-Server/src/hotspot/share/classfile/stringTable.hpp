@@ -80,7 +80,9 @@ private:
 
   static size_t item_added();
   static void item_removed();
-  size_t add_items_to_clean(size_t ndead);
+  // Dead entry callback of the weak storage, invoked at the end of
+  // each GC iteration over it.
+  static void gc_notification(size_t num_dead);
 
   StringTable();
 
@@ -112,21 +114,10 @@ private:
 
   // GC support
 
-  // Must be called before a parallel walk where strings might die.
-  static void reset_dead_counter() {
-    the_table()->_uncleaned_items_count = 0;
-  }
-  // After the parallel walk this method must be called to trigger
-  // cleaning. Note it might trigger a resize instead.
-  static void finish_dead_counter() {
-    the_table()->check_concurrent_work();
-  }
-
-  // If GC uses ParState directly it should add the number of cleared
-  // strings to this method.
-  static void inc_dead_counter(size_t ndead) {
-    the_table()->add_items_to_clean(ndead);
-  }
+  // A GC walking weak_storage() with a ParState should add the number of
+  // cleared strings to the ParState with increment_num_dead() and call
+  // report_num_dead() after the walk.  That triggers concurrent cleaning
+  // (or a resize) on the service thread; see gc_notification().
 
   //   Delete pointers to otherwise-unreachable objects.
   static void unlink(BoolObjectClosure* cl) {
@@ -36,6 +36,7 @@
 #include "classfile/klassFactory.hpp"
 #include "classfile/loaderConstraints.hpp"
 #include "classfile/packageEntry.hpp"
+#include "classfile/parallelClassLinker.hpp"
 #include "classfile/placeholders.hpp"
 #include "classfile/protectionDomainCache.hpp"
 #include "classfile/resolutionErrors.hpp"
@@ -1611,6 +1612,13 @@ void SystemDictionary::define_instance_class(InstanceKlass* k, TRAPS) {
 
   }
   post_class_define_event(k, loader_data);
+
+  // Linking may load classes through the defining loader, so only classes
+  // of the builtin loaders are linked in the background: user loaders could
+  // deadlock a linker thread that holds the init lock of the class.
+  if (ParallelClassLinking && loader_data->is_builtin_class_loader_data()) {
+    ParallelClassLinker::enqueue(k, THREAD);
+  }
 }
 
 // Support parallel classloading
@@ -39,10 +39,11 @@ struct CodeBlobType {
   enum {
     MethodNonProfiled   = 0,    // Execution level 1 and 4 (non-profiled) nmethods (including native nmethods)
     MethodProfiled      = 1,    // Execution level 2 and 3 (profiled) nmethods
-    NonNMethod          = 2,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
-    All                 = 3,    // All types (No code cache segmentation)
-    AOT                 = 4,    // AOT methods
-    NumTypes            = 5     // Number of CodeBlobTypes
+    MethodHot           = 2,    // Execution level 4 nmethods of hot methods (see HotCodeHeapSize)
+    NonNMethod          = 3,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
+    All                 = 4,    // All types (No code cache segmentation)
+    AOT                 = 5,    // AOT methods
+    NumTypes            = 6     // Number of CodeBlobTypes
   };
 };
 
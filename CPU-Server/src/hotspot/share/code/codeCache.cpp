@@ -273,6 +273,12 @@ void CodeCache::initialize_heaps() {
     non_nmethod_size += non_profiled_size;
     non_profiled_size = 0;
   }
+  // Carve the hot code heap out of the non-profiled code heap
+  size_t hot_size = 0;
+  if (heap_available(CodeBlobType::MethodHot)) {
+    hot_size = MIN2((size_t)HotCodeHeapSize, non_profiled_size / 2);
+    non_profiled_size -= hot_size;
+  }
   // Make sure we have enough space for VM internal code
   uint min_code_cache_size = CodeCacheMinimumUseSpace DEBUG_ONLY(* 3);
   if (non_nmethod_size < min_code_cache_size) {
@@ -282,20 +288,28 @@ void CodeCache::initialize_heaps() {
   }
 
   // Verify sizes and update flag values
-  assert(non_profiled_size + profiled_size + non_nmethod_size == cache_size, "Invalid code heap sizes");
+  assert(non_profiled_size + profiled_size + non_nmethod_size + hot_size == cache_size, "Invalid code heap sizes");
   FLAG_SET_ERGO(uintx, NonNMethodCodeHeapSize, non_nmethod_size);
   FLAG_SET_ERGO(uintx, ProfiledCodeHeapSize, profiled_size);
   FLAG_SET_ERGO(uintx, NonProfiledCodeHeapSize, non_profiled_size);
 
   // If large page support is enabled, align code heaps according to large
   // page size to make sure that code cache is covered by large pages.
+  // The hot code heap is aligned from both ends so that it never shares
+  // a large page with colder code.
   const size_t alignment = MAX2(page_size(false, 8), (size_t) os::vm_allocation_granularity());
   non_nmethod_size = align_up(non_nmethod_size, alignment);
   profiled_size    = align_down(profiled_size, alignment);
+  hot_size         = align_down(hot_size, alignment);
+  if (hot_size != HotCodeHeapSize) {
+    // Rounded down to the page size, a hot code heap below one page is disabled
+    FLAG_SET_ERGO(uintx, HotCodeHeapSize, hot_size);
+  }
 
   // Reserve one continuous chunk of memory for CodeHeaps and split it into
   // parts for the individual heaps. The memory layout looks like this:
   // ---------- high -----------
+  //        Hot nmethods
   //    Non-profiled nmethods
   //      Profiled nmethods
   //         Non-nmethods
@@ -304,7 +318,9 @@ void CodeCache::initialize_heaps() {
   ReservedSpace non_method_space    = rs.first_part(non_nmethod_size);
   ReservedSpace rest                = rs.last_part(non_nmethod_size);
   ReservedSpace profiled_space      = rest.first_part(profiled_size);
-  ReservedSpace non_profiled_space  = rest.last_part(profiled_size);
+  ReservedSpace method_space        = rest.last_part(profiled_size);
+  ReservedSpace non_profiled_space  = method_space.first_part(method_space.size() - hot_size);
+  ReservedSpace hot_space           = method_space.last_part(method_space.size() - hot_size);
 
   // Non-nmethods (stubs, adapters, ...)
   add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
@@ -312,6 +328,10 @@ void CodeCache::initialize_heaps() {
   add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
   // Tier 1 and tier 4 (non-profiled) methods and native methods
   add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
+  if (hot_size > 0) {
+    // Tier 4 methods that were found hot by the sweeper
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodHot);
+  }
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
@@ -352,6 +372,9 @@ bool CodeCache::heap_available(int code_blob_type) {
   } else if (Arguments::is_interpreter_only()) {
     // Interpreter only: we don't need any method code heaps
     return (code_blob_type == CodeBlobType::NonNMethod);
+  } else if (code_blob_type == CodeBlobType::MethodHot) {
+    // Hot nmethods: only with C2 and if a hot code heap was requested
+    return HotCodeHeapSize > 0;
   } else if (TieredCompilation && (TieredStopAtLevel > CompLevel_simple)) {
     // Tiered compilation: use all code heaps
     return (code_blob_type < CodeBlobType::All);
@@ -373,6 +396,9 @@ const char* CodeCache::get_code_heap_flag_name(int code_blob_type) {
   case CodeBlobType::MethodProfiled:
     return "ProfiledCodeHeapSize";
     break;
+  case CodeBlobType::MethodHot:
+    return "HotCodeHeapSize";
+    break;
   }
   ShouldNotReachHere();
   return NULL;
@@ -507,11 +533,13 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, int orig_code_blob_t
       if (SegmentedCodeCache) {
         // Fallback solution: Try to store code in another code heap.
         // NonNMethod -> MethodNonProfiled -> MethodProfiled (-> MethodNonProfiled)
+        // MethodHot -> MethodNonProfiled
         // Note that in the sweeper, we check the reverse_free_ratio of the code heap
         // and force stack scanning if less than 10% of the code heap are free.
         int type = code_blob_type;
         switch (type) {
         case CodeBlobType::NonNMethod:
+        case CodeBlobType::MethodHot:
           type = CodeBlobType::MethodNonProfiled;
           break;
         case CodeBlobType::MethodNonProfiled:
@@ -253,13 +253,13 @@ class CodeCache : AllStatic {
   }
 
   static bool code_blob_type_accepts_compiled(int type) {
-    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    bool result = type == CodeBlobType::All || type <= CodeBlobType::MethodHot;
     AOT_ONLY( result = result || type == CodeBlobType::AOT; )
     return result;
   }
 
   static bool code_blob_type_accepts_nmethod(int type) {
-    return type == CodeBlobType::All || type <= CodeBlobType::MethodProfiled;
+    return type == CodeBlobType::All || type <= CodeBlobType::MethodHot;
   }
 
   static bool code_blob_type_accepts_allocable(int type) {
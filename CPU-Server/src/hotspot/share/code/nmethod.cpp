@@ -503,7 +503,8 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
       + align_up(nul_chk_table->size_in_bytes()    , oopSize)
       + align_up(debug_info->data_size()           , oopSize);
 
-    nm = new (nmethod_size, comp_level)
+    bool is_hot = (entry_bci == InvocationEntryBci) && method->is_hot_code();
+    nm = new (nmethod_size, comp_level, is_hot)
     nmethod(method(), compiler->type(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
             oop_maps,
@@ -541,6 +542,10 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
         }
       }
       NOT_PRODUCT(if (nm != NULL)  note_java_nmethod(nm));
+      if (is_hot && CodeCache::get_code_blob_type(nm) != CodeBlobType::MethodHot) {
+        // The hot code heap is full, let the sweeper request the move again later
+        method->set_is_hot_code(false);
+      }
     }
   }
   // Do verification and logging outside CodeCache_lock.
@@ -548,6 +553,11 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
     // Safepoints in nmethod::verify aren't allowed because nm hasn't been installed yet.
     DEBUG_ONLY(nm->verify();)
     nm->log_new_nmethod();
+    if (CodeCache::get_code_blob_type(nm) == CodeBlobType::MethodHot) {
+      ResourceMark rm;
+      log_debug(codecache, sweep)("Installed nmethod %d of %s in the hot code heap",
+                                  nm->compile_id(), method->name_and_sig_as_C_string());
+    }
   }
   return nm;
 }
@@ -602,6 +612,7 @@ nmethod::nmethod(
     _exception_cache         = NULL;
     _pc_desc_container.reset_to(NULL);
     _hotness_counter         = NMethodSweeper::hotness_counter_reset_val();
+    _hot_samples             = 0;
 
     _scopes_data_begin = (address) this + scopes_data_offset;
     _deopt_handler_begin = (address) this + deoptimize_offset;
@@ -647,8 +658,14 @@ nmethod::nmethod(
   }
 }
 
-void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw () {
-  return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level, bool is_hot) throw () {
+  int code_blob_type = CodeCache::get_code_blob_type(comp_level);
+  if (is_hot && comp_level == CompLevel_full_optimization &&
+      CodeCache::heap_available(CodeBlobType::MethodHot)) {
+    // Falls back to the non-profiled code heap if the hot code heap is full
+    code_blob_type = CodeBlobType::MethodHot;
+  }
+  return CodeCache::allocate(nmethod_size, code_blob_type);
 }
 
 nmethod::nmethod(
@@ -692,6 +709,7 @@ nmethod::nmethod(
     _comp_level              = comp_level;
     _orig_pc_offset          = orig_pc_offset;
     _hotness_counter         = NMethodSweeper::hotness_counter_reset_val();
+    _hot_samples             = 0;
 
     // Section offsets
     _consts_offset           = content_offset()      + code_buffer->total_offset_of(code_buffer->consts());
@@ -1015,6 +1033,11 @@ void nmethod::mark_as_seen_on_stack() {
   set_stack_traversal_mark(NMethodSweeper::traversal_count());
 }
 
+// Stacks may be scanned by several threads at a safepoint.
+void nmethod::inc_hot_samples() {
+  Atomic::inc(&_hot_samples);
+}
+
 // Tell if a non-entrant method can be converted to a zombie (i.e.,
 // there are no activations on the stack, not in use by the VM,
 // and not in use by the ServiceThread)
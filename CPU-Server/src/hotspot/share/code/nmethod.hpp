@@ -158,6 +158,10 @@ class nmethod : public CompiledMethod {
   // counter is decreased (by 1) while sweeping.
   int _hotness_counter;
 
+  // Number of times the nmethod was found on a thread stack at a safepoint
+  // since the last sweep. Used to find hot nmethods (see HotCodeHeapSize).
+  volatile int _hot_samples;
+
   // Local state used to keep track of whether unloading is happening or not
   volatile uint8_t _is_unloading_state;
 
@@ -214,7 +218,7 @@ class nmethod : public CompiledMethod {
           );
 
   // helper methods
-  void* operator new(size_t size, int nmethod_size, int comp_level) throw();
+  void* operator new(size_t size, int nmethod_size, int comp_level, bool is_hot = false) throw();
 
   const char* reloc_string_for(u_char* begin, u_char* end);
   // Returns true if this thread changed the state of the nmethod or
@@ -316,6 +320,10 @@ class nmethod : public CompiledMethod {
   void set_hotness_counter(int val) { _hotness_counter = val; }
   int  hotness_counter() const      { return _hotness_counter; }
 
+  void inc_hot_samples();
+  void reset_hot_samples()          { _hot_samples = 0; }
+  int  hot_samples() const          { return _hot_samples; }
+
   // Containment
   bool oops_contains         (oop*    addr) const { return oops_begin         () <= addr && addr < oops_end         (); }
   bool metadata_contains     (Metadata** addr) const   { return metadata_begin     () <= addr && addr < metadata_end     (); }
@@ -1345,6 +1345,13 @@ bool CompileBroker::compilation_is_complete(const methodHandle& method,
     } else {
       CompiledMethod* result = method->code();
       if (result == NULL) return false;
+      if (method->is_hot_code() && result->is_nmethod() &&
+          comp_level == CompLevel_full_optimization &&
+          CodeCache::heap_available(CodeBlobType::MethodHot) &&
+          CodeCache::get_code_blob_type(result) != CodeBlobType::MethodHot) {
+        // Level 4 code of a hot method that still has to move to the hot code heap
+        return false;
+      }
       return comp_level == result->comp_level();
     }
   }
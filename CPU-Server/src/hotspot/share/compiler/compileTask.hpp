@@ -50,6 +50,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
       Reason_InvocationCount,  // Simple/StackWalk-policy
       Reason_BackedgeCount,    // Simple/StackWalk-policy
       Reason_Tiered,           // Tiered-policy
+      Reason_HotCode,          // Sweeper, recompile into the hot code heap
       Reason_CTW,              // Compile the world
       Reason_Replay,           // ciReplay
       Reason_Whitebox,         // Whitebox API
@@ -64,6 +65,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
       "count",
       "backedge_count",
       "tiered",
+      "hot_code",
       "CTW",
       "replay",
       "whitebox",
@@ -421,6 +421,18 @@ void CompilerConfig::ergo_initialize() {
     FLAG_SET_DEFAULT(UseLoopCounter, true);
   }
 
+  // The hot code heap is a segment of the code cache that only holds level 4 code
+  if (HotCodeHeapSize > 0) {
+    if (!SegmentedCodeCache) {
+      warning("HotCodeHeapSize is ignored because SegmentedCodeCache is disabled");
+      FLAG_SET_ERGO(uintx, HotCodeHeapSize, 0);
+    } else if (!COMPILER2_OR_JVMCI || is_client_compilation_mode_vm() ||
+               (TieredCompilation && TieredStopAtLevel < CompLevel_full_optimization)) {
+      warning("HotCodeHeapSize is ignored because level 4 compilation is disabled");
+      FLAG_SET_ERGO(uintx, HotCodeHeapSize, 0);
+    }
+  }
+
 #ifdef COMPILER2
   if (!EliminateLocks) {
     EliminateNestedLocks = false;
@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/profileCache.hpp"
+#include "interpreter/bytecodeStream.hpp"
+#include "interpreter/invocationCounter.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/cpCache.inline.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "oops/methodCounters.hpp"
+#include "oops/methodData.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+// One receiver row of a ReceiverTypeData of a recorded method.  Klass
+// pointers are only valid in one run, so the receiver is saved by name.
+class ProfileCacheReceiver : public CHeapObj<mtCompiler> {
+ public:
+  int                   _data_index;
+  int                   _row;
+  Symbol*               _klass;
+  uint                  _count;
+  ProfileCacheReceiver* _next;
+};
+
+// One recorded method.  Entries of methods of the same class are
+// chained off the class name in the table.
+class ProfileCacheEntry : public CHeapObj<mtCompiler> {
+ public:
+  Symbol*            _name;
+  Symbol*            _signature;
+  int                _level;
+  int                _invocation_count;
+  int                _backedge_count;
+  int                _code_size;
+  juint              _fingerprint;
+  int                _cell_count;
+  intptr_t*             _cells;
+  ProfileCacheReceiver* _receivers;
+  ProfileCacheEntry*    _next;
+};
+
+typedef ResourceHashtable<Symbol*, ProfileCacheEntry*,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          1009, ResourceObj::C_HEAP, mtCompiler> ProfileCacheTable;
+
+static ProfileCacheTable* _profile_cache_table = NULL;
+
+static const int profile_cache_version = 2;
+
+// Profiles are only valid for the exact same bytecodes.  Hash the
+// bytecodes with their operands in java form, so a changed method is not
+// seeded with a stale profile: quickened bytecodes map back to their java
+// form, and the constant pool cache indices written by the rewriter map
+// back to constant pool indices (as in JvmtiClassFileReconstituter).
+static juint bytecode_fingerprint(const methodHandle& mh) {
+  juint hash = (juint)mh->code_size();
+  ConstantPool* cp = mh->constants();
+  bool is_rewritten = mh->method_holder()->is_rewritten();
+  BytecodeStream bcs(mh);
+  Bytecodes::Code c;
+  while ((c = bcs.next()) >= 0) {
+    address bcp = bcs.bcp();
+    int len = bcs.instruction_size();
+    hash = 31 * hash + (juint)(bcs.is_wide() ? Bytecodes::_wide : c);
+    int cp_index = -1;
+    if (is_rewritten) {
+      switch (c) {
+      case Bytecodes::_getstatic:
+      case Bytecodes::_putstatic:
+      case Bytecodes::_getfield:
+      case Bytecodes::_putfield:
+      case Bytecodes::_invokevirtual:
+      case Bytecodes::_invokespecial:
+      case Bytecodes::_invokestatic:
+      case Bytecodes::_invokeinterface:
+        cp_index = cp->cache()->entry_at(Bytes::get_native_u2(bcp + 1))->constant_pool_index();
+        break;
+      case Bytecodes::_invokedynamic:
+        cp_index = cp->invokedynamic_cp_cache_entry_at(Bytes::get_native_u4(bcp + 1))->constant_pool_index();
+        break;
+      case Bytecodes::_ldc:
+        if (bcs.raw_code() == Bytecodes::_fast_aldc) {
+          cp_index = cp->object_to_cp_index(*(bcp + 1));
+        }
+        break;
+      case Bytecodes::_ldc_w:
+        if (bcs.raw_code() == Bytecodes::_fast_aldc_w) {
+          cp_index = cp->object_to_cp_index(Bytes::get_native_u2(bcp + 1));
+        }
+        break;
+      default:
+        break;
+      }
+    }
+    if (cp_index >= 0) {
+      hash = 31 * hash + (juint)cp_index;
+      // The count and zero bytes of invokeinterface follow the index.
+      for (int i = 3; i < len && c == Bytecodes::_invokeinterface; i++) {
+        hash = 31 * hash + (juint)bcp[i];
+      }
+    } else {
+      for (int i = 1; i < len; i++) {
+        hash = 31 * hash + (juint)bcp[i];
+      }
+    }
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+// Dumping
+
+class ProfileCacheWriter : public KlassClosure {
+ private:
+  outputStream* _st;
+  int           _count;
+
+  void write_method(Method* m) {
+    MethodData* mdo = m->method_data();
+    if (mdo == NULL) {
+      return;
+    }
+    int level = MAX2(m->highest_comp_level(), m->highest_osr_comp_level());
+    if (level < CompLevel_full_optimization) {
+      return;
+    }
+    ResourceMark rm;
+    // Work on a copy with all klass references cleared: they are
+    // meaningless in another run.  Receiver rows are written by name
+    // after the cells, and the count of calls that did not fit in the
+    // rows, which clearing a row resets, is kept.
+    size_t bytes = mdo->size() * wordSize;
+    MethodData* copy = (MethodData*)NEW_RESOURCE_ARRAY(char, bytes);
+    memcpy((void*)copy, (void*)mdo, bytes);
+    stringStream receivers;
+    for (ProfileData* data = copy->first_data();
+         copy->is_valid(data);
+         data = copy->next_data(data)) {
+      if (data->is_ReceiverTypeData()) {
+        ReceiverTypeData* rtd = data->as_ReceiverTypeData();
+        for (uint row = 0; row < ReceiverTypeData::row_limit(); row++) {
+          Klass* k = rtd->receiver(row);
+          if (k != NULL) {
+            receivers.print_cr("receiver %d %u %s %u", copy->dp_to_di(data->dp()), row,
+                               k->name()->as_C_string(), rtd->receiver_count(row));
+          }
+        }
+        uint count = rtd->count();
+        data->clean_weak_klass_links(true);
+        rtd->set_count(count);
+      } else {
+        data->clean_weak_klass_links(true);
+      }
+    }
+
+    methodHandle mh(Thread::current(), m);
+    int cell_count = copy->data_size() / (int)sizeof(intptr_t);
+    _st->print("method %s %s %s %d %d %d %d %u %d",
+               m->method_holder()->name()->as_C_string(),
+               m->name()->as_C_string(),
+               m->signature()->as_C_string(),
+               level, m->invocation_count(), m->backedge_count(),
+               m->code_size(), bytecode_fingerprint(mh), cell_count);
+    intptr_t* cells = (intptr_t*)copy->data_base();
+    for (int i = 0; i < cell_count; i++) {
+      _st->print(" " INTX_FORMAT, cells[i]);
+    }
+    _st->cr();
+    _st->print_raw(receivers.as_string());
+    _count++;
+  }
+
+ public:
+  ProfileCacheWriter(outputStream* st) : _st(st), _count(0) {}
+
+  int count() const { return _count; }
+
+  void do_klass(Klass* k) {
+    if (!k->is_instance_klass()) {
+      return;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    // Anonymous classes have no stable name to find them by in the next run.
+    if (!ik->is_linked() || ik->is_unsafe_anonymous()) {
+      return;
+    }
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      write_method(methods->at(i));
+    }
+  }
+};
+
+int ProfileCache::dump(const char* filename, outputStream* out) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  fileStream fs(filename, "w");
+  if (!fs.is_open()) {
+    out->print_cr("Could not open profile cache file %s", filename);
+    return -1;
+  }
+  fs.print_cr("# profile cache version %d", profile_cache_version);
+  ProfileCacheWriter writer(&fs);
+  ClassLoaderDataGraph::loaded_classes_do(&writer);
+  log_info(jit, compilation)("Wrote profiles of %d methods to %s", writer.count(), filename);
+  return writer.count();
+}
+
+void ProfileCache::dump_at_exit() {
+  if (!DumpProfileCacheAtExit) {
+    return;
+  }
+  if (ProfileCacheFile == NULL) {
+    warning("DumpProfileCacheAtExit requires ProfileCacheFile to be set");
+    return;
+  }
+  VM_DumpProfileCache op(ProfileCacheFile, tty);
+  VMThread::execute(&op);
+}
+
+//------------------------------------------------------------------------------
+// Loading
+
+// Split off the next blank separated token of a line.
+static char* next_token(char** pos) {
+  char* p = *pos;
+  while (*p == ' ' || *p == '\t' || *p == '\r') {
+    p++;
+  }
+  if (*p == '\0') {
+    *pos = p;
+    return NULL;
+  }
+  char* start = p;
+  while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r') {
+    p++;
+  }
+  if (*p != '\0') {
+    *p++ = '\0';
+  }
+  *pos = p;
+  return start;
+}
+
+static bool next_int(char** pos, int* value) {
+  char* token = next_token(pos);
+  return token != NULL && sscanf(token, "%d", value) == 1;
+}
+
+// Parse a "receiver" line, which belongs to the method line before it.
+static bool parse_receiver(char* pos, ProfileCacheEntry* e, TRAPS) {
+  int data_index, row;
+  uint count;
+  char* klass_name;
+  char* token;
+  if (e == NULL ||
+      !next_int(&pos, &data_index) ||
+      !next_int(&pos, &row) ||
+      (klass_name = next_token(&pos)) == NULL ||
+      (token = next_token(&pos)) == NULL || sscanf(token, "%u", &count) != 1) {
+    return false;
+  }
+  Symbol* klass = SymbolTable::new_permanent_symbol(klass_name, CHECK_false);
+  ProfileCacheReceiver* r = new ProfileCacheReceiver();
+  r->_data_index = data_index;
+  r->_row = row;
+  r->_klass = klass;
+  r->_count = count;
+  r->_next = e->_receivers;
+  e->_receivers = r;
+  return true;
+}
+
+static bool parse_line(char* line, ProfileCacheEntry** last, TRAPS) {
+  char* pos = line;
+  char* kind = next_token(&pos);
+  if (kind == NULL || kind[0] == '#') {
+    return true;
+  }
+  if (strcmp(kind, "receiver") == 0) {
+    return parse_receiver(pos, *last, THREAD);
+  }
+  *last = NULL;
+  if (strcmp(kind, "method") != 0) {
+    return false;
+  }
+  char* klass_name = next_token(&pos);
+  char* name = next_token(&pos);
+  char* signature = next_token(&pos);
+  int level, invocation_count, backedge_count, code_size, cell_count;
+  juint fingerprint;
+  char* token;
+  if (signature == NULL ||
+      !next_int(&pos, &level) ||
+      !next_int(&pos, &invocation_count) ||
+      !next_int(&pos, &backedge_count) ||
+      !next_int(&pos, &code_size) ||
+      (token = next_token(&pos)) == NULL || sscanf(token, "%u", &fingerprint) != 1 ||
+      !next_int(&pos, &cell_count) ||
+      cell_count < 0) {
+    return false;
+  }
+  // Create the symbols first, nothing is allocated yet if this throws.
+  Symbol* holder = SymbolTable::new_permanent_symbol(klass_name, CHECK_false);
+  Symbol* method_name = SymbolTable::new_permanent_symbol(name, CHECK_false);
+  Symbol* method_signature = SymbolTable::new_permanent_symbol(signature, CHECK_false);
+
+  intptr_t* cells = NEW_C_HEAP_ARRAY(intptr_t, cell_count, mtCompiler);
+  for (int i = 0; i < cell_count; i++) {
+    token = next_token(&pos);
+    intx value;
+    if (token == NULL || sscanf(token, INTX_FORMAT, &value) != 1) {
+      FREE_C_HEAP_ARRAY(intptr_t, cells);
+      return false;
+    }
+    cells[i] = value;
+  }
+
+  ProfileCacheEntry* e = new ProfileCacheEntry();
+  e->_name = method_name;
+  e->_signature = method_signature;
+  e->_level = level;
+  e->_invocation_count = invocation_count;
+  e->_backedge_count = backedge_count;
+  e->_code_size = code_size;
+  e->_fingerprint = fingerprint;
+  e->_cell_count = cell_count;
+  e->_cells = cells;
+  e->_receivers = NULL;
+  ProfileCacheEntry** head = _profile_cache_table->get(holder);
+  e->_next = (head != NULL) ? *head : NULL;
+  _profile_cache_table->put(holder, e);
+  *last = e;
+  return true;
+}
+
+bool ProfileCache::load(const char* filename, TRAPS) {
+  FILE* stream = fopen(filename, "rt");
+  if (stream == NULL) {
+    warning("Could not open profile cache file %s", filename);
+    return false;
+  }
+  _profile_cache_table = new (ResourceObj::C_HEAP, mtCompiler) ProfileCacheTable();
+
+  // Profiles of large methods make for long lines.
+  int capacity = 1024;
+  int len = 0;
+  int line_no = 0;
+  char* line = NEW_C_HEAP_ARRAY(char, capacity, mtCompiler);
+  ProfileCacheEntry* last = NULL;
+  bool ok = true;
+  while (ok) {
+    int c = getc(stream);
+    if (c == EOF || c == '\n') {
+      line[len] = '\0';
+      line_no++;
+      if (!parse_line(line, &last, THREAD)) {
+        if (HAS_PENDING_EXCEPTION) {
+          ok = false;
+        } else {
+          log_warning(jit, compilation)("Skipping malformed line %d of profile cache file %s", line_no, filename);
+        }
+      }
+      len = 0;
+      if (c == EOF) {
+        break;
+      }
+      continue;
+    }
+    if (len + 1 >= capacity) {
+      line = REALLOC_C_HEAP_ARRAY(char, line, capacity * 2, mtCompiler);
+      capacity *= 2;
+    }
+    line[len++] = (char)c;
+  }
+  FREE_C_HEAP_ARRAY(char, line);
+  fclose(stream);
+  log_info(jit, compilation)("Read profile cache file %s", filename);
+  return ok;
+}
+
+void ProfileCache::initialize(TRAPS) {
+  if (!UseProfileCache) {
+    return;
+  }
+  if (ProfileCacheFile == NULL) {
+    warning("UseProfileCache requires ProfileCacheFile to be set");
+    return;
+  }
+  load(ProfileCacheFile, THREAD);
+}
+
+void profileCache_init() {
+  Thread* THREAD = Thread::current();
+  ProfileCache::initialize(THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    CLEAR_PENDING_EXCEPTION;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Seeding
+
+// Copy the saved profile into a freshly built MethodData.  The layout
+// must match data by data, otherwise the flags which shape the
+// MethodData differ from the run which saved it.
+static bool seed_method_data(MethodData* mdo, ProfileCacheEntry* e) {
+  if (mdo->data_size() != e->_cell_count * (int)sizeof(intptr_t)) {
+    return false;
+  }
+  ResourceMark rm;
+  for (ProfileData* data = mdo->first_data();
+       mdo->is_valid(data);
+       data = mdo->next_data(data)) {
+    DataLayout* saved = (DataLayout*)((address)e->_cells + mdo->dp_to_di(data->dp()));
+    if (saved->tag() != ((DataLayout*)data->dp())->tag() || saved->bci() != data->bci()) {
+      return false;
+    }
+  }
+  memcpy((void*)mdo->data_base(), (void*)e->_cells, mdo->data_size());
+  return true;
+}
+
+// Put the saved receivers back into the rows they were recorded in.
+// Receivers which are not loaded yet, or not visible from the loader of
+// the method, are left out.  Returns the number of rows restored.
+static int seed_receivers(const methodHandle& mh, MethodData* mdo, ProfileCacheEntry* e, TRAPS) {
+  if (e->_receivers == NULL) {
+    return 0;
+  }
+  ResourceMark rm(THREAD);
+  Handle loader(THREAD, mh->method_holder()->class_loader());
+  int restored = 0;
+  for (ProfileData* data = mdo->first_data();
+       mdo->is_valid(data);
+       data = mdo->next_data(data)) {
+    if (!data->is_ReceiverTypeData()) {
+      continue;
+    }
+    int data_index = mdo->dp_to_di(data->dp());
+    ReceiverTypeData* rtd = data->as_ReceiverTypeData();
+    for (ProfileCacheReceiver* r = e->_receivers; r != NULL; r = r->_next) {
+      if (r->_data_index != data_index || r->_row < 0 || (uint)r->_row >= ReceiverTypeData::row_limit()) {
+        continue;
+      }
+      Klass* k = SystemDictionary::find_constrained_instance_or_array_klass(r->_klass, loader, THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        CLEAR_PENDING_EXCEPTION;
+        continue;
+      }
+      if (k != NULL) {
+        rtd->set_receiver(r->_row, k);
+        rtd->set_receiver_count(r->_row, r->_count);
+        restored++;
+      }
+    }
+  }
+  return restored;
+}
+
+void ProfileCache::seed_profiles(InstanceKlass* ik, TRAPS) {
+  if (_profile_cache_table == NULL) {
+    return;
+  }
+  ProfileCacheEntry** head = _profile_cache_table->get(ik->name());
+  if (head == NULL) {
+    return;
+  }
+  for (ProfileCacheEntry* e = *head; e != NULL; e = e->_next) {
+    Method* m = ik->find_method(e->_name, e->_signature);
+    if (m == NULL || m->method_data() != NULL || m->code_size() != e->_code_size) {
+      continue;
+    }
+    methodHandle mh(THREAD, m);
+    if (bytecode_fingerprint(mh) != e->_fingerprint) {
+      if (log_is_enabled(Debug, jit, compilation)) {
+        ResourceMark rm(THREAD);
+        log_debug(jit, compilation)("Bytecodes of %s changed, profile not seeded", mh->name_and_sig_as_C_string());
+      }
+      continue;
+    }
+    Method::build_interpreter_method_data(mh, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      return;
+    }
+    MethodData* mdo = mh->method_data();
+    if (mdo == NULL || !seed_method_data(mdo, e)) {
+      continue;
+    }
+    int receivers = seed_receivers(mh, mdo, e, THREAD);
+
+    // Seed the counters the policy looks at so the method goes to the
+    // highest tier at its first invocation or backedge event.
+    int invocation_count = MIN2(e->_invocation_count, (int)InvocationCounter::count_limit - 1);
+    int backedge_count = MIN2(e->_backedge_count, (int)InvocationCounter::count_limit - 1);
+    if (TieredCompilation) {
+      mdo->invocation_counter()->set(mdo->invocation_counter()->state(), invocation_count);
+      mdo->backedge_counter()->set(mdo->backedge_counter()->state(), backedge_count);
+    } else {
+      MethodCounters* mcs = Method::build_method_counters(mh(), THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        CLEAR_PENDING_EXCEPTION;
+        return;
+      }
+      if (mcs != NULL) {
+        mcs->invocation_counter()->set(mcs->invocation_counter()->state(), invocation_count);
+        mcs->backedge_counter()->set(mcs->backedge_counter()->state(), backedge_count);
+      }
+    }
+    if (log_is_enabled(Debug, jit, compilation)) {
+      ResourceMark rm(THREAD);
+      log_debug(jit, compilation)("Seeded profile of %s (level %d, %d invocations, %d backedges, %d receivers)",
+                                  mh->name_and_sig_as_C_string(), e->_level,
+                                  invocation_count, backedge_count, receivers);
+    }
+  }
+}
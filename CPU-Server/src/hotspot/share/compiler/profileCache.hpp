@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_COMPILER_PROFILECACHE_HPP
+#define SHARE_VM_COMPILER_PROFILECACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+
+class InstanceKlass;
+class outputStream;
+
+// ProfileCache persists the profiles of hot methods across runs.
+//
+// At exit (DumpProfileCacheAtExit) or on request (Compiler.dump_profiles)
+// the MethodData of every method that reached the highest compilation
+// tier is written to ProfileCacheFile together with its invocation and
+// backedge counts.  Klass pointers are dropped from the profiles, except
+// for the receivers of call sites and type checks, which are saved by name
+// and restored if the class is already loaded when the profile is seeded.
+//
+// With UseProfileCache the file is read at startup.  When a class is
+// linked, the recorded methods whose bytecodes still match get a
+// MethodData seeded with the saved profile and counters, so the
+// compilation policy moves them to the highest tier at their first
+// invocation event instead of profiling them again.
+class ProfileCache : AllStatic {
+ private:
+  static bool load(const char* filename, TRAPS);
+
+ public:
+  // Read ProfileCacheFile if UseProfileCache is set.
+  static void initialize(TRAPS);
+
+  // Seed the profiles of the methods of a class which was just linked.
+  static void seed_profiles(InstanceKlass* ik, TRAPS);
+
+  // Write the profiles of hot methods; returns the number of methods
+  // written or -1 on failure.  Must be called at a safepoint.
+  static int dump(const char* filename, outputStream* out);
+
+  // Dump to ProfileCacheFile if DumpProfileCacheAtExit is set.
+  static void dump_at_exit();
+};
+
+#endif // SHARE_VM_COMPILER_PROFILECACHE_HPP
@@ -25,6 +25,7 @@
 #define SHARE_VM_GC_EPSILON_COLLECTEDHEAP_HPP
 
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/markBitMap.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/space.hpp"
 #include "services/memoryManager.hpp"
@@ -49,13 +50,15 @@ private:
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  MemRegion  _bitmap_region;
+  MarkBitMap _bitmap;
 
 public:
   static EpsilonHeap* heap();
 
   EpsilonHeap(EpsilonCollectorPolicy* p) :
           _policy(p),
-          _memory_manager("Epsilon Heap", "") {};
+          _memory_manager("Epsilon Heap", "end of major GC") {};
 
   virtual Name kind() const {
     return CollectedHeap::Epsilon;
@@ -89,7 +92,8 @@ public:
   }
 
   virtual bool is_scavengable(oop obj) {
-    // No GC is going to happen, therefore no objects ever move.
+    // No young collection is going to happen. The sliding mark-compact
+    // cycle, if enabled, walks all code blobs on its own.
     return false;
   }
 
@@ -100,6 +104,7 @@ public:
 
   // Allocation
   HeapWord* allocate_work(size_t size);
+  HeapWord* allocate_or_collect_work(size_t size);
   virtual HeapWord* mem_allocate(size_t size, bool* gc_overhead_limit_was_exceeded);
   virtual HeapWord* allocate_new_tlab(size_t min_size,
                                       size_t requested_size,
@@ -121,8 +126,10 @@ public:
     safe_object_iterate(cl);
   }
 
-  // Object pinning support: every object is implicitly pinned
-  virtual bool supports_object_pinning() const           { return true; }
+  // Object pinning support: every object is implicitly pinned, unless
+  // the sliding mark-compact cycle can move it. In that case, JNI critical
+  // regions are guarded by GCLocker instead.
+  virtual bool supports_object_pinning() const           { return !EpsilonSlidingGC; }
   virtual oop pin_object(JavaThread* thread, oop obj)    { return obj; }
   virtual void unpin_object(JavaThread* thread, oop obj) { }
 
@@ -147,10 +154,20 @@ public:
   virtual void print_on(outputStream* st) const;
   virtual void print_tracing_info() const;
 
+  // Sliding mark-compact support
+  void entry_collect(GCCause::Cause cause);
+
 private:
   void print_heap_info(size_t used) const;
   void print_metaspace_info() const;
 
+  void vmentry_collect(GCCause::Cause cause);
+
+  void do_roots(OopClosure* cl, bool everything);
+  void process_roots(OopClosure* cl)     { do_roots(cl, false); }
+  void process_all_roots(OopClosure* cl) { do_roots(cl, true);  }
+  void walk_bitmap(ObjectClosure* cl);
+
 };
 
 #endif // SHARE_VM_GC_EPSILON_COLLECTEDHEAP_HPP
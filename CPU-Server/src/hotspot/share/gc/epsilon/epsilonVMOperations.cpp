@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Red Hat, Inc. All rights reserved.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/epsilon/epsilonHeap.hpp"
+#include "gc/epsilon/epsilonVMOperations.hpp"
+#include "gc/shared/gcLocker.hpp"
+#include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/isGCActiveMark.hpp"
+#include "runtime/mutexLocker.hpp"
+
+size_t VM_EpsilonCollect::_last_used = 0;
+
+VM_EpsilonCollect::VM_EpsilonCollect(GCCause::Cause cause) :
+  VM_Operation(),
+  _cause(cause),
+  _heap(EpsilonHeap::heap()) {}
+
+bool VM_EpsilonCollect::doit_prologue() {
+  // Need to take the Heap_lock before managing backing storage. This also
+  // serializes GC requests, and allows us to coalesce back-to-back allocation
+  // failure requests from many threads: there is no need to handle the failure
+  // that comes without allocations since the last complete cycle. Waiting for
+  // 1% of the heap to be allocated before starting the next cycle resolves
+  // most of these races.
+  Heap_lock->lock();
+  size_t used = _heap->used();
+  size_t capacity = _heap->capacity();
+  size_t allocated = used > _last_used ? used - _last_used : 0;
+  if (_cause != GCCause::_allocation_failure || allocated > capacity / 100) {
+    return true;
+  } else {
+    Heap_lock->unlock();
+    return false;
+  }
+}
+
+void VM_EpsilonCollect::doit() {
+  SvcGCMarker sgcm(SvcGCMarker::FULL);
+  IsGCActiveMark mark;
+  _heap->entry_collect(_cause);
+}
+
+void VM_EpsilonCollect::doit_epilogue() {
+  // A cycle skipped for an active JNI critical region did not reclaim
+  // anything, so it must not coalesce the requests that follow it. The
+  // deferred cycle cannot complete before we release the Heap_lock.
+  if (!GCLocker::needs_gc()) {
+    _last_used = _heap->used();
+  }
+  Heap_lock->unlock();
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019, Red Hat, Inc. All rights reserved.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_EPSILON_EPSILONVMOPERATIONS_HPP
+#define SHARE_VM_GC_EPSILON_EPSILONVMOPERATIONS_HPP
+
+#include "gc/shared/gcCause.hpp"
+#include "runtime/vmOperations.hpp"
+
+class EpsilonHeap;
+
+// Runs the Epsilon sliding mark-compact cycle at a safepoint.
+//
+// Requests are serialized on the Heap_lock. Allocation failure requests
+// arriving without much allocation since the last cycle completed are
+// coalesced with it: the requesting threads simply retry the allocation.
+class VM_EpsilonCollect: public VM_Operation {
+private:
+  const GCCause::Cause _cause;
+  EpsilonHeap* const _heap;
+  static size_t _last_used;
+
+public:
+  VM_EpsilonCollect(GCCause::Cause cause);
+
+  VM_Operation::VMOp_Type type() const { return VMOp_EpsilonCollect; }
+  const char* name()             const { return "Epsilon Collection"; }
+
+  virtual bool doit_prologue();
+  virtual void doit();
+  virtual void doit_epilogue();
+};
+
+#endif // SHARE_VM_GC_EPSILON_EPSILONVMOPERATIONS_HPP
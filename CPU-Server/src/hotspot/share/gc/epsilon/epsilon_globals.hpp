@@ -91,6 +91,21 @@
   experimental(size_t, EpsilonMinHeapExpand, 128 * M,                       \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  experimental(bool, EpsilonSlidingGC, false,                               \
+          "Reclaim memory with a single-threaded stop-the-world sliding "   \
+          "mark-compact cycle when allocation fails. Allocations and "      \
+          "barriers stay as cheap as without it, but the heap takes a "     \
+          "marking bitmap worth 1/64 of its size while the cycle runs.")    \
+                                                                            \
+  experimental(bool, EpsilonUncommit, false,                                \
+          "Uncommit the heap memory freed by the sliding mark-compact "     \
+          "cycle. Lowers the footprint at the expense of expanding the "    \
+          "heap again when allocations resume.")                            \
+                                                                            \
+  diagnostic(bool, EpsilonVerify, false,                                    \
+          "Verify the heap and the roots after each sliding mark-compact "  \
+          "cycle. Expensive, for debugging only.")
 
 #endif // SHARE_VM_GC_EPSILON_GLOBALS_HPP
@@ -77,6 +77,8 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _alloc_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _prev_collection_pause_end_ms(0.0),
     _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _dirtied_cards_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _concurrent_refine_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_card_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_scan_hcc_seq(new TruncatedSeq(TruncatedSeqLength)),
     _young_cards_per_entry_ratio_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -135,6 +137,14 @@ void G1Analytics::report_alloc_rate_ms(double alloc_rate) {
   _alloc_rate_ms_seq->add(alloc_rate);
 }
 
+void G1Analytics::report_dirtied_cards_rate_ms(double cards_per_ms) {
+  _dirtied_cards_rate_ms_seq->add(cards_per_ms);
+}
+
+void G1Analytics::report_concurrent_refine_rate_ms(double cards_per_ms) {
+  _concurrent_refine_rate_ms_seq->add(cards_per_ms);
+}
+
 void G1Analytics::compute_pause_time_ratio(double interval_ms, double pause_time_ms) {
   _recent_avg_pause_time_ratio = _recent_gc_times_ms->sum() / interval_ms;
   if (_recent_avg_pause_time_ratio < 0.0 ||
@@ -222,6 +232,20 @@ double G1Analytics::predict_alloc_rate_ms() const {
   return get_new_prediction(_alloc_rate_ms_seq);
 }
 
+double G1Analytics::predict_dirtied_cards_rate_ms() const {
+  return get_new_prediction(_dirtied_cards_rate_ms_seq);
+}
+
+double G1Analytics::predict_concurrent_refine_rate_ms() const {
+  return get_new_prediction(_concurrent_refine_rate_ms_seq);
+}
+
+bool G1Analytics::has_concurrent_refine_rates() const {
+  return _dirtied_cards_rate_ms_seq->num() > 0 &&
+         _concurrent_refine_rate_ms_seq->num() > 0 &&
+         _alloc_rate_ms_seq->num() > 0;
+}
+
 double G1Analytics::predict_cost_per_card_ms() const {
   return get_new_prediction(_cost_per_card_ms_seq);
 }
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardSet.hpp"
+#include "gc/g1/g1CardSetContainers.inline.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+G1CardSetConfiguration::G1CardSetConfiguration(uint num_cards_in_region,
+                                               uint num_cards_in_array,
+                                               uint num_buckets,
+                                               uint coarsen_bitmap_to_full_percent) :
+  _inline_ptr_bits_per_card(0),
+  _num_cards_in_inline_ptr(0),
+  _num_cards_in_array(0),
+  _num_cards_in_region(num_cards_in_region),
+  _cards_in_bitmap_threshold(0),
+  _num_buckets(0) {
+  assert(num_cards_in_region >= 2, "Region must have at least two cards");
+  assert(coarsen_bitmap_to_full_percent > 0 && coarsen_bitmap_to_full_percent <= 100,
+         "Invalid coarsening percentage %u", coarsen_bitmap_to_full_percent);
+
+  _inline_ptr_bits_per_card = log2_intptr((intptr_t)num_cards_in_region - 1) + 1;
+  _num_cards_in_inline_ptr = G1CardSetInlinePtr::max_cards_in_inline_ptr(_inline_ptr_bits_per_card);
+
+  // The array must hold more cards than the inline pointer, but should never
+  // need more memory than the bitmap.
+  const uint min_cards_in_array = _num_cards_in_inline_ptr + 1;
+  const uint max_cards_in_array = MAX2(min_cards_in_array,
+                                       num_cards_in_region / (uint)(sizeof(G1CardSetArray::EntryDataType) * BitsPerByte));
+  _num_cards_in_array = MIN2(MAX2(num_cards_in_array, min_cards_in_array), max_cards_in_array);
+
+  _cards_in_bitmap_threshold = MAX2((uint)((size_t)num_cards_in_region * coarsen_bitmap_to_full_percent / 100), 1u);
+
+  _num_buckets = (uint)1 << log2_intptr((intptr_t)MAX2(num_buckets, 1u));
+}
+
+size_t G1CardSetConfiguration::array_size_in_bytes() const {
+  return G1CardSetArray::size_in_bytes(_num_cards_in_array);
+}
+
+size_t G1CardSetConfiguration::bitmap_size_in_bytes() const {
+  return G1CardSetBitMap::size_in_bytes(_num_cards_in_region);
+}
+
+void G1CardSetConfiguration::print_on(outputStream* out) const {
+  out->print_cr("Card set configuration: cards per region %u, inline pointer %u cards (%u bits each), "
+                "array %u cards, bitmap coarsened to full at %u cards, %u buckets",
+                _num_cards_in_region, _num_cards_in_inline_ptr, _inline_ptr_bits_per_card,
+                _num_cards_in_array, _cards_in_bitmap_threshold, _num_buckets);
+}
+
+G1CardSet::CardSetPtr const G1CardSet::FullCardSet = (G1CardSet::CardSetPtr)-1;
+
+volatile jint G1CardSet::_num_coarsenings = 0;
+volatile size_t G1CardSet::_retired_mem_size = 0;
+
+G1CardSet::CardSetPtr G1CardSet::Node::card_set() const {
+  return OrderAccess::load_acquire(&_card_set);
+}
+
+G1CardSet::G1CardSet(G1CardSetConfiguration* config) :
+  _config(config),
+  _buckets(NULL),
+  _num_regions(0),
+  _mem_size(0),
+  _retired(NULL) {
+}
+
+G1CardSet::~G1CardSet() {
+  clear();
+}
+
+G1CardSet::Node** G1CardSet::buckets() const {
+  return OrderAccess::load_acquire(&_buckets);
+}
+
+G1CardSet::Node** G1CardSet::get_or_create_buckets() {
+  Node** buckets = this->buckets();
+  if (buckets != NULL) {
+    return buckets;
+  }
+
+  const uint num_buckets = _config->num_buckets();
+  Node** new_buckets = NEW_C_HEAP_ARRAY(Node*, num_buckets, mtGC);
+  memset(new_buckets, 0, num_buckets * sizeof(Node*));
+
+  buckets = Atomic::cmpxchg(new_buckets, &_buckets, (Node**)NULL);
+  if (buckets != NULL) {
+    // Another thread installed the buckets first.
+    FREE_C_HEAP_ARRAY(Node*, new_buckets);
+    return buckets;
+  }
+
+  Atomic::add(num_buckets * sizeof(Node*), &_mem_size);
+  return new_buckets;
+}
+
+G1CardSet::Node* G1CardSet::find_node(Node* from, Node* until, uint region_idx) {
+  for (Node* node = from; node != until; node = node->next()) {
+    if (node->region_idx() == region_idx) {
+      return node;
+    }
+  }
+  return NULL;
+}
+
+G1CardSet::Node* G1CardSet::get_node(uint region_idx) const {
+  Node** buckets = this->buckets();
+  if (buckets == NULL) {
+    return NULL;
+  }
+  Node* head = OrderAccess::load_acquire(&buckets[region_idx & (_config->num_buckets() - 1)]);
+  return find_node(head, NULL, region_idx);
+}
+
+G1CardSet::Node* G1CardSet::get_or_add_node(uint region_idx) {
+  Node** buckets = get_or_create_buckets();
+  Node** bucket = &buckets[region_idx & (_config->num_buckets() - 1)];
+
+  Node* head = OrderAccess::load_acquire(bucket);
+  Node* node = find_node(head, NULL, region_idx);
+  if (node != NULL) {
+    return node;
+  }
+
+  // Nodes are only ever prepended to the bucket list, and only removed when
+  // the card set is cleared, so if the insertion fails it suffices to look
+  // at the nodes inserted by other threads in the meantime.
+  Node* new_node = new Node(region_idx, head);
+  while (true) {
+    Node* prev_head = Atomic::cmpxchg(new_node, bucket, head);
+    if (prev_head == head) {
+      Atomic::inc(&_num_regions);
+      Atomic::add(sizeof(Node), &_mem_size);
+      return new_node;
+    }
+
+    node = find_node(prev_head, head, region_idx);
+    if (node != NULL) {
+      // Another thread added the region first.
+      delete new_node;
+      return node;
+    }
+
+    head = prev_head;
+    new_node->set_next(head);
+  }
+}
+
+G1CardSet::CardSetPtr G1CardSet::create_array() {
+  void* mem = NEW_C_HEAP_ARRAY(char, _config->array_size_in_bytes(), mtGC);
+  G1CardSetArray* array = ::new (mem) G1CardSetArray(_config->num_cards_in_array());
+  return make_card_set_ptr(array, CardSetArrayOfCards);
+}
+
+G1CardSet::CardSetPtr G1CardSet::create_bitmap() {
+  void* mem = NEW_C_HEAP_ARRAY(char, _config->bitmap_size_in_bytes(), mtGC);
+  G1CardSetBitMap* bitmap = ::new (mem) G1CardSetBitMap(_config->num_cards_in_region());
+  return make_card_set_ptr(bitmap, CardSetBitMap);
+}
+
+size_t G1CardSet::container_mem_size(CardSetPtr card_set) const {
+  switch (card_set_type(card_set)) {
+    case CardSetArrayOfCards: return _config->array_size_in_bytes();
+    case CardSetBitMap:       return _config->bitmap_size_in_bytes();
+    default:                  return 0;
+  }
+}
+
+void G1CardSet::free_container(CardSetPtr card_set) {
+  switch (card_set_type(card_set)) {
+    case CardSetArrayOfCards:
+    case CardSetBitMap:
+      FREE_C_HEAP_ARRAY(char, card_set_ptr<char>(card_set));
+      break;
+    default:
+      // Inline pointers and the full card set do not use any memory.
+      break;
+  }
+}
+
+void G1CardSet::retire_container(CardSetPtr card_set) {
+  G1CardSetContainer* container = card_set_ptr<G1CardSetContainer>(card_set);
+  CardSetPtr head = _retired;
+  while (true) {
+    container->set_next_retired(head);
+    CardSetPtr prev_head = Atomic::cmpxchg(card_set, &_retired, head);
+    if (prev_head == head) {
+      break;
+    }
+    head = prev_head;
+  }
+
+  const size_t size = container_mem_size(card_set);
+  Atomic::sub(size, &_mem_size);
+  Atomic::add(size, &_retired_mem_size);
+}
+
+G1AddCardResult G1CardSet::add_to_container(CardSetPtr volatile* card_set_addr, CardSetPtr card_set, uint card_in_region) {
+  switch (card_set_type(card_set)) {
+    case CardSetInlinePtr: {
+      G1CardSetInlinePtr value(card_set_addr, card_set);
+      return value.add(card_in_region, _config->inline_ptr_bits_per_card(), _config->num_cards_in_inline_ptr());
+    }
+    case CardSetArrayOfCards:
+      return card_set_ptr<G1CardSetArray>(card_set)->add(card_in_region);
+    case CardSetBitMap:
+      return card_set_ptr<G1CardSetBitMap>(card_set)->add(card_in_region,
+                                                          _config->cards_in_bitmap_threshold(),
+                                                          _config->num_cards_in_region());
+    default:
+      assert(card_set == FullCardSet, "Unexpected card set " PTR_FORMAT, p2i(card_set));
+      return Found;
+  }
+}
+
+bool G1CardSet::coarsen_container(CardSetPtr volatile* card_set_addr, CardSetPtr card_set) {
+  CardSetPtr new_card_set = NULL;
+
+  switch (card_set_type(card_set)) {
+    case CardSetInlinePtr: {
+      new_card_set = create_array();
+      G1CardSetArray* array = card_set_ptr<G1CardSetArray>(new_card_set);
+      G1CardSetInlinePtr value(card_set);
+      for (uint i = 0; i < value.num_cards(); i++) {
+        array->add(value.card_at(i, _config->inline_ptr_bits_per_card()));
+      }
+      break;
+    }
+    case CardSetArrayOfCards: {
+      new_card_set = create_bitmap();
+      G1CardSetBitMap* bitmap = card_set_ptr<G1CardSetBitMap>(new_card_set);
+      // An array only overflows when it is full, after which it never
+      // changes again, so all of its cards are copied.
+      G1CardSetArray* array = card_set_ptr<G1CardSetArray>(card_set);
+      for (G1CardSetArray::EntryCountType i = 0; i < array->num_entries(); i++) {
+        bitmap->add(array->at(i), _config->num_cards_in_region(), _config->num_cards_in_region());
+      }
+      break;
+    }
+    case CardSetBitMap:
+      new_card_set = FullCardSet;
+      break;
+    default:
+      ShouldNotReachHere();
+  }
+
+  CardSetPtr old_card_set = Atomic::cmpxchg(new_card_set, card_set_addr, card_set);
+  if (old_card_set != card_set) {
+    // Another thread changed the container in the meantime.
+    free_container(new_card_set);
+    return false;
+  }
+
+  Atomic::add(container_mem_size(new_card_set), &_mem_size);
+  if (card_set_type(card_set) != CardSetInlinePtr) {
+    retire_container(card_set);
+  }
+  if (new_card_set == FullCardSet) {
+    Atomic::inc(&_num_coarsenings);
+  }
+  return true;
+}
+
+G1AddCardResult G1CardSet::add_card(uint region_idx, uint card_in_region) {
+  assert(card_in_region < _config->num_cards_in_region(),
+         "Card %u is beyond the number of cards in a region %u", card_in_region, _config->num_cards_in_region());
+
+  Node* node = get_or_add_node(region_idx);
+  while (true) {
+    CardSetPtr card_set = node->card_set();
+    G1AddCardResult result = add_to_container(node->card_set_addr(), card_set, card_in_region);
+    if (result != Overflow) {
+      return result;
+    }
+    // Replace the container and retry, regardless of who won the race.
+    coarsen_container(node->card_set_addr(), card_set);
+  }
+}
+
+bool G1CardSet::contains_in_container(CardSetPtr card_set, uint card_in_region) const {
+  switch (card_set_type(card_set)) {
+    case CardSetInlinePtr:
+      return G1CardSetInlinePtr(card_set).contains(card_in_region, _config->inline_ptr_bits_per_card());
+    case CardSetArrayOfCards:
+      return card_set_ptr<G1CardSetArray>(card_set)->contains(card_in_region);
+    case CardSetBitMap:
+      return card_set_ptr<G1CardSetBitMap>(card_set)->contains(card_in_region, _config->num_cards_in_region());
+    default:
+      return true;
+  }
+}
+
+bool G1CardSet::contains_card(uint region_idx, uint card_in_region) const {
+  Node* node = get_node(region_idx);
+  return node != NULL && contains_in_container(node->card_set(), card_in_region);
+}
+
+size_t G1CardSet::occupied_in_container(CardSetPtr card_set) const {
+  switch (card_set_type(card_set)) {
+    case CardSetInlinePtr:
+      return G1CardSetInlinePtr::num_cards_in(card_set);
+    case CardSetArrayOfCards:
+      return card_set_ptr<G1CardSetArray>(card_set)->num_entries();
+    case CardSetBitMap:
+      return card_set_ptr<G1CardSetBitMap>(card_set)->num_bits_set();
+    default:
+      return _config->num_cards_in_region();
+  }
+}
+
+size_t G1CardSet::occupied() const {
+  Node** buckets = this->buckets();
+  if (buckets == NULL) {
+    return 0;
+  }
+
+  size_t sum = 0;
+  for (uint i = 0; i < _config->num_buckets(); i++) {
+    for (Node* node = OrderAccess::load_acquire(&buckets[i]); node != NULL; node = node->next()) {
+      sum += occupied_in_container(node->card_set());
+    }
+  }
+  return sum;
+}
+
+bool G1CardSet::occupancy_less_or_equal_to(size_t limit) const {
+  Node** buckets = this->buckets();
+  if (buckets == NULL) {
+    return true;
+  }
+  if (_num_regions > limit) {
+    // Every source region holds at least one card.
+    return false;
+  }
+
+  size_t sum = 0;
+  for (uint i = 0; i < _config->num_buckets(); i++) {
+    for (Node* node = OrderAccess::load_acquire(&buckets[i]); node != NULL; node = node->next()) {
+      sum += occupied_in_container(node->card_set());
+      if (sum > limit) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+size_t G1CardSet::mem_size() const {
+  return sizeof(G1CardSet) + _mem_size;
+}
+
+void G1CardSet::clear() {
+  Node** buckets = _buckets;
+  if (buckets != NULL) {
+    for (uint i = 0; i < _config->num_buckets(); i++) {
+      Node* node = buckets[i];
+      while (node != NULL) {
+        Node* next = node->next();
+        free_container(node->card_set());
+        delete node;
+        node = next;
+      }
+    }
+    FREE_C_HEAP_ARRAY(Node*, buckets);
+    _buckets = NULL;
+  }
+
+  CardSetPtr retired = _retired;
+  while (retired != NULL) {
+    CardSetPtr next = card_set_ptr<G1CardSetContainer>(retired)->next_retired();
+    Atomic::sub(container_mem_size(retired), &_retired_mem_size);
+    free_container(retired);
+    retired = next;
+  }
+  _retired = NULL;
+
+  _num_regions = 0;
+  _mem_size = 0;
+}
+
+G1CardSetIterator::G1CardSetIterator(const G1CardSet* card_set) :
+  _card_set(card_set),
+  _node(NULL),
+  _bucket(0),
+  _container(NULL),
+  _pos(0),
+  _limit(0) {
+  for (uintptr_t i = 0; i <= G1CardSet::CardSetFull; i++) {
+    _num_yielded[i] = 0;
+  }
+}
+
+bool G1CardSetIterator::advance_node() {
+  G1CardSet::Node** buckets = _card_set->buckets();
+  if (buckets == NULL) {
+    return false;
+  }
+
+  if (_node != NULL) {
+    _node = _node->next();
+  }
+  const uint num_buckets = _card_set->_config->num_buckets();
+  while (_node == NULL) {
+    if (_bucket == num_buckets) {
+      return false;
+    }
+    _node = OrderAccess::load_acquire(&buckets[_bucket]);
+    _bucket++;
+  }
+
+  // Take a snapshot of the container; cards added after this point may
+  // not be yielded.
+  _container = _node->card_set();
+  _pos = 0;
+  switch (G1CardSet::card_set_type(_container)) {
+    case G1CardSet::CardSetInlinePtr:
+      _limit = G1CardSetInlinePtr::num_cards_in(_container);
+      break;
+    case G1CardSet::CardSetArrayOfCards:
+      _limit = G1CardSet::card_set_ptr<G1CardSetArray>(_container)->num_entries();
+      break;
+    default:
+      _limit = _card_set->_config->num_cards_in_region();
+      break;
+  }
+  return true;
+}
+
+bool G1CardSetIterator::next_in_container(uint& card_in_region) {
+  switch (G1CardSet::card_set_type(_container)) {
+    case G1CardSet::CardSetInlinePtr:
+      if (_pos < _limit) {
+        card_in_region = G1CardSetInlinePtr(_container).card_at((uint)_pos, _card_set->_config->inline_ptr_bits_per_card());
+        _pos++;
+        return true;
+      }
+      return false;
+    case G1CardSet::CardSetArrayOfCards:
+      if (_pos < _limit) {
+        card_in_region = G1CardSet::card_set_ptr<G1CardSetArray>(_container)->at((G1CardSetArray::EntryCountType)_pos);
+        _pos++;
+        return true;
+      }
+      return false;
+    case G1CardSet::CardSetBitMap:
+      _pos = G1CardSet::card_set_ptr<G1CardSetBitMap>(_container)->next_card(_pos, _limit);
+      if (_pos < _limit) {
+        card_in_region = (uint)_pos;
+        _pos++;
+        return true;
+      }
+      return false;
+    default:
+      if (_pos < _limit) {
+        card_in_region = (uint)_pos;
+        _pos++;
+        return true;
+      }
+      return false;
+  }
+}
+
+bool G1CardSetIterator::has_next(uint& region_idx, uint& card_in_region) {
+  while (_node == NULL || !next_in_container(card_in_region)) {
+    if (!advance_node()) {
+      return false;
+    }
+  }
+  region_idx = _node->region_idx();
+  _num_yielded[G1CardSet::card_set_type(_container)]++;
+  return true;
+}
+
+size_t G1CardSetIterator::num_yielded() const {
+  size_t sum = 0;
+  for (uintptr_t i = 0; i <= G1CardSet::CardSetFull; i++) {
+    sum += _num_yielded[i];
+  }
+  return sum;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1CARDSET_HPP
+#define SHARE_VM_GC_G1_G1CARDSET_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class G1CardSetArray;
+class G1CardSetBitMap;
+class G1CardSetIterator;
+class outputStream;
+
+enum G1AddCardResult {
+  Overflow,  // The card set container is full and must be coarsened.
+  Found,     // The card is already in the card set.
+  Added      // The card has been added to the card set.
+};
+
+// Static sizing of the card set containers, shared by all card sets.
+class G1CardSetConfiguration : public CHeapObj<mtGC> {
+  // Number of bits needed to encode a card index within a region.
+  uint _inline_ptr_bits_per_card;
+  uint _num_cards_in_inline_ptr;
+  uint _num_cards_in_array;
+  // The bitmap container covers all cards of a region.
+  uint _num_cards_in_region;
+  // Bitmap containers holding this many cards are coarsened to full.
+  uint _cards_in_bitmap_threshold;
+  // Number of buckets in the per card set hash table; a power of two.
+  uint _num_buckets;
+
+public:
+  G1CardSetConfiguration(uint num_cards_in_region,
+                         uint num_cards_in_array,
+                         uint num_buckets,
+                         uint coarsen_bitmap_to_full_percent);
+
+  uint inline_ptr_bits_per_card() const  { return _inline_ptr_bits_per_card; }
+  uint num_cards_in_inline_ptr() const   { return _num_cards_in_inline_ptr; }
+  uint num_cards_in_array() const        { return _num_cards_in_array; }
+  uint num_cards_in_region() const       { return _num_cards_in_region; }
+  uint cards_in_bitmap_threshold() const { return _cards_in_bitmap_threshold; }
+  uint num_buckets() const               { return _num_buckets; }
+
+  size_t array_size_in_bytes() const;
+  size_t bitmap_size_in_bytes() const;
+
+  void print_on(outputStream* out) const;
+};
+
+// A set of cards, grouped by the region containing them (the source region).
+//
+// The cards of every source region are kept in a container whose
+// representation adapts to the number of cards it holds:
+//
+//   - inline pointer: a handful of cards encoded directly into the container
+//     pointer, so small sets do not allocate any memory.
+//   - array of cards: an unsorted array of card indices.
+//   - bitmap: one bit for every card in the source region.
+//   - full: all cards of the source region, i.e. the whole region must be
+//     scanned. This is the only representation that loses precision.
+//
+// A container is replaced by the next larger representation when it
+// overflows. The containers are found through a hash table of source region
+// indices; both the hash table and the containers support concurrent,
+// lock-free insertion. Only adding a card to an array container briefly
+// serializes on that array.
+//
+// Replaced containers may still be accessed by concurrent readers and
+// writers, so they are put on a retired list, and are only freed when the
+// card set is cleared, which happens at a safepoint or when no other
+// thread can access the card set.
+class G1CardSet : public CHeapObj<mtGC> {
+  friend class G1CardSetIterator;
+
+public:
+  // Tagged pointer to a card set container. The two least significant bits
+  // encode the type of the container.
+  typedef void* CardSetPtr;
+
+  static const uintptr_t CardSetInlinePtr    = 0x0;
+  static const uintptr_t CardSetArrayOfCards = 0x1;
+  static const uintptr_t CardSetBitMap       = 0x2;
+  static const uintptr_t CardSetFull         = 0x3;
+
+  static const uintptr_t CardSetPtrTypeMask  = 0x3;
+
+  // The full card set does not need any memory.
+  static CardSetPtr const FullCardSet;
+
+  static uintptr_t card_set_type(CardSetPtr ptr) {
+    return (uintptr_t)ptr & CardSetPtrTypeMask;
+  }
+
+  template <class T>
+  static T* card_set_ptr(CardSetPtr ptr) {
+    return (T*)((uintptr_t)ptr & ~CardSetPtrTypeMask);
+  }
+
+  static CardSetPtr make_card_set_ptr(void* value, uintptr_t type) {
+    assert(card_set_type((CardSetPtr)value) == 0, "Given ptr " PTR_FORMAT " already has type bits set", p2i(value));
+    return (CardSetPtr)((uintptr_t)value | type);
+  }
+
+private:
+  // Hash table entry mapping a source region to its container.
+  class Node : public CHeapObj<mtGC> {
+    Node* volatile      _next;
+    const uint          _region_idx;
+    CardSetPtr volatile _card_set;
+
+  public:
+    Node(uint region_idx, Node* next) :
+      _next(next), _region_idx(region_idx), _card_set((CardSetPtr)CardSetInlinePtr) { }
+
+    Node* next() const                  { return _next; }
+    void set_next(Node* next)           { _next = next; }
+    uint region_idx() const             { return _region_idx; }
+    CardSetPtr card_set() const;
+    CardSetPtr volatile* card_set_addr() { return &_card_set; }
+  };
+
+  G1CardSetConfiguration* _config;
+
+  // Lazily allocated array of _config->num_buckets() hash table buckets.
+  Node** volatile _buckets;
+  // Number of source regions in this card set.
+  volatile size_t _num_regions;
+  // Memory used by the hash table and the containers, in bytes.
+  volatile size_t _mem_size;
+
+  // Replaced containers, linked through their first word.
+  CardSetPtr volatile _retired;
+
+  static volatile jint   _num_coarsenings;
+  static volatile size_t _retired_mem_size;
+
+  Node** buckets() const;
+  Node** get_or_create_buckets();
+
+  static Node* find_node(Node* from, Node* until, uint region_idx);
+  Node* get_node(uint region_idx) const;
+  Node* get_or_add_node(uint region_idx);
+
+  CardSetPtr create_array();
+  CardSetPtr create_bitmap();
+  size_t container_mem_size(CardSetPtr card_set) const;
+  void free_container(CardSetPtr card_set);
+  void retire_container(CardSetPtr card_set);
+
+  G1AddCardResult add_to_container(CardSetPtr volatile* card_set_addr, CardSetPtr card_set, uint card_in_region);
+  // Replace the given container by the next larger one, copying its cards.
+  // Returns false if another thread changed the container in the meantime.
+  bool coarsen_container(CardSetPtr volatile* card_set_addr, CardSetPtr card_set);
+
+  bool contains_in_container(CardSetPtr card_set, uint card_in_region) const;
+  size_t occupied_in_container(CardSetPtr card_set) const;
+
+public:
+  G1CardSet(G1CardSetConfiguration* config);
+  ~G1CardSet();
+
+  // Adds the given card of the given source region to the card set.
+  G1AddCardResult add_card(uint region_idx, uint card_in_region);
+
+  bool contains_card(uint region_idx, uint card_in_region) const;
+
+  // Returns the number of cards in the card set. A full container counts
+  // all cards of its source region.
+  size_t occupied() const;
+  bool occupancy_less_or_equal_to(size_t limit) const;
+  bool is_empty() const { return _num_regions == 0; }
+
+  size_t num_regions() const { return _num_regions; }
+
+  // Memory used by this card set, excluding retired containers.
+  size_t mem_size() const;
+
+  // Frees all containers. Must only be called when no other thread accesses
+  // the card set.
+  void clear();
+
+  static jint num_coarsenings() { return _num_coarsenings; }
+  // Memory held by retired containers of all card sets.
+  static size_t retired_mem_size() { return _retired_mem_size; }
+};
+
+// Iterates over all cards of a card set, one source region at a time.
+// Cards may be added concurrently, which may or may not be observed.
+class G1CardSetIterator : public StackObj {
+  const G1CardSet* _card_set;
+  G1CardSet::Node* _node;
+  uint             _bucket;
+
+  G1CardSet::CardSetPtr _container;
+  // Position of the next card to look at within the current container.
+  size_t _pos;
+  // Upper bound of _pos for the current container.
+  size_t _limit;
+
+  size_t _num_yielded[G1CardSet::CardSetFull + 1];
+
+  bool advance_node();
+  bool next_in_container(uint& card_in_region);
+
+public:
+  G1CardSetIterator(const G1CardSet* card_set);
+
+  // If there are cards left, returns true and the next card as the source
+  // region index and the card index within that region.
+  bool has_next(uint& region_idx, uint& card_in_region);
+
+  size_t num_yielded(uintptr_t container_type) const {
+    assert(container_type <= G1CardSet::CardSetFull, "invalid container type " UINTX_FORMAT, container_type);
+    return _num_yielded[container_type];
+  }
+  size_t num_yielded() const;
+};
+
+#endif // SHARE_VM_GC_G1_G1CARDSET_HPP
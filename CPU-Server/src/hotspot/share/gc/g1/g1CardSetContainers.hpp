@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1CARDSETCONTAINERS_HPP
+#define SHARE_VM_GC_G1_G1CARDSETCONTAINERS_HPP
+
+#include "gc/g1/g1CardSet.hpp"
+#include "utilities/bitMap.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Card set container encoded in the container pointer itself.
+//
+// Layout of the pointer value, from the least significant bit:
+//
+//   [ 2 bits type (CardSetInlinePtr) | 3 bits size | size * bits_per_card card indices | unused ]
+//
+// Adding a card replaces the whole value with a CAS on the address the
+// pointer has been loaded from.
+class G1CardSetInlinePtr : public StackObj {
+  typedef G1CardSet::CardSetPtr CardSetPtr;
+
+  CardSetPtr volatile* _value_addr;
+  CardSetPtr           _value;
+
+  static const uint SizeFieldPos = 2;
+  static const uint SizeFieldLen = 3;
+  static const uintptr_t SizeFieldMask = (((uintptr_t)1 << SizeFieldLen) - 1) << SizeFieldPos;
+  static const uint HeaderSize = SizeFieldPos + SizeFieldLen;
+  static const uint BitsInValue = sizeof(CardSetPtr) * BitsPerByte;
+
+  static uint card_pos_for(uint idx, uint bits_per_card) {
+    return idx * bits_per_card + HeaderSize;
+  }
+
+  static CardSetPtr merge(CardSetPtr orig_value, uint card_in_region, uint idx, uint bits_per_card);
+
+  static uint card_at(CardSetPtr value, uint idx, uint bits_per_card);
+
+  uint find(uint card_in_region, uint bits_per_card, uint start_at, uint num_cards) const;
+
+public:
+  G1CardSetInlinePtr(CardSetPtr value) : _value_addr(NULL), _value(value) {
+    assert(G1CardSet::card_set_type(_value) == G1CardSet::CardSetInlinePtr, "Value " PTR_FORMAT " is not a valid G1CardSetInlinePtr.", p2i(_value));
+  }
+
+  G1CardSetInlinePtr(CardSetPtr volatile* value_addr, CardSetPtr value) : _value_addr(value_addr), _value(value) {
+    assert(G1CardSet::card_set_type(_value) == G1CardSet::CardSetInlinePtr, "Value " PTR_FORMAT " is not a valid G1CardSetInlinePtr.", p2i(_value));
+  }
+
+  G1AddCardResult add(uint card_in_region, uint bits_per_card, uint max_cards_in_inline_ptr);
+
+  bool contains(uint card_in_region, uint bits_per_card) const;
+
+  uint card_at(uint idx, uint bits_per_card) const { return card_at(_value, idx, bits_per_card); }
+
+  uint num_cards() const { return num_cards_in(_value); }
+
+  static uint num_cards_in(CardSetPtr value) {
+    return (uint)(((uintptr_t)value & SizeFieldMask) >> SizeFieldPos);
+  }
+
+  static uint max_cards_in_inline_ptr(uint bits_per_card) {
+    return MIN2((BitsInValue - HeaderSize) / bits_per_card, (uint)(SizeFieldMask >> SizeFieldPos));
+  }
+};
+
+// Common header of the allocated card set containers.
+class G1CardSetContainer {
+  // Links retired containers of a card set.
+  G1CardSet::CardSetPtr _next_retired;
+
+public:
+  G1CardSetContainer() : _next_retired(NULL) { }
+
+  G1CardSet::CardSetPtr next_retired() const      { return _next_retired; }
+  void set_next_retired(G1CardSet::CardSetPtr next) { _next_retired = next; }
+};
+
+// Unsorted array of card indices. Lookups are lock-free, adding a card takes
+// a lock bit in the entry count so that two threads never append the same
+// card. Once the array is full it never changes again.
+class G1CardSetArray : public G1CardSetContainer {
+public:
+  typedef uint32_t EntryDataType;
+  typedef uint32_t EntryCountType;
+
+private:
+  EntryCountType          _size;
+  volatile EntryCountType _num_entries;
+  // Variable length, must be the last member.
+  EntryDataType           _data[2];
+
+  static const EntryCountType LockBitMask = (EntryCountType)1 << (sizeof(EntryCountType) * BitsPerByte - 1);
+  static const EntryCountType EntryMask = LockBitMask - 1;
+
+  class G1CardSetArrayLocker : public StackObj {
+    EntryCountType volatile* _num_entries_addr;
+    EntryCountType _local_num_entries;
+  public:
+    G1CardSetArrayLocker(EntryCountType volatile* num_entries_addr);
+
+    ~G1CardSetArrayLocker();
+
+    EntryCountType num_entries() const { return _local_num_entries; }
+    void inc_num_entries() { _local_num_entries++; }
+  };
+
+public:
+  G1CardSetArray(EntryCountType size);
+
+  G1AddCardResult add(uint card_in_region);
+
+  bool contains(uint card_in_region) const;
+
+  // Number of valid entries, i.e. entries that have been completely written.
+  EntryCountType num_entries() const;
+
+  EntryDataType at(EntryCountType idx) const {
+    assert(idx < _size, "index " UINT32_FORMAT " out of bounds " UINT32_FORMAT, idx, _size);
+    return _data[idx];
+  }
+
+  static size_t size_in_bytes(size_t num_cards) {
+    return sizeof(G1CardSetArray) + sizeof(EntryDataType) * (MAX2(num_cards, (size_t)2) - 2);
+  }
+};
+
+// Bitmap with one bit per card in the source region, followed by the bitmap
+// data. Bits are set concurrently with atomic operations.
+class G1CardSetBitMap : public G1CardSetContainer {
+  volatile size_t   _num_bits_set;
+  // Variable length, must be the last member.
+  BitMap::bm_word_t _bits[1];
+
+  BitMapView bitmap(size_t size_in_bits) const {
+    return BitMapView((BitMap::bm_word_t*)_bits, size_in_bits);
+  }
+
+public:
+  G1CardSetBitMap(size_t size_in_bits);
+
+  // Returns Overflow if the bitmap holds threshold or more cards and does not
+  // contain the card.
+  G1AddCardResult add(uint card_in_region, size_t threshold, size_t size_in_bits);
+
+  bool contains(uint card_in_region, size_t size_in_bits) const {
+    return bitmap(size_in_bits).at(card_in_region);
+  }
+
+  // Returns the index of the next card at or after the given index, or
+  // size_in_bits if there is none.
+  size_t next_card(size_t from, size_t size_in_bits) const {
+    return bitmap(size_in_bits).get_next_one_offset(from);
+  }
+
+  size_t num_bits_set() const { return _num_bits_set; }
+
+  static size_t size_in_bytes(size_t size_in_bits) {
+    return sizeof(G1CardSetBitMap) - sizeof(BitMap::bm_word_t) + BitMap::calc_size_in_bytes(size_in_bits);
+  }
+};
+
+#endif // SHARE_VM_GC_G1_G1CARDSETCONTAINERS_HPP
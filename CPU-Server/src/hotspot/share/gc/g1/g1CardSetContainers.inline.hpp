@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_G1_G1CARDSETCONTAINERS_INLINE_HPP
+#define SHARE_VM_GC_G1_G1CARDSETCONTAINERS_INLINE_HPP
+
+#include "gc/g1/g1CardSetContainers.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/spinYield.hpp"
+
+inline G1CardSet::CardSetPtr G1CardSetInlinePtr::merge(CardSetPtr orig_value, uint card_in_region, uint idx, uint bits_per_card) {
+  assert((idx & (SizeFieldMask >> SizeFieldPos)) == idx, "Index %u too large to fit into size field", idx);
+  assert(card_in_region < ((uintptr_t)1 << bits_per_card), "Card %u too large to fit into card value field", card_in_region);
+
+  uint card_pos = card_pos_for(idx, bits_per_card);
+  assert(card_pos + bits_per_card <= BitsInValue, "Putting card at pos %u with %u bits would extend beyond pointer", card_pos, bits_per_card);
+
+  // Check that we do not touch any fields we do not own.
+  uintptr_t mask = ((((uintptr_t)1 << bits_per_card) - 1) << card_pos);
+  assert(((uintptr_t)orig_value & mask) == 0, "The bits in the new range should be empty; orig_value " PTR_FORMAT " mask " PTR_FORMAT, p2i(orig_value), mask);
+
+  uintptr_t value = ((uintptr_t)(idx + 1) << SizeFieldPos) | ((uintptr_t)card_in_region << card_pos);
+  uintptr_t res = (((uintptr_t)orig_value & ~SizeFieldMask) | value);
+  return (CardSetPtr)res;
+}
+
+inline uint G1CardSetInlinePtr::card_at(CardSetPtr value, uint idx, uint bits_per_card) {
+  assert(idx < num_cards_in(value), "Index %u beyond end of inline pointer with %u cards", idx, num_cards_in(value));
+  uintptr_t const card_mask = (((uintptr_t)1 << bits_per_card) - 1);
+  return (uint)(((uintptr_t)value >> card_pos_for(idx, bits_per_card)) & card_mask);
+}
+
+inline uint G1CardSetInlinePtr::find(uint card_in_region, uint bits_per_card, uint start_at, uint num_cards) const {
+  assert(start_at <= num_cards, "Start index %u beyond number of cards %u", start_at, num_cards);
+  for (uint idx = start_at; idx < num_cards; idx++) {
+    if (card_at(idx, bits_per_card) == card_in_region) {
+      return idx;
+    }
+  }
+  return num_cards;
+}
+
+inline G1AddCardResult G1CardSetInlinePtr::add(uint card_in_region, uint bits_per_card, uint max_cards_in_inline_ptr) {
+  assert(_value_addr != NULL, "No value address available, cannot add to set.");
+
+  uint cur_idx = 0;
+  while (true) {
+    uint num_cards = num_cards_in(_value);
+    // Cards are only ever appended, so the cards already looked at can be skipped.
+    cur_idx = find(card_in_region, bits_per_card, cur_idx, num_cards);
+    if (cur_idx < num_cards) {
+      return Found;
+    }
+    if (num_cards >= max_cards_in_inline_ptr) {
+      return Overflow;
+    }
+    CardSetPtr new_value = merge(_value, card_in_region, num_cards, bits_per_card);
+    CardSetPtr old_value = Atomic::cmpxchg(new_value, _value_addr, _value);
+    if (_value == old_value) {
+      return Added;
+    }
+    // Update values and retry.
+    _value = old_value;
+    // The value of the pointer may have changed to something different than
+    // an inline card set. Let the caller look at the new container then
+    // instead of overwriting it.
+    if (G1CardSet::card_set_type(_value) != G1CardSet::CardSetInlinePtr) {
+      return Overflow;
+    }
+  }
+}
+
+inline bool G1CardSetInlinePtr::contains(uint card_in_region, uint bits_per_card) const {
+  uint num_cards = num_cards_in(_value);
+  return find(card_in_region, bits_per_card, 0, num_cards) < num_cards;
+}
+
+inline G1CardSetArray::G1CardSetArray(EntryCountType size) :
+  G1CardSetContainer(),
+  _size(size),
+  _num_entries(0) {
+  assert(size > 0, "Array must hold at least one card");
+}
+
+inline G1CardSetArray::G1CardSetArrayLocker::G1CardSetArrayLocker(EntryCountType volatile* num_entries_addr) :
+  _num_entries_addr(num_entries_addr) {
+  SpinYield s;
+  EntryCountType num_entries = *_num_entries_addr & EntryMask;
+  while (true) {
+    EntryCountType old_value = Atomic::cmpxchg((EntryCountType)(num_entries | LockBitMask),
+                                               _num_entries_addr,
+                                               num_entries);
+    if (old_value == num_entries) {
+      // Succeeded locking the array.
+      _local_num_entries = num_entries;
+      break;
+    }
+    // Failed. Retry with the number of entries last seen, without the lock bit.
+    num_entries = old_value & EntryMask;
+    s.wait();
+  }
+}
+
+inline G1CardSetArray::G1CardSetArrayLocker::~G1CardSetArrayLocker() {
+  // Publishes the new entries and releases the lock.
+  OrderAccess::release_store(_num_entries_addr, _local_num_entries);
+}
+
+inline G1CardSetArray::EntryCountType G1CardSetArray::num_entries() const {
+  return OrderAccess::load_acquire(&_num_entries) & EntryMask;
+}
+
+inline G1AddCardResult G1CardSetArray::add(uint card_in_region) {
+  assert(card_in_region < ((uint64_t)1 << (sizeof(EntryDataType) * BitsPerByte)),
+         "Card index %u does not fit card element.", card_in_region);
+  EntryCountType num_entries = this->num_entries();
+  EntryCountType idx = 0;
+  for (; idx < num_entries; idx++) {
+    if (_data[idx] == card_in_region) {
+      return Found;
+    }
+  }
+
+  // Since we did not find the card, lock.
+  G1CardSetArrayLocker x(&_num_entries);
+
+  // Reload number of entries from the locker as it might have changed while
+  // waiting for the lock, and look at the cards added in the meantime.
+  num_entries = x.num_entries();
+  for (; idx < num_entries; idx++) {
+    if (_data[idx] == card_in_region) {
+      return Found;
+    }
+  }
+
+  // Check if there is space left.
+  if (num_entries == _size) {
+    return Overflow;
+  }
+
+  _data[num_entries] = card_in_region;
+  x.inc_num_entries();
+
+  return Added;
+}
+
+inline bool G1CardSetArray::contains(uint card_in_region) const {
+  EntryCountType num_entries = this->num_entries();
+  for (EntryCountType idx = 0; idx < num_entries; idx++) {
+    if (_data[idx] == card_in_region) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline G1CardSetBitMap::G1CardSetBitMap(size_t size_in_bits) :
+  G1CardSetContainer(),
+  _num_bits_set(0) {
+  memset((void*)_bits, 0, BitMap::calc_size_in_bytes(size_in_bits));
+}
+
+inline G1AddCardResult G1CardSetBitMap::add(uint card_in_region, size_t threshold, size_t size_in_bits) {
+  BitMapView bm = bitmap(size_in_bits);
+  if (_num_bits_set >= threshold) {
+    return bm.at(card_in_region) ? Found : Overflow;
+  }
+  if (bm.par_set_bit(card_in_region)) {
+    Atomic::inc(&_num_bits_set);
+    return Added;
+  }
+  return Found;
+}
+
+#endif // SHARE_VM_GC_G1_G1CARDSETCONTAINERS_INLINE_HPP
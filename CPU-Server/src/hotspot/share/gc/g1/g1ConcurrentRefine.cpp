@@ -23,12 +23,16 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/g1/g1Analytics.hpp"
 #include "gc/g1/g1BarrierSet.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
 #include "gc/g1/g1ConcurrentRefineThread.hpp"
+#include "gc/g1/g1Policy.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -128,6 +132,18 @@ void G1ConcurrentRefineThreadControl::worker_threads_do(ThreadClosure* tc) {
   }
 }
 
+void G1ConcurrentRefineThreadControl::refinement_stats(jlong* refinement_time_ns,
+                                                       size_t* refined_buffers) const {
+  *refinement_time_ns = 0;
+  *refined_buffers = 0;
+  for (uint i = 0; i < _num_max_threads; i++) {
+    if (_threads[i] != NULL) {
+      *refinement_time_ns += _threads[i]->refinement_time_ns();
+      *refined_buffers += _threads[i]->refined_buffers();
+    }
+  }
+}
+
 void G1ConcurrentRefineThreadControl::stop() {
   for (uint i = 0; i < _num_max_threads; i++) {
     if (_threads[i] != NULL) {
@@ -222,7 +238,15 @@ G1ConcurrentRefine::G1ConcurrentRefine(size_t green_zone,
   _green_zone(green_zone),
   _yellow_zone(yellow_zone),
   _red_zone(red_zone),
-  _min_yellow_zone_size(min_yellow_zone_size)
+  _min_yellow_zone_size(min_yellow_zone_size),
+  _threads_wanted(0),
+  _use_threads_wanted(false),
+  _last_adjust_ms(0.0),
+  _wake_primary_on_next_buffer(false),
+  _refinement_time_ns_at_gc(0),
+  _refined_buffers_at_gc(0),
+  _mutator_refined_buffers_at_gc(0),
+  _pending_buffers_at_gc(0)
 {
   assert_zone_constraints_gyr(green_zone, yellow_zone, red_zone);
 }
@@ -320,23 +344,14 @@ void G1ConcurrentRefine::print_threads_on(outputStream* st) const {
   _thread_control.print_on(st);
 }
 
-static size_t calc_new_green_zone(size_t green,
-                                  double update_rs_time,
-                                  size_t update_rs_processed_buffers,
-                                  double goal_ms) {
-  // Adjust green zone based on whether we're meeting the time goal.
-  // Limit to max_green_zone.
-  const double inc_k = 1.1, dec_k = 0.9;
-  if (update_rs_time > goal_ms) {
-    if (green > 0) {
-      green = static_cast<size_t>(green * dec_k);
-    }
-  } else if (update_rs_time < goal_ms &&
-             update_rs_processed_buffers > green) {
-    green = static_cast<size_t>(MAX2(green * inc_k, green + 1.0));
-    green = MIN2(green, max_green_zone);
+static size_t calc_new_green_zone(double cost_per_card_ms, double goal_ms) {
+  // The green zone is the number of buffers the next pause is predicted to
+  // process within the time goal. Limit to max_green_zone.
+  if (cost_per_card_ms <= 0.0) {
+    return max_green_zone;
   }
-  return green;
+  double buffers = goal_ms / cost_per_card_ms / G1UpdateBufferSize;
+  return static_cast<size_t>(MIN2(buffers, static_cast<double>(max_green_zone)));
 }
 
 static size_t calc_new_yellow_zone(size_t green, size_t min_yellow_size) {
@@ -352,18 +367,18 @@ static size_t calc_new_red_zone(size_t green, size_t yellow) {
 void G1ConcurrentRefine::update_zones(double update_rs_time,
                                       size_t update_rs_processed_buffers,
                                       double goal_ms) {
+  double cost_per_card_ms = G1CollectedHeap::heap()->g1_policy()->analytics()->predict_cost_per_card_ms();
   log_trace( CTRL_TAGS )("Updating Refinement Zones: "
                          "update_rs time: %.3fms, "
                          "update_rs buffers: " SIZE_FORMAT ", "
-                         "update_rs goal time: %.3fms",
+                         "update_rs goal time: %.3fms, "
+                         "predicted cost per card: %.5fms",
                          update_rs_time,
                          update_rs_processed_buffers,
-                         goal_ms);
+                         goal_ms,
+                         cost_per_card_ms);
 
-  _green_zone = calc_new_green_zone(_green_zone,
-                                    update_rs_time,
-                                    update_rs_processed_buffers,
-                                    goal_ms);
+  _green_zone = calc_new_green_zone(cost_per_card_ms, goal_ms);
   _yellow_zone = calc_new_yellow_zone(_green_zone, _min_yellow_zone_size);
   _red_zone = calc_new_red_zone(_green_zone, _yellow_zone);
 
@@ -383,6 +398,18 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
   if (G1UseAdaptiveConcRefinement) {
     update_zones(update_rs_time, update_rs_processed_buffers, goal_ms);
 
+    // Remember where the following mutator phase starts.
+    _thread_control.refinement_stats(&_refinement_time_ns_at_gc, &_refined_buffers_at_gc);
+    _mutator_refined_buffers_at_gc = dcqs.processed_buffers_mut();
+    _pending_buffers_at_gc = dcqs.completed_buffers_num();
+
+    G1Policy* policy = G1CollectedHeap::heap()->g1_policy();
+    _use_threads_wanted = policy->analytics()->has_concurrent_refine_rates();
+    _last_adjust_ms = os::elapsedTime() * MILLIUNITS;
+    if (_use_threads_wanted) {
+      update_threads_wanted(policy, "pause");
+    }
+
     // Change the barrier params
     if (max_num_threads() == 0) {
       // Disable dcqs notification when there are no threads to notify.
@@ -390,7 +417,7 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
     } else {
       // Worker 0 is the primary; wakeup is via dcqs notification.
       STATIC_ASSERT(max_yellow_zone <= INT_MAX);
-      size_t activate = activation_threshold(0);
+      size_t activate = primary_activation_threshold();
       dcqs.set_process_completed_buffers_threshold(activate);
     }
     dcqs.set_max_completed_buffers(red_zone());
@@ -406,12 +433,145 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
   dcqs.notify_if_necessary();
 }
 
+void G1ConcurrentRefine::mutator_phase_rates(size_t pending_cards_at_gc_start,
+                                             double mutator_time_ms,
+                                             double* refine_rate_ms,
+                                             double* dirtied_cards_rate_ms) {
+  DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
+  jlong refinement_time_ns;
+  size_t refined_buffers;
+  _thread_control.refinement_stats(&refinement_time_ns, &refined_buffers);
+  refinement_time_ns -= _refinement_time_ns_at_gc;
+  refined_buffers -= _refined_buffers_at_gc;
+  size_t mutator_refined_buffers = dcqs.processed_buffers_mut() - _mutator_refined_buffers_at_gc;
+
+  *refine_rate_ms = -1.0;
+  if (refined_buffers > 0 && refinement_time_ns > 0) {
+    *refine_rate_ms = (double)(refined_buffers * G1UpdateBufferSize) /
+                      ((double)refinement_time_ns / NANOSECS_PER_MILLISEC);
+  }
+
+  // Every card that was pending at the start of the pause was either
+  // pending at the end of the previous pause, or dirtied in between.
+  size_t refined_cards = (refined_buffers + mutator_refined_buffers) * G1UpdateBufferSize;
+  size_t pending_cards_at_gc_end = _pending_buffers_at_gc * G1UpdateBufferSize;
+  size_t dirtied_cards = pending_cards_at_gc_start + refined_cards;
+  dirtied_cards -= MIN2(dirtied_cards, pending_cards_at_gc_end);
+  *dirtied_cards_rate_ms = -1.0;
+  if (mutator_time_ms > 0.0) {
+    *dirtied_cards_rate_ms = dirtied_cards / mutator_time_ms;
+  }
+
+  log_debug(gc, refine)("Mutator phase: %.2fms, dirtied cards: " SIZE_FORMAT ", "
+                        "concurrently refined cards: " SIZE_FORMAT " in %.2fms, "
+                        "mutator refined cards: " SIZE_FORMAT,
+                        mutator_time_ms, dirtied_cards,
+                        refined_buffers * G1UpdateBufferSize,
+                        (double)refinement_time_ns / NANOSECS_PER_MILLISEC,
+                        mutator_refined_buffers * G1UpdateBufferSize);
+}
+
+void G1ConcurrentRefine::update_threads_wanted(G1Policy* policy, const char* reason) {
+  DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
+  const G1Analytics* analytics = policy->analytics();
+
+  size_t pending_cards = dcqs.completed_buffers_num() * G1UpdateBufferSize;
+  size_t target_cards = _green_zone * G1UpdateBufferSize;
+  double time_to_gc_ms = policy->predict_time_to_next_gc_ms();
+  double dirtied_rate_ms = analytics->predict_dirtied_cards_rate_ms();
+  double refine_rate_ms = analytics->predict_concurrent_refine_rate_ms();
+
+  // The cards pending at the next pause if no thread refines until then,
+  // in excess of what the pause can process within its time goal.
+  double excess_cards = pending_cards + dirtied_rate_ms * time_to_gc_ms - target_cards;
+  uint wanted = 0;
+  if (excess_cards > 0.0) {
+    // Threads can refine at least until the next re-evaluation, even if
+    // the pause is predicted to happen earlier.
+    double refine_time_ms = MAX2(time_to_gc_ms, (double)AdjustThreadsPeriodMs);
+    double cards_per_thread = refine_rate_ms * refine_time_ms;
+    if (cards_per_thread > 0.0) {
+      wanted = static_cast<uint>(MIN2(ceil(excess_cards / cards_per_thread), (double)max_num_threads()));
+    } else {
+      wanted = max_num_threads();
+    }
+  }
+
+  uint old_wanted = _threads_wanted;
+  _threads_wanted = wanted;
+
+  // Changes are logged at debug level, the periodic re-evaluations otherwise
+  // only at trace level.
+  LogLevelType level = (wanted != old_wanted) ? LogLevel::Debug : LogLevel::Trace;
+  Log(gc, refine) log;
+  if (log.is_level(level)) {
+    log.write(level,
+              "Refinement threads wanted (%s): %u (was %u), "
+              "pending cards: " SIZE_FORMAT ", target cards: " SIZE_FORMAT ", "
+              "predicted time to next GC: %.2fms, "
+              "predicted dirtied cards rate: %.2f/ms, "
+              "predicted refinement rate: %.2f/ms per thread",
+              reason, wanted, old_wanted,
+              pending_cards, target_cards,
+              time_to_gc_ms, dirtied_rate_ms, refine_rate_ms);
+  }
+
+  if (max_num_threads() > 0) {
+    // Wake up the primary thread if it is wanted now.
+    dcqs.set_process_completed_buffers_threshold(primary_activation_threshold());
+    dcqs.notify_if_necessary();
+  }
+}
+
+void G1ConcurrentRefine::adjust_threads_periodically() {
+  bool woken_by_buffer = _wake_primary_on_next_buffer;
+  if (woken_by_buffer) {
+    // Back to the regular notification threshold.
+    _wake_primary_on_next_buffer = false;
+    G1BarrierSet::dirty_card_queue_set().set_process_completed_buffers_threshold(activation_threshold(0));
+  }
+  if (!_use_threads_wanted) {
+    return;
+  }
+  double now_ms = os::elapsedTime() * MILLIUNITS;
+  if (!woken_by_buffer && (now_ms - _last_adjust_ms < AdjustThreadsPeriodMs)) {
+    return;
+  }
+  _last_adjust_ms = now_ms;
+  update_threads_wanted(G1CollectedHeap::heap()->g1_policy(), "periodic");
+}
+
+bool G1ConcurrentRefine::needs_periodic_adjustment() const {
+  return _use_threads_wanted && G1BarrierSet::dirty_card_queue_set().completed_buffers_num() > 0;
+}
+
+void G1ConcurrentRefine::wake_primary_on_next_buffer() {
+  assert_lock_strong(DirtyCardQ_CBL_mon);
+  if (_wake_primary_on_next_buffer) {
+    return;
+  }
+  _wake_primary_on_next_buffer = true;
+  G1BarrierSet::dirty_card_queue_set().set_process_completed_buffers_threshold(0);
+}
+
+size_t G1ConcurrentRefine::primary_activation_threshold() const {
+  return _wake_primary_on_next_buffer ? 0 : activation_threshold(0);
+}
+
 size_t G1ConcurrentRefine::activation_threshold(uint worker_id) const {
+  if (_use_threads_wanted) {
+    // Wanted threads refine down to the green zone, the others only help
+    // in the yellow zone.
+    return worker_id < _threads_wanted ? _green_zone : _yellow_zone;
+  }
   Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
   return activation_level(thresholds);
 }
 
 size_t G1ConcurrentRefine::deactivation_threshold(uint worker_id) const {
+  if (_use_threads_wanted) {
+    return worker_id < _threads_wanted ? _green_zone : _yellow_zone;
+  }
   Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
   return deactivation_level(thresholds);
 }
@@ -429,6 +589,10 @@ void G1ConcurrentRefine::maybe_activate_more_threads(uint worker_id, size_t num_
 bool G1ConcurrentRefine::do_refinement_step(uint worker_id) {
   DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
 
+  if (worker_id == 0) {
+    adjust_threads_periodically();
+  }
+
   size_t curr_buffer_num = dcqs.completed_buffers_num();
   // If the number of the buffers falls down into the yellow zone,
   // that means that the transition period after the evacuation pause has ended.
@@ -32,6 +32,7 @@
 class CardTableEntryClosure;
 class G1ConcurrentRefine;
 class G1ConcurrentRefineThread;
+class G1Policy;
 class outputStream;
 class ThreadClosure;
 
@@ -59,6 +60,9 @@ public:
   void print_on(outputStream* st) const;
   void worker_threads_do(ThreadClosure* tc);
   void stop();
+
+  // Sum of the refinement statistics of all threads.
+  void refinement_stats(jlong* refinement_time_ns, size_t* refined_buffers) const;
 };
 
 // Controls refinement threads and their activation based on the number of completed
@@ -86,12 +90,35 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
    *    machinery during a collection.
    * 2) green = 0. Means no caching. Can be a good way to minimize the
    *    amount of time spent updating remembered sets during a collection.
+   *
+   * With G1UseAdaptiveConcRefinement, the green zone is the number of buffers
+   * the next pause is predicted to process within its Update RS time goal.
+   * Once the rates of card dirtying and refinement are known, the number of
+   * active threads is chosen so that the number of completed buffers is
+   * predicted to be back at the green zone when the next pause starts.
+   * Threads beyond that number only run in the yellow zone.
    */
   size_t _green_zone;
   size_t _yellow_zone;
   size_t _red_zone;
   size_t _min_yellow_zone_size;
 
+  // Number of threads needed to reach the green zone at the next pause,
+  // and whether it is based on predictions at all.
+  volatile uint _threads_wanted;
+  volatile bool _use_threads_wanted;
+  double _last_adjust_ms;
+  // Whether the primary thread is blocked without periodic re-evaluation,
+  // and must be woken up by the next completed buffer.
+  volatile bool _wake_primary_on_next_buffer;
+
+  // Statistics at the end of the last pause, to compute the rates of the
+  // following mutator phase.
+  jlong  _refinement_time_ns_at_gc;
+  size_t _refined_buffers_at_gc;
+  size_t _mutator_refined_buffers_at_gc;
+  size_t _pending_buffers_at_gc;
+
   G1ConcurrentRefine(size_t green_zone,
                      size_t yellow_zone,
                      size_t red_zone,
@@ -105,8 +132,18 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_buffers);
 
+  // Predict the number of threads needed to bring the completed buffers
+  // down to the green zone until the next pause.
+  void update_threads_wanted(G1Policy* policy, const char* reason);
+
+  // Number of completed buffers that wakes up the primary thread.
+  size_t primary_activation_threshold() const;
+
   jint initialize();
 public:
+  // Period of the re-evaluation of the number of threads needed.
+  static const uint AdjustThreadsPeriodMs = 50;
+
   ~G1ConcurrentRefine();
 
   // Returns a G1ConcurrentRefine instance if succeeded to create/initialize the
@@ -115,9 +152,31 @@ public:
 
   void stop();
 
+  // Compute the rates of the mutator phase that ended with the current pause,
+  // given the pending cards at the start of the pause: cards refined per ms by
+  // a single refinement thread, and cards dirtied per ms by the mutators.
+  // Rates that could not be measured are negative.
+  void mutator_phase_rates(size_t pending_cards_at_gc_start,
+                           double mutator_time_ms,
+                           double* refine_rate_ms,
+                           double* dirtied_cards_rate_ms);
+
   // Adjust refinement thresholds based on work done during the pause and the goal time.
   void adjust(double update_rs_time, size_t update_rs_processed_buffers, double goal_ms);
 
+  // Re-evaluate the number of threads needed between pauses. Called by the
+  // primary refinement thread.
+  void adjust_threads_periodically();
+
+  // Whether the primary thread needs to wake up periodically to re-evaluate
+  // the number of threads needed. That is only the case while cards are
+  // queued; an idle VM does not need any refinement threads.
+  bool needs_periodic_adjustment() const;
+
+  // Called by the primary thread before it blocks without a timeout. The
+  // next completed buffer wakes it up to resume the periodic re-evaluation.
+  void wake_primary_on_next_buffer();
+
   size_t activation_threshold(uint worker_id) const;
   size_t deactivation_threshold(uint worker_id) const;
   // Perform a single refinement step. Called by the refinement threads when woken up.
@@ -37,6 +37,8 @@ G1ConcurrentRefineThread::G1ConcurrentRefineThread(G1ConcurrentRefine* cr, uint
   _vtime_start(0.0),
   _vtime_accum(0.0),
   _worker_id(worker_id),
+  _refinement_time_ns(0),
+  _refined_buffers(0),
   _active(false),
   _monitor(NULL),
   _cr(cr)
@@ -60,6 +62,17 @@ G1ConcurrentRefineThread::G1ConcurrentRefineThread(G1ConcurrentRefine* cr, uint
 void G1ConcurrentRefineThread::wait_for_completed_buffers() {
   MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
   while (!should_terminate() && !is_active()) {
+    if (is_primary() && G1UseAdaptiveConcRefinement) {
+      if (_cr->needs_periodic_adjustment()) {
+        // Wake up regularly to let the primary thread re-evaluate the number
+        // of threads needed while cards are queued, even if mutators do not
+        // notify it.
+        _monitor->wait(Mutex::_no_safepoint_check_flag, G1ConcurrentRefine::AdjustThreadsPeriodMs);
+        return;
+      }
+      // Nothing is queued: block until the next completed buffer.
+      _cr->wake_primary_on_next_buffer();
+    }
     _monitor->wait(Mutex::_no_safepoint_check_flag);
   }
 }
@@ -100,6 +113,14 @@ void G1ConcurrentRefineThread::run_service() {
       break;
     }
 
+    if (is_primary()) {
+      SuspendibleThreadSetJoiner sts_join;
+      _cr->adjust_threads_periodically();
+    }
+    if (!is_active()) {
+      continue;
+    }
+
     size_t buffers_processed = 0;
     log_debug(gc, refine)("Activated worker %d, on threshold: " SIZE_FORMAT ", current: " SIZE_FORMAT,
                           _worker_id, _cr->activation_threshold(_worker_id),
@@ -114,9 +135,12 @@ void G1ConcurrentRefineThread::run_service() {
           continue;             // Re-check for termination after yield delay.
         }
 
+        jlong step_start = os::javaTimeNanos();
         if (!_cr->do_refinement_step(_worker_id)) {
           break;
         }
+        _refinement_time_ns += os::javaTimeNanos() - step_start;
+        _refined_buffers++;
         ++buffers_processed;
       }
     }
@@ -42,6 +42,10 @@ class G1ConcurrentRefineThread: public ConcurrentGCThread {
   double _vtime_accum;  // Accumulated virtual time.
   uint _worker_id;
 
+  // Refinement work done so far, used to predict the refinement rate.
+  jlong  _refinement_time_ns;
+  size_t _refined_buffers;
+
   bool _active;
   Monitor* _monitor;
   G1ConcurrentRefine* _cr;
@@ -65,6 +69,9 @@ public:
 
   // Total virtual time so far.
   double vtime_accum() { return _vtime_accum; }
+
+  jlong refinement_time_ns() const { return _refinement_time_ns; }
+  size_t refined_buffers() const   { return _refined_buffers; }
 };
 
 #endif // SHARE_VM_GC_G1_G1CONCURRENTREFINETHREAD_HPP
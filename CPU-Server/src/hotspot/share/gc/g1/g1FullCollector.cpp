@@ -43,6 +43,7 @@
 #include "gc/shared/weakProcessor.inline.hpp"
 #include "gc/shared/workerPolicy.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
 #include "utilities/debug.hpp"
@@ -103,10 +104,25 @@ uint G1FullCollector::calc_active_workers() {
   return worker_count;
 }
 
+uint G1FullCollector::calc_compaction_chain_length(uint num_workers) {
+  G1CollectedHeap* heap = G1CollectedHeap::heap();
+  // Like every worker, every compaction chain will in average leave half a
+  // region unused. Consider G1HeapWastePercent to decide the max number of
+  // chains, but use at least one chain per worker.
+  uint max_wasted_regions_allowed = ((heap->num_regions() * G1HeapWastePercent) / 100);
+  uint max_chain_count = MAX2(max_wasted_regions_allowed * 2, num_workers);
+  uint chain_length = MAX2(heap->num_regions() / max_chain_count, 1u);
+  log_debug(gc, task)("Using compaction chains of up to %u regions", chain_length);
+
+  return chain_length;
+}
+
 G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool clear_soft_refs) :
     _heap(heap),
     _scope(heap->g1mm(), explicit_gc, clear_soft_refs),
     _num_workers(calc_active_workers()),
+    _num_compaction_chains(0),
+    _compaction_chain_length(calc_compaction_chain_length(_num_workers)),
     _oop_queue_set(_num_workers),
     _array_queue_set(_num_workers),
     _preserved_marks_set(true),
@@ -119,10 +135,19 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool c
 
   _preserved_marks_set.init(_num_workers);
   _markers = NEW_C_HEAP_ARRAY(G1FullGCMarker*, _num_workers, mtGC);
-  _compaction_points = NEW_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _num_workers, mtGC);
+
+  uint max_regions = _heap->max_regions();
+  _live_stats = NEW_C_HEAP_ARRAY(G1RegionMarkStats, max_regions, mtGC);
+  _skip_compacting = NEW_C_HEAP_ARRAY(bool, max_regions, mtGC);
+  // Every chain holds at least one region.
+  _compaction_chains = NEW_C_HEAP_ARRAY(G1FullGCCompactionPoint*, max_regions, mtGC);
+  for (uint j = 0; j < max_regions; j++) {
+    _live_stats[j].clear();
+    _skip_compacting[j] = false;
+  }
+
   for (uint i = 0; i < _num_workers; i++) {
-    _markers[i] = new G1FullGCMarker(i, _preserved_marks_set.get(i), mark_bitmap());
-    _compaction_points[i] = new G1FullGCCompactionPoint();
+    _markers[i] = new G1FullGCMarker(i, _preserved_marks_set.get(i), mark_bitmap(), _live_stats);
     _oop_queue_set.register_queue(i, marker(i)->oop_stack());
     _array_queue_set.register_queue(i, marker(i)->objarray_stack());
   }
@@ -131,10 +156,22 @@ G1FullCollector::G1FullCollector(G1CollectedHeap* heap, bool explicit_gc, bool c
 G1FullCollector::~G1FullCollector() {
   for (uint i = 0; i < _num_workers; i++) {
     delete _markers[i];
-    delete _compaction_points[i];
+  }
+  for (uint i = 0; i < _num_compaction_chains; i++) {
+    delete _compaction_chains[i];
   }
   FREE_C_HEAP_ARRAY(G1FullGCMarker*, _markers);
-  FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _compaction_points);
+  FREE_C_HEAP_ARRAY(G1RegionMarkStats, _live_stats);
+  FREE_C_HEAP_ARRAY(bool, _skip_compacting);
+  FREE_C_HEAP_ARRAY(G1FullGCCompactionPoint*, _compaction_chains);
+}
+
+G1FullGCCompactionPoint* G1FullCollector::new_compaction_chain() {
+  uint index = Atomic::add(1u, &_num_compaction_chains) - 1;
+  assert(index < _heap->max_regions(), "more compaction chains than regions");
+  G1FullGCCompactionPoint* chain = new G1FullGCCompactionPoint();
+  _compaction_chains[index] = chain;
+  return chain;
 }
 
 void G1FullCollector::prepare_collection() {
@@ -212,6 +249,11 @@ void G1FullCollector::phase1_mark_live_objects() {
   G1FullGCReferenceProcessingExecutor reference_processing(this);
   reference_processing.execute(scope()->timer(), scope()->tracer());
 
+  // Marking is done, publish the live words of every region.
+  for (uint i = 0; i < _num_workers; i++) {
+    marker(i)->flush_mark_stats_cache();
+  }
+
   // Weak oops cleanup.
   {
     GCTraceTime(Debug, gc, phases) debug("Phase 1: Weak Processing", scope()->timer());
@@ -237,6 +279,8 @@ void G1FullCollector::phase2_prepare_compaction() {
   GCTraceTime(Info, gc, phases) info("Phase 2: Prepare for compaction", scope()->timer());
   G1FullGCPrepareTask task(this);
   run_task(&task);
+  log_debug(gc, phases)("Prepared %u compaction chains, skipped compaction of %u regions",
+                        num_compaction_chains(), task.skipped_regions());
 
   // To avoid OOM when there is memory left.
   if (!task.has_freed_regions()) {
@@ -29,6 +29,7 @@
 #include "gc/g1/g1FullGCMarker.hpp"
 #include "gc/g1/g1FullGCOopClosures.hpp"
 #include "gc/g1/g1FullGCScope.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.hpp"
 #include "gc/shared/preservedMarks.hpp"
 #include "gc/shared/referenceProcessor.hpp"
 #include "gc/shared/taskqueue.hpp"
@@ -58,7 +59,14 @@ class G1FullCollector : StackObj {
   G1FullGCScope             _scope;
   uint                      _num_workers;
   G1FullGCMarker**          _markers;
-  G1FullGCCompactionPoint** _compaction_points;
+  G1RegionMarkStats*        _live_stats;
+  bool*                     _skip_compacting;
+  // Compaction chains created during prepare. Each chain is a queue of
+  // regions compacted into each other in order, independent of all other
+  // chains, so that workers can claim them dynamically during compaction.
+  G1FullGCCompactionPoint** _compaction_chains;
+  volatile uint             _num_compaction_chains;
+  uint                      _compaction_chain_length;
   OopQueueSet               _oop_queue_set;
   ObjArrayTaskQueueSet      _array_queue_set;
   PreservedMarksSet         _preserved_marks_set;
@@ -67,6 +75,7 @@ class G1FullCollector : StackObj {
   ReferenceProcessorIsAliveMutator _is_alive_mutator;
 
   static uint calc_active_workers();
+  static uint calc_compaction_chain_length(uint num_workers);
 
   G1FullGCSubjectToDiscoveryClosure _always_subject_to_discovery;
   ReferenceProcessorSubjectToDiscoveryMutator _is_subject_mutator;
@@ -82,12 +91,18 @@ public:
   G1FullGCScope*           scope() { return &_scope; }
   uint                     workers() { return _num_workers; }
   G1FullGCMarker*          marker(uint id) { return _markers[id]; }
-  G1FullGCCompactionPoint* compaction_point(uint id) { return _compaction_points[id]; }
+  G1FullGCCompactionPoint* compaction_chain(uint id) { return _compaction_chains[id]; }
+  uint                     num_compaction_chains() { return _num_compaction_chains; }
+  uint                     compaction_chain_length() { return _compaction_chain_length; }
+  G1FullGCCompactionPoint* new_compaction_chain();
   OopQueueSet*             oop_queue_set() { return &_oop_queue_set; }
   ObjArrayTaskQueueSet*    array_queue_set() { return &_array_queue_set; }
   PreservedMarksSet*       preserved_mark_set() { return &_preserved_marks_set; }
   G1FullGCCompactionPoint* serial_compaction_point() { return &_serial_compaction_point; }
   G1CMBitMap*              mark_bitmap();
+  size_t                   live_words(uint region_idx) { return _live_stats[region_idx]._live_words; }
+  bool                     is_skip_compacting(uint region_idx) { return _skip_compacting[region_idx]; }
+  void                     set_skip_compacting(uint region_idx) { _skip_compacting[region_idx] = true; }
   ReferenceProcessor*      reference_processor();
 
 private:
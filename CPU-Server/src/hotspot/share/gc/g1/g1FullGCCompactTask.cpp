@@ -32,17 +32,49 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/ticks.hpp"
 
-class G1ResetHumongousClosure : public HeapRegionClosure {
+class G1ResetRegionsClosure : public HeapRegionClosure {
+  G1FullCollector* _collector;
   G1CMBitMap* _bitmap;
 
+  // Regions skipped for compaction keep their live objects in place. Fill
+  // the dead space in between to keep the region parsable, and rebuild the
+  // block offset table for the new blocks.
+  void fill_skip_compacting_region(HeapRegion* hr) {
+    HeapWord* limit = hr->top();
+    HeapWord* next_addr = hr->bottom();
+    hr->reset_bot();
+    HeapWord* threshold = hr->initialize_threshold();
+    while (next_addr < limit) {
+      HeapWord* block_end;
+      if (_bitmap->is_marked(next_addr)) {
+        block_end = next_addr + oop(next_addr)->size();
+      } else {
+        block_end = _bitmap->get_next_marked_addr(next_addr, limit);
+        CollectedHeap::fill_with_object(next_addr, pointer_delta(block_end, next_addr));
+      }
+      if (block_end > threshold) {
+        threshold = hr->cross_threshold(next_addr, block_end);
+      }
+      next_addr = block_end;
+    }
+    assert(next_addr == limit, "Should stop the scan at the limit.");
+
+    _bitmap->clear_region(hr);
+    hr->complete_compaction();
+  }
+
 public:
-  G1ResetHumongousClosure(G1CMBitMap* bitmap) :
-      _bitmap(bitmap) { }
+  G1ResetRegionsClosure(G1FullCollector* collector) :
+      _collector(collector),
+      _bitmap(collector->mark_bitmap()) { }
 
   bool do_heap_region(HeapRegion* current) {
-    if (current->is_humongous()) {
+    if (_collector->is_skip_compacting(current->hrm_index())) {
+      fill_skip_compacting_region(current);
+    } else if (current->is_humongous()) {
       if (current->is_starts_humongous()) {
         oop obj = oop(current->bottom());
         if (_bitmap->is_marked(obj)) {
@@ -87,16 +119,29 @@ void G1FullGCCompactTask::compact_region(HeapRegion* hr) {
   hr->complete_compaction();
 }
 
+bool G1FullGCCompactTask::claim_chain(uint& chain_idx) {
+  if (_claimed_chains >= collector()->num_compaction_chains()) {
+    return false;
+  }
+  chain_idx = Atomic::add(1u, &_claimed_chains) - 1;
+  return chain_idx < collector()->num_compaction_chains();
+}
+
 void G1FullGCCompactTask::work(uint worker_id) {
   Ticks start = Ticks::now();
-  GrowableArray<HeapRegion*>* compaction_queue = collector()->compaction_point(worker_id)->regions();
-  for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
-       it != compaction_queue->end();
-       ++it) {
-    compact_region(*it);
+  // Chains are independent of each other, but the regions in a chain must
+  // be compacted in order. Claim whole chains until all are done.
+  uint chain_idx;
+  while (claim_chain(chain_idx)) {
+    GrowableArray<HeapRegion*>* compaction_queue = collector()->compaction_chain(chain_idx)->regions();
+    for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
+         it != compaction_queue->end();
+         ++it) {
+      compact_region(*it);
+    }
   }
 
-  G1ResetHumongousClosure hc(collector()->mark_bitmap());
+  G1ResetRegionsClosure hc(collector());
   G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&hc, &_claimer, worker_id);
   log_task("Compaction task", worker_id, start);
 }
@@ -38,14 +38,17 @@ class G1CMBitMap;
 class G1FullGCCompactTask : public G1FullGCTask {
 protected:
   HeapRegionClaimer _claimer;
+  volatile uint     _claimed_chains;
 
 private:
   void compact_region(HeapRegion* hr);
+  bool claim_chain(uint& chain_idx);
 
 public:
   G1FullGCCompactTask(G1FullCollector* collector) :
     G1FullGCTask("G1 Compact Task", collector),
-    _claimer(collector->workers()) { }
+    _claimer(collector->workers()),
+    _claimed_chains(0) { }
   void work(uint worker_id);
   void serial_compaction();
 
@@ -28,7 +28,10 @@
 #include "gc/shared/referenceProcessor.hpp"
 #include "memory/iterator.inline.hpp"
 
-G1FullGCMarker::G1FullGCMarker(uint worker_id, PreservedMarks* preserved_stack, G1CMBitMap* bitmap) :
+G1FullGCMarker::G1FullGCMarker(uint worker_id,
+                               PreservedMarks* preserved_stack,
+                               G1CMBitMap* bitmap,
+                               G1RegionMarkStats* mark_stats) :
     _worker_id(worker_id),
     _bitmap(bitmap),
     _oop_stack(),
@@ -37,9 +40,11 @@ G1FullGCMarker::G1FullGCMarker(uint worker_id, PreservedMarks* preserved_stack,
     _mark_closure(worker_id, this, G1CollectedHeap::heap()->ref_processor_stw()),
     _verify_closure(VerifyOption_G1UseFullMarking),
     _stack_closure(this),
-    _cld_closure(mark_closure(), ClassLoaderData::_claim_strong) {
+    _cld_closure(mark_closure(), ClassLoaderData::_claim_strong),
+    _mark_stats_cache(mark_stats, G1CollectedHeap::heap()->max_regions(), RegionMarkStatsCacheSize) {
   _oop_stack.initialize();
   _objarray_stack.initialize();
+  _mark_stats_cache.reset();
 }
 
 G1FullGCMarker::~G1FullGCMarker() {
@@ -62,3 +67,7 @@ void G1FullGCMarker::complete_marking(OopQueueSet* oop_stacks,
     }
   } while (!is_empty() || !terminator->offer_termination());
 }
+
+void G1FullGCMarker::flush_mark_stats_cache() {
+  _mark_stats_cache.evict_all();
+}
@@ -26,9 +26,11 @@
 #define SHARE_VM_GC_G1_G1MARKSTACK_INLINE_HPP
 
 #include "gc/g1/g1Allocator.inline.hpp"
+#include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentMarkBitMap.inline.hpp"
 #include "gc/g1/g1FullGCMarker.hpp"
 #include "gc/g1/g1FullGCOopClosures.inline.hpp"
+#include "gc/g1/g1RegionMarkStatsCache.inline.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/g1StringDedupQueue.hpp"
 #include "gc/shared/preservedMarks.inline.hpp"
@@ -49,7 +51,10 @@ inline bool G1FullGCMarker::mark_object(oop obj) {
     return false;
   }
 
-  // Marked by us, preserve if needed.
+  // Marked by us, account its size to the containing region.
+  _mark_stats_cache.add_live_words(G1CollectedHeap::heap()->addr_to_region((HeapWord*)obj), obj->size());
+
+  // Preserve the mark if needed.
   markOop mark = obj->mark_raw();
   if (mark->must_be_preserved(obj) &&
       !G1ArchiveAllocator::is_open_archive_object(obj)) {
@@ -37,6 +37,7 @@
 #include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/ticks.hpp"
 
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion* hr) {
@@ -50,7 +51,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
       free_humongous_region(hr);
     }
   } else if (!hr->is_pinned()) {
-    prepare_for_compaction(hr);
+    if (should_skip_compaction(hr)) {
+      prepare_for_skip_compaction(hr);
+    } else {
+      prepare_for_compaction(hr);
+    }
   }
 
   // Reset data structures not valid after Full GC.
@@ -62,6 +67,7 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
 G1FullGCPrepareTask::G1FullGCPrepareTask(G1FullCollector* collector) :
     G1FullGCTask("G1 Prepare Compact Task", collector),
     _freed_regions(false),
+    _skipped_regions(0),
     _hrclaimer(collector->workers()) {
 }
 
@@ -75,29 +81,37 @@ bool G1FullGCPrepareTask::has_freed_regions() {
   return _freed_regions;
 }
 
+uint G1FullGCPrepareTask::skipped_regions() {
+  return _skipped_regions;
+}
+
 void G1FullGCPrepareTask::work(uint worker_id) {
   Ticks start = Ticks::now();
-  G1FullGCCompactionPoint* compaction_point = collector()->compaction_point(worker_id);
-  G1CalculatePointersClosure closure(collector()->mark_bitmap(), compaction_point);
+  G1CalculatePointersClosure closure(collector());
   G1CollectedHeap::heap()->heap_region_par_iterate_from_start(&closure, &_hrclaimer);
 
   // Update humongous region sets
   closure.update_sets();
-  compaction_point->update();
+  closure.complete_chain();
 
   // Check if any regions was freed by this worker and store in task.
   if (closure.freed_regions()) {
     set_freed_regions();
   }
+  if (closure.skipped_regions() > 0) {
+    Atomic::add(closure.skipped_regions(), &_skipped_regions);
+  }
   log_task("Prepare compaction task", worker_id, start);
 }
 
-G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1CMBitMap* bitmap,
-                                                                            G1FullGCCompactionPoint* cp) :
+G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1FullCollector* collector) :
+    _collector(collector),
     _g1h(G1CollectedHeap::heap()),
-    _bitmap(bitmap),
-    _cp(cp),
-    _humongous_regions_removed(0) { }
+    _bitmap(collector->mark_bitmap()),
+    _cp(NULL),
+    _humongous_regions_removed(0),
+    _skipped_regions(0),
+    _freed_chain_regions(false) { }
 
 void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(HeapRegion* hr) {
   FreeRegionList dummy_free_list("Dummy Free List for G1MarkSweep");
@@ -128,6 +142,15 @@ size_t G1FullGCPrepareTask::G1PrepareCompactLiveClosure::apply(oop object) {
   return size;
 }
 
+size_t G1FullGCPrepareTask::G1SkipCompactLiveClosure::apply(oop object) {
+  // The object stays in place. Clear a mark word that would make it look
+  // forwarded, it will be restored from the preserved marks.
+  if (object->forwardee() != NULL) {
+    object->init_mark_raw();
+  }
+  return object->size();
+}
+
 size_t G1FullGCPrepareTask::G1RePrepareClosure::apply(oop obj) {
   // We only re-prepare objects forwarded within the current region, so
   // skip objects that are already forwarded to another region.
@@ -151,6 +174,9 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction_wor
 }
 
 void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(HeapRegion* hr) {
+  if (_cp == NULL) {
+    _cp = _collector->new_compaction_chain();
+  }
   if (!_cp->is_initialized()) {
     hr->set_compaction_top(hr->bottom());
     _cp->initialize(hr, true);
@@ -158,6 +184,42 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   // Add region to the compaction queue and prepare it.
   _cp->add(hr);
   prepare_for_compaction_work(_cp, hr);
+
+  // Start a new chain once the current one is long enough, so that the
+  // compaction work can be balanced between workers.
+  if ((uint)_cp->regions()->length() >= _collector->compaction_chain_length()) {
+    complete_chain();
+  }
+}
+
+void G1FullGCPrepareTask::G1CalculatePointersClosure::complete_chain() {
+  if (_cp == NULL) {
+    return;
+  }
+  _cp->update();
+  if (_cp->current_region() != _cp->regions()->last()) {
+    // The current region used for compaction is not the last in the
+    // queue. That means there is at least one free region in the queue.
+    _freed_chain_regions = true;
+  }
+  _cp = NULL;
+}
+
+bool G1FullGCPrepareTask::G1CalculatePointersClosure::should_skip_compaction(HeapRegion* hr) {
+  return _collector->live_words(hr->hrm_index()) > _collector->scope()->region_compaction_threshold();
+}
+
+void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_skip_compaction(HeapRegion* hr) {
+  // Too many live objects to make moving them worthwhile. Keep the region
+  // as is, compaction will only fill the dead space between live objects.
+  log_trace(gc, phases)("Phase 2: skip compaction region index: %u, live words: " SIZE_FORMAT,
+                        hr->hrm_index(), _collector->live_words(hr->hrm_index()));
+  _collector->set_skip_compacting(hr->hrm_index());
+  _skipped_regions++;
+
+  G1SkipCompactLiveClosure skip_compact;
+  hr->set_compaction_top(hr->top());
+  hr->apply_to_marked_objects(_bitmap, &skip_compact);
 }
 
 void G1FullGCPrepareTask::prepare_serial_compaction() {
@@ -166,8 +228,8 @@ void G1FullGCPrepareTask::prepare_serial_compaction() {
   // the parallel compaction. That means that the last region of
   // all compaction queues still have data in them. We try to compact
   // these regions in serial to avoid a premature OOM.
-  for (uint i = 0; i < collector()->workers(); i++) {
-    G1FullGCCompactionPoint* cp = collector()->compaction_point(i);
+  for (uint i = 0; i < collector()->num_compaction_chains(); i++) {
+    G1FullGCCompactionPoint* cp = collector()->compaction_chain(i);
     if (cp->has_regions()) {
       collector()->serial_compaction_point()->add(cp->remove_last());
     }
@@ -204,17 +266,6 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::freed_regions() {
     return true;
   }
 
-  if (!_cp->has_regions()) {
-    // No regions in queue, so no free ones either.
-    return false;
-  }
-
-  if (_cp->current_region() != _cp->regions()->last()) {
-    // The current region used for compaction is not the last in the
-    // queue. That means there is at least one free region in the queue.
-    return true;
-  }
-
-  // No free regions in the queue.
-  return false;
+  // Free regions at the end of any of the completed compaction chains.
+  return _freed_chain_regions;
 }
@@ -38,6 +38,7 @@ class G1CMBitMap;
 class G1FullGCPrepareTask : public G1FullGCTask {
 protected:
   volatile bool     _freed_regions;
+  volatile uint     _skipped_regions;
   HeapRegionClaimer _hrclaimer;
 
   void set_freed_regions();
@@ -47,27 +48,35 @@ public:
   void work(uint worker_id);
   void prepare_serial_compaction();
   bool has_freed_regions();
+  uint skipped_regions();
 
 protected:
   class G1CalculatePointersClosure : public HeapRegionClosure {
   protected:
+    G1FullCollector* _collector;
     G1CollectedHeap* _g1h;
     G1CMBitMap* _bitmap;
+    // The compaction chain currently filled, NULL if none.
     G1FullGCCompactionPoint* _cp;
     uint _humongous_regions_removed;
+    uint _skipped_regions;
+    bool _freed_chain_regions;
 
     virtual void prepare_for_compaction(HeapRegion* hr);
     void prepare_for_compaction_work(G1FullGCCompactionPoint* cp, HeapRegion* hr);
+    bool should_skip_compaction(HeapRegion* hr);
+    void prepare_for_skip_compaction(HeapRegion* hr);
     void free_humongous_region(HeapRegion* hr);
     void reset_region_metadata(HeapRegion* hr);
 
   public:
-    G1CalculatePointersClosure(G1CMBitMap* bitmap,
-                               G1FullGCCompactionPoint* cp);
+    G1CalculatePointersClosure(G1FullCollector* collector);
 
     void update_sets();
+    void complete_chain();
     bool do_heap_region(HeapRegion* hr);
     bool freed_regions();
+    uint skipped_regions() { return _skipped_regions; }
   };
 
   class G1PrepareCompactLiveClosure : public StackObj {
@@ -79,6 +88,12 @@ protected:
     size_t apply(oop object);
   };
 
+  class G1SkipCompactLiveClosure : public StackObj {
+  public:
+    void set_containing_obj(oop obj){}
+    size_t apply(oop object);
+  };
+
   class G1RePrepareClosure : public StackObj {
     G1FullGCCompactionPoint* _cp;
     HeapRegion* _current;
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1FullGCScope.hpp"
+#include "gc/g1/heapRegion.hpp"
 
 G1FullGCScope::G1FullGCScope(G1MonitoringSupport* monitoring_support, bool explicit_gc, bool clear_soft) :
     _rm(),
@@ -37,7 +38,13 @@ G1FullGCScope::G1FullGCScope(G1MonitoringSupport* monitoring_support, bool expli
     _cpu_time(),
     _soft_refs(clear_soft, _g1h->soft_ref_policy()),
     _monitoring_scope(monitoring_support, true /* full_gc */, true /* all_memory_pools_affected */),
-    _heap_transition(_g1h) {
+    _heap_transition(_g1h),
+    // Regions with more live words than this are not worth compacting. Always
+    // compact everything when soft references are cleared, i.e. when the
+    // collection is the last resort before running out of memory.
+    _region_compaction_threshold((MarkSweepDeadRatio > 0 && !_soft_refs.should_clear()) ?
+                                 (size_t)((100 - MarkSweepDeadRatio) * HeapRegion::GrainWords / 100) :
+                                 HeapRegion::GrainWords) {
   _timer.register_gc_start();
   _tracer.report_gc_start(_g1h->gc_cause(), _timer.gc_start());
   _g1h->pre_full_gc_dump(&_timer);
@@ -75,3 +82,7 @@ G1FullGCTracer* G1FullGCScope::tracer() {
 G1HeapTransition* G1FullGCScope::heap_transition() {
   return &_heap_transition;
 }
+
+size_t G1FullGCScope::region_compaction_threshold() {
+  return _region_compaction_threshold;
+}
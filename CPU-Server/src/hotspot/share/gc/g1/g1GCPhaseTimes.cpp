@@ -89,8 +89,8 @@ G1GCPhaseTimes::G1GCPhaseTimes(STWGCTimer* gc_timer, uint max_gc_threads) :
   _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_scanned_cards, ScanRSScannedCards);
   _scan_rs_claimed_cards = new WorkerDataArray<size_t>(max_gc_threads, "Claimed Cards:");
   _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_claimed_cards, ScanRSClaimedCards);
-  _scan_rs_skipped_cards = new WorkerDataArray<size_t>(max_gc_threads, "Skipped Cards:");
-  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_skipped_cards, ScanRSSkippedCards);
+  _scan_rs_empty_cards = new WorkerDataArray<size_t>(max_gc_threads, "Empty Cards:");
+  _gc_par_phases[ScanRS]->link_thread_work_items(_scan_rs_empty_cards, ScanRSEmptyCards);
 
   _opt_cset_scanned_cards = new WorkerDataArray<size_t>(max_gc_threads, "Scanned Cards:");
   _gc_par_phases[OptScanRS]->link_thread_work_items(_opt_cset_scanned_cards, OptCSetScannedCards);
@@ -147,6 +147,9 @@ void G1GCPhaseTimes::reset() {
   _root_region_scan_wait_time_ms = 0.0;
   _external_accounted_time_ms = 0.0;
   _recorded_clear_claimed_marks_time_ms = 0.0;
+  _cur_merge_rs_time_ms = 0.0;
+  _cur_merge_rs_merged_cards = 0;
+  _cur_merge_rs_duplicate_cards = 0;
   _recorded_young_cset_choice_time_ms = 0.0;
   _recorded_non_young_cset_choice_time_ms = 0.0;
   _recorded_redirty_logged_cards_time_ms = 0.0;
@@ -343,7 +346,8 @@ double G1GCPhaseTimes::print_pre_evacuate_collection_set() const {
                         _recorded_young_cset_choice_time_ms +
                         _recorded_non_young_cset_choice_time_ms +
                         _cur_fast_reclaim_humongous_register_time_ms +
-                        _recorded_clear_claimed_marks_time_ms;
+                        _recorded_clear_claimed_marks_time_ms +
+                        _cur_merge_rs_time_ms;
 
   info_time("Pre Evacuate Collection Set", sum_ms);
 
@@ -361,6 +365,9 @@ double G1GCPhaseTimes::print_pre_evacuate_collection_set() const {
   if (_recorded_clear_claimed_marks_time_ms > 0.0) {
     debug_time("Clear Claimed Marks", _recorded_clear_claimed_marks_time_ms);
   }
+  debug_time("Merge Remembered Sets", _cur_merge_rs_time_ms);
+  trace_count("Merged Cards", _cur_merge_rs_merged_cards);
+  trace_count("Duplicate Cards", _cur_merge_rs_duplicate_cards);
   return sum_ms;
 }
 
@@ -85,7 +85,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   enum GCScanRSWorkItems {
     ScanRSScannedCards,
     ScanRSClaimedCards,
-    ScanRSSkippedCards
+    ScanRSEmptyCards
   };
 
   enum GCUpdateRSWorkItems {
@@ -115,7 +115,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   WorkerDataArray<size_t>* _scan_rs_scanned_cards;
   WorkerDataArray<size_t>* _scan_rs_claimed_cards;
-  WorkerDataArray<size_t>* _scan_rs_skipped_cards;
+  WorkerDataArray<size_t>* _scan_rs_empty_cards;
 
   WorkerDataArray<size_t>* _opt_cset_scanned_cards;
   WorkerDataArray<size_t>* _opt_cset_claimed_cards;
@@ -152,6 +152,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double _recorded_clear_claimed_marks_time_ms;
 
+  double _cur_merge_rs_time_ms;
+  size_t _cur_merge_rs_merged_cards;
+  size_t _cur_merge_rs_duplicate_cards;
+
   double _recorded_young_cset_choice_time_ms;
   double _recorded_non_young_cset_choice_time_ms;
 
@@ -347,6 +351,12 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _recorded_clear_claimed_marks_time_ms = recorded_clear_claimed_marks_time_ms;
   }
 
+  void record_merge_rs_time_ms(double ms, size_t merged_cards, size_t duplicate_cards) {
+    _cur_merge_rs_time_ms = ms;
+    _cur_merge_rs_merged_cards = merged_cards;
+    _cur_merge_rs_duplicate_cards = duplicate_cards;
+  }
+
   double cur_collection_start_sec() {
     return _cur_collection_start_sec;
   }
@@ -580,6 +580,19 @@ bool G1Policy::need_to_start_conc_mark(const char* source, size_t alloc_word_siz
 // Anything below that is considered to be zero
 #define MIN_TIMER_GRANULARITY 0.0000001
 
+double G1Policy::predict_time_to_next_gc_ms() const {
+  uint young_length = _g1h->young_regions_count();
+  uint target_length = _young_list_target_length;
+  if (young_length >= target_length || _analytics->num_alloc_rate_ms() == 0) {
+    return 0.0;
+  }
+  double alloc_rate_ms = _analytics->predict_alloc_rate_ms();
+  if (alloc_rate_ms <= 0.0) {
+    return 0.0;
+  }
+  return (target_length - young_length) / alloc_rate_ms;
+}
+
 void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_scanned, size_t heap_used_bytes_before_gc) {
   double end_time_sec = os::elapsedTime();
 
@@ -652,6 +665,19 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
 
   double scan_hcc_time_ms = G1HotCardCache::default_use_cache() ? average_time_ms(G1GCPhaseTimes::ScanHCC) : 0.0;
 
+  if (update_stats && G1UseAdaptiveConcRefinement) {
+    double refine_rate_ms;
+    double dirtied_cards_rate_ms;
+    _g1h->concurrent_refine()->mutator_phase_rates(_pending_cards, app_time_ms,
+                                                   &refine_rate_ms, &dirtied_cards_rate_ms);
+    if (refine_rate_ms >= 0.0) {
+      _analytics->report_concurrent_refine_rate_ms(refine_rate_ms);
+    }
+    if (dirtied_cards_rate_ms >= 0.0) {
+      _analytics->report_dirtied_cards_rate_ms(dirtied_cards_rate_ms);
+    }
+  }
+
   if (update_stats) {
     double cost_per_card_ms = 0.0;
     if (_pending_cards > 0) {
@@ -387,6 +387,10 @@ public:
 
   size_t young_list_target_length() const { return _young_list_target_length; }
 
+  // Predict the time until the mutators fill up the rest of the young gen,
+  // i.e. until the next young GC. Uses racy reads of the young gen length.
+  double predict_time_to_next_gc_ms() const;
+
   bool should_allocate_mutator_region() const;
 
   bool can_expand_young_list() const;
@@ -47,6 +47,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/os.hpp"
 #include "utilities/align.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/intHisto.hpp"
 #include "utilities/stack.inline.hpp"
@@ -97,6 +98,87 @@ private:
     }
   };
 
+  // Merges the remembered sets of all collection set regions into the merged
+  // card bitmap so that every card is scanned at most once.
+  class G1MergeRemSetsTask : public AbstractGangTask {
+    class G1MergeRemSetClosure : public HeapRegionClosure {
+      G1CollectedHeap* _g1h;
+      G1CardTable* _ct;
+      G1RemSetScanState* _scan_state;
+      HeapRegionClaimer* _hr_claimer;
+
+      size_t _cards_merged;
+      size_t _cards_duplicate;
+      size_t _cards_skipped;
+    public:
+      G1MergeRemSetClosure(G1RemSetScanState* scan_state, HeapRegionClaimer* hr_claimer) :
+        _g1h(G1CollectedHeap::heap()),
+        _ct(_g1h->card_table()),
+        _scan_state(scan_state),
+        _hr_claimer(hr_claimer),
+        _cards_merged(0),
+        _cards_duplicate(0),
+        _cards_skipped(0) { }
+
+      virtual bool do_heap_region(HeapRegion* r) {
+        if (!_hr_claimer->claim_region(r->hrm_index()) || r->rem_set()->cardset_is_empty()) {
+          return false;
+        }
+
+        HeapRegionRemSetIterator iter(r->rem_set());
+        size_t card_index;
+        while (iter.has_next(card_index)) {
+          HeapWord* const card_start = _g1h->bot()->address_for_index_raw(card_index);
+          uint const region_idx_for_card = _g1h->addr_to_region(card_start);
+
+          // Filter cards into regions we are not going to scan, and cards that are
+          // dirty: the latter are scanned during Update RS.
+          if (card_start >= _scan_state->scan_top(region_idx_for_card) ||
+              _ct->is_card_dirty(card_index)) {
+            _cards_skipped++;
+          } else if (_scan_state->add_merged_card(card_index, region_idx_for_card)) {
+            _cards_merged++;
+          } else {
+            _cards_duplicate++;
+          }
+        }
+        return false;
+      }
+
+      size_t cards_merged() const { return _cards_merged; }
+      size_t cards_duplicate() const { return _cards_duplicate; }
+      size_t cards_skipped() const { return _cards_skipped; }
+    };
+
+    G1RemSetScanState* _scan_state;
+    HeapRegionClaimer _hr_claimer;
+
+    size_t volatile _cards_merged;
+    size_t volatile _cards_duplicate;
+    size_t volatile _cards_skipped;
+  public:
+    G1MergeRemSetsTask(G1RemSetScanState* scan_state, uint n_workers) :
+      AbstractGangTask("G1 Merge Remembered Sets Task"),
+      _scan_state(scan_state),
+      _hr_claimer(n_workers),
+      _cards_merged(0),
+      _cards_duplicate(0),
+      _cards_skipped(0) { }
+
+    void work(uint worker_id) {
+      G1MergeRemSetClosure cl(_scan_state, &_hr_claimer);
+      G1CollectedHeap::heap()->collection_set_iterate_from(&cl, worker_id);
+
+      Atomic::add(cl.cards_merged(), &_cards_merged);
+      Atomic::add(cl.cards_duplicate(), &_cards_duplicate);
+      Atomic::add(cl.cards_skipped(), &_cards_skipped);
+    }
+
+    size_t cards_merged() const { return _cards_merged; }
+    size_t cards_duplicate() const { return _cards_duplicate; }
+    size_t cards_skipped() const { return _cards_skipped; }
+  };
+
   size_t _max_regions;
 
   // Scan progress for the remembered set of a single region. Transitions from
@@ -110,9 +192,6 @@ private:
   static const G1RemsetIterState Complete = 2;  // The remembered set has been completely scanned.
 
   G1RemsetIterState volatile* _iter_states;
-  // The current location where the next thread should continue scanning in a region's
-  // remembered set.
-  size_t volatile* _iter_claims;
 
   // Temporary buffer holding the regions we used to store remembered set scan duplicate
   // information. These are also called "dirty". Valid entries are from [0.._cur_dirty_region)
@@ -126,6 +205,19 @@ private:
   IsDirtyRegionState* _in_dirty_region_buffer;
   size_t _cur_dirty_region;
 
+  // The remembered set cards of the collection set that need to be scanned, one
+  // bit per card in the heap. Filled in by the merge pass before evacuation; bits
+  // are only set for cards below the scan top of their region.
+  CHeapBitMap _merged_cards;
+  // Regions that contain at least one merged card. Valid entries are from
+  // [0.._cur_merged_region), in no particular order.
+  uint* _merged_region_buffer;
+  IsDirtyRegionState* _in_merged_region_buffer;
+  size_t _cur_merged_region;
+  // The card offset, relative to the bottom of the region, where the next thread
+  // should continue scanning the merged cards of that region.
+  size_t volatile* _merged_claims;
+
   // Creates a snapshot of the current _top values at the start of collection to
   // filter out card marks that we do not want to scan.
   class G1ResetScanTopClosure : public HeapRegionClosure {
@@ -157,10 +249,14 @@ public:
   G1RemSetScanState() :
     _max_regions(0),
     _iter_states(NULL),
-    _iter_claims(NULL),
     _dirty_region_buffer(NULL),
     _in_dirty_region_buffer(NULL),
     _cur_dirty_region(0),
+    _merged_cards(mtGC),
+    _merged_region_buffer(NULL),
+    _in_merged_region_buffer(NULL),
+    _cur_merged_region(0),
+    _merged_claims(NULL),
     _scan_top(NULL) {
   }
 
@@ -168,15 +264,21 @@ public:
     if (_iter_states != NULL) {
       FREE_C_HEAP_ARRAY(G1RemsetIterState, _iter_states);
     }
-    if (_iter_claims != NULL) {
-      FREE_C_HEAP_ARRAY(size_t, _iter_claims);
-    }
     if (_dirty_region_buffer != NULL) {
       FREE_C_HEAP_ARRAY(uint, _dirty_region_buffer);
     }
     if (_in_dirty_region_buffer != NULL) {
       FREE_C_HEAP_ARRAY(IsDirtyRegionState, _in_dirty_region_buffer);
     }
+    if (_merged_region_buffer != NULL) {
+      FREE_C_HEAP_ARRAY(uint, _merged_region_buffer);
+    }
+    if (_in_merged_region_buffer != NULL) {
+      FREE_C_HEAP_ARRAY(IsDirtyRegionState, _in_merged_region_buffer);
+    }
+    if (_merged_claims != NULL) {
+      FREE_C_HEAP_ARRAY(size_t, _merged_claims);
+    }
     if (_scan_top != NULL) {
       FREE_C_HEAP_ARRAY(HeapWord*, _scan_top);
     }
@@ -184,12 +286,14 @@ public:
 
   void initialize(uint max_regions) {
     assert(_iter_states == NULL, "Must not be initialized twice");
-    assert(_iter_claims == NULL, "Must not be initialized twice");
     _max_regions = max_regions;
     _iter_states = NEW_C_HEAP_ARRAY(G1RemsetIterState, max_regions, mtGC);
-    _iter_claims = NEW_C_HEAP_ARRAY(size_t, max_regions, mtGC);
     _dirty_region_buffer = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
     _in_dirty_region_buffer = NEW_C_HEAP_ARRAY(IsDirtyRegionState, max_regions, mtGC);
+    _merged_cards.initialize((BitMap::idx_t)max_regions * HeapRegion::CardsPerRegion);
+    _merged_region_buffer = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
+    _in_merged_region_buffer = NEW_C_HEAP_ARRAY(IsDirtyRegionState, max_regions, mtGC);
+    _merged_claims = NEW_C_HEAP_ARRAY(size_t, max_regions, mtGC);
     _scan_top = NEW_C_HEAP_ARRAY(HeapWord*, max_regions, mtGC);
   }
 
@@ -202,9 +306,12 @@ public:
     G1ResetScanTopClosure cl(_scan_top);
     G1CollectedHeap::heap()->heap_region_iterate(&cl);
 
-    memset((void*)_iter_claims, 0, _max_regions * sizeof(size_t));
     memset(_in_dirty_region_buffer, Clean, _max_regions * sizeof(IsDirtyRegionState));
     _cur_dirty_region = 0;
+
+    memset((void*)_merged_claims, 0, _max_regions * sizeof(size_t));
+    memset(_in_merged_region_buffer, Clean, _max_regions * sizeof(IsDirtyRegionState));
+    _cur_merged_region = 0;
   }
 
   //mhr: modify
@@ -212,7 +319,6 @@ public:
     for (uint i = 0; i < _max_regions; i++) {
       _iter_states[i] = Unclaimed;
     }
-    memset((void*)_iter_claims, 0, _max_regions * sizeof(size_t));
   }
 
   // Attempt to claim the remembered set of the region for iteration. Returns true
@@ -242,18 +348,6 @@ public:
     return _iter_states[region] == Complete;
   }
 
-  // The current position within the remembered set of the given region.
-  inline size_t iter_claimed(uint region) const {
-    assert(region < _max_regions, "Tried to access invalid region %u", region);
-    return _iter_claims[region];
-  }
-
-  // Claim the next block of cards within the remembered set of the region with
-  // step size.
-  inline size_t iter_claimed_next(uint region, size_t step) {
-    return Atomic::add(step, &_iter_claims[region]) - step;
-  }
-
   void add_dirty_region(uint region) {
     if (_in_dirty_region_buffer[region] == Dirty) {
       return;
@@ -270,6 +364,68 @@ public:
     return _scan_top[region_idx];
   }
 
+  // Record the given card for scanning. Returns true if this call set the card,
+  // false if it has already been merged from another remembered set.
+  bool add_merged_card(size_t card_index, uint region_idx) {
+    if (_merged_cards.at(card_index) || !_merged_cards.par_set_bit(card_index)) {
+      return false;
+    }
+    if (_in_merged_region_buffer[region_idx] == Clean &&
+        Atomic::cmpxchg(Dirty, &_in_merged_region_buffer[region_idx], Clean) == Clean) {
+      size_t allocated = Atomic::add(1u, &_cur_merged_region) - 1;
+      _merged_region_buffer[allocated] = region_idx;
+    }
+    return true;
+  }
+
+  size_t num_merged_regions() const { return _cur_merged_region; }
+
+  uint merged_region(size_t i) const {
+    assert(i < _cur_merged_region, "Invalid merged region position " SIZE_FORMAT, i);
+    return _merged_region_buffer[i];
+  }
+
+  // Claim the next chunk of step cards of the given region. Returns the card offset
+  // of the chunk relative to the region bottom, or HeapRegion::CardsPerRegion if
+  // all cards of the region have already been claimed.
+  inline size_t claim_merged_cards(uint region_idx, size_t step) {
+    if (_merged_claims[region_idx] >= HeapRegion::CardsPerRegion) {
+      return HeapRegion::CardsPerRegion;
+    }
+    return MIN2(Atomic::add(step, &_merged_claims[region_idx]) - step, HeapRegion::CardsPerRegion);
+  }
+
+  size_t next_merged_card(size_t from, size_t limit) const {
+    return _merged_cards.get_next_one_offset(from, limit);
+  }
+
+  size_t next_unmerged_card(size_t from, size_t limit) const {
+    return _merged_cards.get_next_zero_offset(from, limit);
+  }
+
+  // Merge the remembered sets of the collection set into the merged card bitmap.
+  void merge_rem_sets(WorkGang* workers, G1GCPhaseTimes* phase_times) {
+    double start = os::elapsedTime();
+
+    G1MergeRemSetsTask cl(this, workers->active_workers());
+    workers->run_task(&cl);
+
+    phase_times->record_merge_rs_time_ms((os::elapsedTime() - start) * 1000.0,
+                                         cl.cards_merged(), cl.cards_duplicate());
+    log_debug(gc, remset)("Merged " SIZE_FORMAT " remembered set cards into " SIZE_FORMAT " regions "
+                          "(duplicate " SIZE_FORMAT ", skipped " SIZE_FORMAT ")",
+                          cl.cards_merged(), _cur_merged_region, cl.cards_duplicate(), cl.cards_skipped());
+  }
+
+  // Clear the merged card bitmap of all regions that had cards merged.
+  void clear_merged_cards() {
+    for (size_t i = 0; i < _cur_merged_region; i++) {
+      BitMap::idx_t const start = (BitMap::idx_t)_merged_region_buffer[i] * HeapRegion::CardsPerRegion;
+      _merged_cards.clear_range(start, start + HeapRegion::CardsPerRegion);
+    }
+    _cur_merged_region = 0;
+  }
+
   // Clear the card table of "dirty" regions.
   void clear_card_table(WorkGang* workers) {
     if (_cur_dirty_region == 0) {
@@ -335,88 +491,78 @@ G1ScanRSForRegionClosure::G1ScanRSForRegionClosure(G1RemSetScanState* scan_state
   _worker_i(worker_i),
   _cards_scanned(0),
   _cards_claimed(0),
-  _cards_skipped(0),
+  _cards_empty(0),
   _rem_set_root_scan_time(),
   _rem_set_trim_partially_time(),
   _strong_code_root_scan_time(),
   _strong_code_trim_partially_time() {
 }
 
-void G1ScanRSForRegionClosure::claim_card(size_t card_index, const uint region_idx_for_card){
-  _ct->set_card_claimed(card_index);
-  _scan_state->add_dirty_region(region_idx_for_card);
-}
-
-void G1ScanRSForRegionClosure::scan_card(MemRegion mr, uint region_idx_for_card) {
-  HeapRegion* const card_region = _g1h->region_at(region_idx_for_card);
-  assert(!card_region->is_young(), "Should not scan card in young region %u", region_idx_for_card);
-  card_region->oops_on_card_seq_iterate_careful<true>(mr, _scan_objs_on_card_cl);
-  _scan_objs_on_card_cl->trim_queue_partially();
-  _cards_scanned++;
-}
-
 void G1ScanRSForRegionClosure::scan_rem_set_roots(HeapRegion* r) {
-  EventGCPhaseParallel event;
   uint const region_idx = r->hrm_index();
 
+  // The remembered set of the region has already been merged into the merged
+  // cards, which are scanned in scan_merged_cards(). Only the regions of the
+  // collection set proper are merged, optional regions are not.
+  guarantee(r->index_in_opt_cset() == G1OptionalCSet::InvalidCSetIndex,
+            "Remembered set of optional region %u has not been merged", region_idx);
   if (_scan_state->claim_iter(region_idx)) {
     // If we ever free the collection set concurrently, we should also
     // clear the card table concurrently therefore we won't need to
     // add regions of the collection set to the dirty cards region.
     _scan_state->add_dirty_region(region_idx);
   }
+}
 
-  if (r->rem_set()->cardset_is_empty()) {
-    return;
-  }
+void G1ScanRSForRegionClosure::scan_merged_chunk(uint region_idx, size_t start, size_t end) {
+  HeapRegion* const card_region = _g1h->region_at(region_idx);
+  assert(!card_region->is_young(), "Should not scan card in young region %u", region_idx);
 
-  // We claim cards in blocks so as to reduce the contention.
-  size_t const block_size = G1RSetScanBlockSize;
+  HeapWord* const top = _scan_state->scan_top(region_idx);
+  size_t const region_card_base = (size_t)region_idx * HeapRegion::CardsPerRegion;
+  size_t const limit = region_card_base + end;
 
-  HeapRegionRemSetIterator iter(r->rem_set());
-  size_t card_index;
+  _cards_claimed += end - start;
 
-  size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-  for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
-    if (current_card >= claimed_card_block + block_size) {
-      claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-    }
-    if (current_card < claimed_card_block) {
-      _cards_skipped++;
-      continue;
-    }
-    _cards_claimed++;
+  size_t cur = _scan_state->next_merged_card(region_card_base + start, limit);
+  while (cur < limit) {
+    // Scan contiguous runs of merged cards at once, so that the object start is
+    // looked up in the BOT only once per run instead of once per card.
+    size_t const run_end = _scan_state->next_unmerged_card(cur, limit);
+    HeapWord* const run_start = _g1h->bot()->address_for_index_raw(cur);
+    assert(run_start < top, "Merged card " SIZE_FORMAT " above scan top of region %u", cur, region_idx);
 
-    HeapWord* const card_start = _g1h->bot()->address_for_index_raw(card_index);
-    uint const region_idx_for_card = _g1h->addr_to_region(card_start);
+    MemRegion const mr(run_start, MIN2(_g1h->bot()->address_for_index_raw(run_end), top));
+    card_region->oops_on_card_seq_iterate_careful<true>(mr, _scan_objs_on_card_cl);
+    _scan_objs_on_card_cl->trim_queue_partially();
+    _cards_scanned += run_end - cur;
 
-#ifdef ASSERT
-    HeapRegion* hr = _g1h->region_at_or_null(region_idx_for_card);
-    assert(hr == NULL || hr->is_in_reserved(card_start),
-           "Card start " PTR_FORMAT " to scan outside of region %u", p2i(card_start), _g1h->region_at(region_idx_for_card)->hrm_index());
-#endif
-    HeapWord* const top = _scan_state->scan_top(region_idx_for_card);
-    if (card_start >= top) {
-      continue;
-    }
+    cur = _scan_state->next_merged_card(run_end, limit);
+  }
+}
 
-    // If the card is dirty, then G1 will scan it during Update RS.
-    if (_ct->is_card_claimed(card_index) || _ct->is_card_dirty(card_index)) {
-      continue;
-    }
+void G1ScanRSForRegionClosure::scan_merged_cards() {
+  size_t const num_regions = _scan_state->num_merged_regions();
+  if (num_regions == 0) {
+    return;
+  }
 
-    // We claim lazily (so races are possible but they're benign), which reduces the
-    // number of duplicate scans (the rsets of the regions in the cset can intersect).
-    // Claim the card after checking bounds above: the remembered set may contain
-    // random cards into current survivor, and we would then have an incorrectly
-    // claimed card in survivor space. Card table clear does not reset the card table
-    // of survivor space regions.
-    claim_card(card_index, region_idx_for_card);
+  EventGCPhaseParallel event;
+  G1EvacPhaseWithTrimTimeTracker timer(_pss, _rem_set_root_scan_time, _rem_set_trim_partially_time);
 
-    MemRegion const mr(card_start, MIN2(card_start + BOTConstants::N_words, top));
+  // We claim cards in blocks so as to reduce the contention. Workers start at
+  // different regions to spread them out.
+  size_t const block_size = G1RSetScanBlockSize;
+  size_t const start_pos = _worker_i % num_regions;
 
-    scan_card(mr, region_idx_for_card);
+  for (size_t i = 0; i < num_regions; i++) {
+    uint const region_idx = _scan_state->merged_region((start_pos + i) % num_regions);
+    size_t claimed;
+    while ((claimed = _scan_state->claim_merged_cards(region_idx, block_size)) < HeapRegion::CardsPerRegion) {
+      scan_merged_chunk(region_idx, claimed, MIN2(claimed + block_size, HeapRegion::CardsPerRegion));
+    }
   }
+  _cards_empty = _cards_claimed - _cards_scanned;
   event.commit(GCId::current(), _worker_i, G1GCPhaseTimes::phase_name(_phase));
 }
 
@@ -644,32 +790,23 @@ void G1ScanRSForRegionClosureUpdate::scan_rem_set_roots(HeapRegion* r) {
     printf("0\n");
   }
 
-  if (_scan_state->claim_iter(region_idx)) {
-    // If we ever free the collection set concurrently, we should also
-    // clear the card table concurrently therefore we won't need to
-    // add regions of the collection set to the dirty cards region.
-    _scan_state->add_dirty_region(region_idx);
+  // The worker that claims the region walks its whole remembered set.
+  if (!_scan_state->claim_iter(region_idx)) {
+    return;
   }
+  // If we ever free the collection set concurrently, we should also
+  // clear the card table concurrently therefore we won't need to
+  // add regions of the collection set to the dirty cards region.
+  _scan_state->add_dirty_region(region_idx);
 
   if (r->rem_set()->cardset_is_empty()) {
     return;
   }
 
-  // We claim cards in blocks so as to reduce the contention.
-  size_t const block_size = G1RSetScanBlockSize;
-
   HeapRegionRemSetIterator iter(r->rem_set());
   size_t card_index;
 
-  size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-  for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
-    if (current_card >= claimed_card_block + block_size) {
-      claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-    }
-    if (current_card < claimed_card_block) {
-      _cards_skipped++;
-      continue;
-    }
+  while (iter.has_next(card_index)) {
     _cards_claimed++;
 
     HeapWord* const card_start = _g1h->bot()->address_for_index_raw(card_index);
@@ -808,6 +945,7 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss, uint worker_i) {
   //
   //G1ScanRSForRegionClosureNew cl(_scan_state, &scan_cl, pss, G1GCPhaseTimes::ScanRS, worker_i);
   G1ScanRSForRegionClosure cl(_scan_state, &scan_cl, pss, G1GCPhaseTimes::ScanRS, worker_i);
+  cl.scan_merged_cards();
   _g1h->collection_set_iterate_from(&cl, worker_i);
 
   G1GCPhaseTimes* p = _g1p->phase_times();
@@ -817,7 +955,7 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss, uint worker_i) {
 
   p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_scanned(), G1GCPhaseTimes::ScanRSScannedCards);
   p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_claimed(), G1GCPhaseTimes::ScanRSClaimedCards);
-  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_skipped(), G1GCPhaseTimes::ScanRSSkippedCards);
+  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_empty(), G1GCPhaseTimes::ScanRSEmptyCards);
 
   p->record_time_secs(G1GCPhaseTimes::CodeRoots, worker_i, cl.strong_code_root_scan_time().seconds());
   p->add_time_secs(G1GCPhaseTimes::ObjCopy, worker_i, cl.strong_code_root_trim_partially_time().seconds());
@@ -962,6 +1100,7 @@ void G1RemSet::prepare_for_oops_into_collection_set_do() {
   dcqs.concatenate_logs();
 
   _scan_state->reset();
+  _scan_state->merge_rem_sets(_g1h->workers(), _g1p->phase_times());
 }
 
 void G1RemSet::cleanup_after_oops_into_collection_set_do() {
@@ -970,6 +1109,7 @@ void G1RemSet::cleanup_after_oops_into_collection_set_do() {
   // Set all cards back to clean.
   double start = os::elapsedTime();
   _scan_state->clear_card_table(_g1h->workers());
+  _scan_state->clear_merged_cards();
   phase_times->record_clear_ct_time((os::elapsedTime() - start) * 1000.0);
 }
 
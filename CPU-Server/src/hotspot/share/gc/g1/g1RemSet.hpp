@@ -157,7 +157,8 @@ protected:
 
   size_t _cards_scanned;
   size_t _cards_claimed;
-  size_t _cards_skipped;
+  // Cards in claimed chunks without a merged remembered set entry.
+  size_t _cards_empty;
 
   Tickspan _rem_set_root_scan_time;
   Tickspan _rem_set_trim_partially_time;
@@ -165,8 +166,9 @@ protected:
   Tickspan _strong_code_root_scan_time;
   Tickspan _strong_code_trim_partially_time;
 
-  void claim_card(size_t card_index, const uint region_idx_for_card);
-  void scan_card(MemRegion mr, uint region_idx_for_card);
+  // Scan the merged cards in [start, end) of the given region, card offsets
+  // relative to the region bottom.
+  void scan_merged_chunk(uint region_idx, size_t start, size_t end);
 
   //mhr: new
   //mhr: modify
@@ -182,6 +184,10 @@ public:
   //mhr: modify
   virtual bool do_heap_region(HeapRegion* r);
 
+  // Scan the remembered set cards of the collection set merged before evacuation,
+  // claiming chunks of cards per region.
+  void scan_merged_cards();
+
   Tickspan rem_set_root_scan_time() const { return _rem_set_root_scan_time; }
   Tickspan rem_set_trim_partially_time() const { return _rem_set_trim_partially_time; }
 
@@ -190,7 +196,7 @@ public:
 
   size_t cards_scanned() const { return _cards_scanned; }
   size_t cards_claimed() const { return _cards_claimed; }
-  size_t cards_skipped() const { return _cards_skipped; }
+  size_t cards_empty() const { return _cards_empty; }
 };
 
 // mhr: modify
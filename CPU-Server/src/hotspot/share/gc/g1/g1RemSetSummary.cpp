@@ -307,11 +307,11 @@ public:
     }
 
     out->print_cr("   Static structures = " SIZE_FORMAT "%s,"
-                  " free_lists = " SIZE_FORMAT "%s.",
+                  " retired containers = " SIZE_FORMAT "%s.",
                   byte_size_in_proper_unit(HeapRegionRemSet::static_mem_size()),
                   proper_unit_for_byte_size(HeapRegionRemSet::static_mem_size()),
-                  byte_size_in_proper_unit(HeapRegionRemSet::fl_mem_size()),
-                  proper_unit_for_byte_size(HeapRegionRemSet::fl_mem_size()));
+                  byte_size_in_proper_unit(HeapRegionRemSet::retired_mem_size()),
+                  proper_unit_for_byte_size(HeapRegionRemSet::retired_mem_size()));
 
     out->print_cr("    " SIZE_FORMAT " occupied cards represented.",
                   total_cards_occupied());
@@ -160,26 +160,35 @@
           range(0, max_jubyte)                                              \
                                                                             \
   develop(intx, G1RSetRegionEntriesBase, 256,                               \
-          "Max number of regions in a fine-grain table per MB.")            \
+          "Number of buckets in the remembered set card set hash table "    \
+          "per MB.")                                                        \
           range(1, max_jint/wordSize)                                       \
                                                                             \
   product(intx, G1RSetRegionEntries, 0,                                     \
-          "Max number of regions for which we keep bitmaps."                \
+          "Number of buckets in the remembered set card set hash table, "   \
+          "rounded down to a power of two. "                                \
           "Will be set ergonomically by default")                           \
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetRegionEntriesConstraintFunc,AfterErgo)           \
                                                                             \
   develop(intx, G1RSetSparseRegionEntriesBase, 4,                           \
-          "Max number of entries per region in a sparse table "             \
-          "per MB.")                                                        \
+          "Max number of cards per region in an array card set "            \
+          "container per MB.")                                              \
           range(1, max_jint/wordSize)                                       \
                                                                             \
   product(intx, G1RSetSparseRegionEntries, 0,                               \
-          "Max number of entries per region in a sparse table."             \
+          "Max number of cards per region in an array card set "            \
+          "container before it is turned into a bitmap. "                   \
           "Will be set ergonomically by default.")                          \
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetSparseRegionEntriesConstraintFunc,AfterErgo)     \
                                                                             \
+  experimental(uint, G1RemSetCoarsenBitmapToFullPercent, 90,                \
+          "Percentage of the cards of a region that a bitmap card set "     \
+          "container may hold before the whole region is remembered "       \
+          "instead.")                                                       \
+          range(1, 100)                                                     \
+                                                                            \
   develop(intx, G1MaxVerifyFailures, -1,                                    \
           "The maximum number of verification failures to print.  "         \
           "-1 means print all.")                                            \
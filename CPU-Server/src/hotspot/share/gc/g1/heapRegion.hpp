@@ -489,6 +489,9 @@ public:
   // for the collection set.
   double _predicted_elapsed_time_ms;
 
+  // Node index of the memory node this region is (preferably) located on.
+  uint _node_index;
+
   // Iterate over the references in a humongous objects and apply the given closure
   // to them.
   // Humongous objects are allocated directly in the old-gen. So we need special
@@ -880,6 +883,9 @@ public:
     _predicted_elapsed_time_ms = ms;
   }
 
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
   // Routines for managing a list of code roots (attached to the
   // this region's RSet) that point into this heap region.
   void add_strong_code_root(nmethod* nm);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,138 +25,27 @@
 #ifndef SHARE_VM_GC_G1_HEAPREGIONREMSET_HPP
 #define SHARE_VM_GC_G1_HEAPREGIONREMSET_HPP
 
+#include "gc/g1/g1CardSet.hpp"
 #include "gc/g1/g1CodeCacheRemSet.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
 #include "gc/g1/g1FromCardCache.hpp"
-#include "gc/g1/sparsePRT.hpp"
+#include "gc/g1/heapRegion.hpp"
+#include "gc/shared/cardTableBarrierSet.hpp"
+#include "runtime/mutex.hpp"
 
 // Remembered set for a heap region.  Represent a set of "cards" that
 // contain pointers into the owner heap region.  Cards are defined somewhat
 // abstractly, in terms of what the "BlockOffsetTable" in use can parse.
+//
+// The cards are kept in a G1CardSet, grouped by the region containing them.
 
 class G1CollectedHeap;
 class G1BlockOffsetTable;
 class G1CardLiveData;
 class HeapRegion;
 class HeapRegionRemSetIterator;
-class PerRegionTable;
-class SparsePRT;
 class nmethod;
 
-// The "_coarse_map" is a bitmap with one bit for each region, where set
-// bits indicate that the corresponding region may contain some pointer
-// into the owning region.
-
-// The "_fine_grain_entries" array is an open hash table of PerRegionTables
-// (PRTs), indicating regions for which we're keeping the RS as a set of
-// cards.  The strategy is to cap the size of the fine-grain table,
-// deleting an entry and setting the corresponding coarse-grained bit when
-// we would overflow this cap.
-
-// We use a mixture of locking and lock-free techniques here.  We allow
-// threads to locate PRTs without locking, but threads attempting to alter
-// a bucket list obtain a lock.  This means that any failing attempt to
-// find a PRT must be retried with the lock.  It might seem dangerous that
-// a read can find a PRT that is concurrently deleted.  This is all right,
-// because:
-//
-//   1) We only actually free PRT's at safe points (though we reuse them at
-//      other times).
-//   2) We find PRT's in an attempt to add entries.  If a PRT is deleted,
-//      it's _coarse_map bit is set, so the that we were attempting to add
-//      is represented.  If a deleted PRT is re-used, a thread adding a bit,
-//      thinking the PRT is for a different region, does no harm.
-
-class OtherRegionsTable {
-  friend class HeapRegionRemSetIterator;
-
-  G1CollectedHeap* _g1h;
-  Mutex*           _m;
-
-  // These are protected by "_m".
-  CHeapBitMap _coarse_map;
-  size_t      _n_coarse_entries;
-  static jint _n_coarsenings;
-
-  PerRegionTable** _fine_grain_regions;
-  size_t           _n_fine_entries;
-
-  // The fine grain remembered sets are doubly linked together using
-  // their 'next' and 'prev' fields.
-  // This allows fast bulk freeing of all the fine grain remembered
-  // set entries, and fast finding of all of them without iterating
-  // over the _fine_grain_regions table.
-  PerRegionTable * _first_all_fine_prts;
-  PerRegionTable * _last_all_fine_prts;
-
-  // Used to sample a subset of the fine grain PRTs to determine which
-  // PRT to evict and coarsen.
-  size_t        _fine_eviction_start;
-  static size_t _fine_eviction_stride;
-  static size_t _fine_eviction_sample_size;
-
-  SparsePRT   _sparse_table;
-
-  // These are static after init.
-  static size_t _max_fine_entries;
-  static size_t _mod_max_fine_entries_mask;
-
-  // Requires "prt" to be the first element of the bucket list appropriate
-  // for "hr".  If this list contains an entry for "hr", return it,
-  // otherwise return "NULL".
-  PerRegionTable* find_region_table(size_t ind, HeapRegion* hr) const;
-
-  // Find, delete, and return a candidate PerRegionTable, if any exists,
-  // adding the deleted region to the coarse bitmap.  Requires the caller
-  // to hold _m, and the fine-grain table to be full.
-  PerRegionTable* delete_region_table();
-
-  // link/add the given fine grain remembered set into the "all" list
-  void link_to_all(PerRegionTable * prt);
-  // unlink/remove the given fine grain remembered set into the "all" list
-  void unlink_from_all(PerRegionTable * prt);
-
-  bool contains_reference_locked(OopOrNarrowOopStar from) const;
-
-  size_t occ_fine() const;
-  size_t occ_coarse() const;
-  size_t occ_sparse() const;
-
-public:
-  // Create a new remembered set. The given mutex is used to ensure consistency.
-  OtherRegionsTable(Mutex* m);
-
-  // Returns the card index of the given within_region pointer relative to the bottom
-  // of the given heap region.
-  static CardIdx_t card_within_region(OopOrNarrowOopStar within_region, HeapRegion* hr);
-  // Adds the reference from "from to this remembered set.
-  void add_reference(OopOrNarrowOopStar from, uint tid);
-
-  // Returns whether the remembered set contains the given reference.
-  bool contains_reference(OopOrNarrowOopStar from) const;
-
-  // Returns whether this remembered set (and all sub-sets) have an occupancy
-  // that is less or equal than the given occupancy.
-  bool occupancy_less_or_equal_than(size_t limit) const;
-
-  // Returns whether this remembered set (and all sub-sets) does not contain any entry.
-  bool is_empty() const;
-
-  // Returns the number of cards contained in this remembered set.
-  size_t occupied() const;
-
-  static jint n_coarsenings() { return _n_coarsenings; }
-
-  // Returns size of the actual remembered set containers in bytes.
-  size_t mem_size() const;
-  // Returns the size of static data in bytes.
-  static size_t static_mem_size();
-  // Returns the size of the free list content in bytes.
-  static size_t fl_mem_size();
-
-  // Clear the entire contents of this remembered set.
-  void clear();
-};
-
 class HeapRegionRemSet : public CHeapObj<mtGC> {
   friend class VMStructs;
   friend class HeapRegionRemSetIterator;
@@ -170,19 +59,30 @@ private:
 
   Mutex _m;
 
-  OtherRegionsTable _other_regions;
+  // The container sizes shared by all remembered sets.
+  static G1CardSetConfiguration* _config;
+
+  G1CardSet _card_set;
+
+  G1CollectedHeap* _g1h;
 
   HeapRegion* _hr;
 
   void clear_fcc();
 
+  void add_reference_to_card_set(OopOrNarrowOopStar from);
+
 public:
   HeapRegionRemSet(G1BlockOffsetTable* bot, HeapRegion* hr);
 
   static void setup_remset_size();
 
+  // Returns the card index of the given within_region pointer relative to the bottom
+  // of the given heap region.
+  static CardIdx_t card_within_region(OopOrNarrowOopStar within_region, HeapRegion* hr);
+
   bool cardset_is_empty() const {
-    return _other_regions.is_empty();
+    return _card_set.is_empty();
   }
 
   bool is_empty() const {
@@ -190,7 +90,7 @@ public:
   }
 
   bool occupancy_less_or_equal_than(size_t occ) const {
-    return (strong_code_roots_list_length() == 0) && _other_regions.occupancy_less_or_equal_than(occ);
+    return (strong_code_roots_list_length() == 0) && _card_set.occupancy_less_or_equal_to(occ);
   }
 
   size_t occupied() {
@@ -198,10 +98,12 @@ public:
     return occupied_locked();
   }
   size_t occupied_locked() {
-    return _other_regions.occupied();
+    return _card_set.occupied();
   }
 
-  static jint n_coarsenings() { return OtherRegionsTable::n_coarsenings(); }
+  // Returns the number of source regions whose cards have been replaced by
+  // the whole region.
+  static jint n_coarsenings() { return G1CardSet::num_coarsenings(); }
 
 private:
   enum RemSetState {
@@ -263,7 +165,7 @@ public:
       return;
     }
 
-    _other_regions.add_reference(from, tid);
+    add_reference_to_card_set(from);
   }
 
   // The region is being reclaimed; clear its remset, and any mention of
@@ -275,28 +177,26 @@ public:
   // Note also includes the strong code root set.
   size_t mem_size() {
     MutexLockerEx x(&_m, Mutex::_no_safepoint_check_flag);
-    return _other_regions.mem_size()
+    return _card_set.mem_size()
       // This correction is necessary because the above includes the second
       // part.
-      + (sizeof(HeapRegionRemSet) - sizeof(OtherRegionsTable))
+      + (sizeof(HeapRegionRemSet) - sizeof(G1CardSet))
       + strong_code_roots_mem_size();
   }
 
   // Returns the memory occupancy of all static data structures associated
   // with remembered sets.
   static size_t static_mem_size() {
-    return OtherRegionsTable::static_mem_size() + G1CodeRootSet::static_mem_size();
+    return G1FromCardCache::static_mem_size() + G1CodeRootSet::static_mem_size();
   }
 
-  // Returns the memory occupancy of all free_list data structures associated
-  // with remembered sets.
-  static size_t fl_mem_size() {
-    return OtherRegionsTable::fl_mem_size();
+  // Returns the memory occupancy of card set containers that have been
+  // replaced by larger ones, but not yet freed.
+  static size_t retired_mem_size() {
+    return G1CardSet::retired_mem_size();
   }
 
-  bool contains_reference(OopOrNarrowOopStar from) const {
-    return _other_regions.contains_reference(from);
-  }
+  bool contains_reference(OopOrNarrowOopStar from) const;
 
   // Routines for managing the list of code roots that point into
   // the heap region that owns this RSet.
@@ -340,53 +240,17 @@ public:
 
 class HeapRegionRemSetIterator : public StackObj {
 private:
-  // The region RSet over which we are iterating.
-  HeapRegionRemSet* _hrrs;
-
   // Local caching of HRRS fields.
-  const BitMap*             _coarse_map;
-
   G1BlockOffsetTable*       _bot;
   G1CollectedHeap*          _g1h;
 
-  // The number of cards yielded since initialization.
-  size_t _n_yielded_fine;
-  size_t _n_yielded_coarse;
-  size_t _n_yielded_sparse;
-
-  // Indicates what granularity of table that we are currently iterating over.
-  // We start iterating over the sparse table, progress to the fine grain
-  // table, and then finish with the coarse table.
-  enum IterState {
-    Sparse,
-    Fine,
-    Coarse
-  };
-  IterState _is;
+  G1CardSetIterator _iter;
 
-  // For both Coarse and Fine remembered set iteration this contains the
-  // first card number of the heap region we currently iterate over.
+  // The source region of the last card yielded, and the card index of its
+  // bottom.
+  uint   _cur_region_idx;
   size_t _cur_region_card_offset;
 
-  // Current region index for the Coarse remembered set iteration.
-  int    _coarse_cur_region_index;
-  size_t _coarse_cur_region_cur_card;
-
-  bool coarse_has_next(size_t& card_index);
-
-  // The PRT we are currently iterating over.
-  PerRegionTable* _fine_cur_prt;
-  // Card offset within the current PRT.
-  size_t _cur_card_in_prt;
-
-  // Update internal variables when switching to the given PRT.
-  void switch_to_prt(PerRegionTable* prt);
-  bool fine_has_next();
-  bool fine_has_next(size_t& card_index);
-
-  // The Sparse remembered set iterator.
-  SparsePRTIter _sparse_iter;
-
 public:
   HeapRegionRemSetIterator(HeapRegionRemSet* hrrs);
 
@@ -396,12 +260,7 @@ public:
   // undefined.)
   bool has_next(size_t& card_index);
 
-  size_t n_yielded_fine() { return _n_yielded_fine; }
-  size_t n_yielded_coarse() { return _n_yielded_coarse; }
-  size_t n_yielded_sparse() { return _n_yielded_sparse; }
-  size_t n_yielded() {
-    return n_yielded_fine() + n_yielded_coarse() + n_yielded_sparse();
-  }
+  size_t n_yielded() const { return _iter.num_yielded(); }
 };
 
 #endif // SHARE_VM_GC_G1_HEAPREGIONREMSET_HPP
@@ -51,7 +51,8 @@ class ParCompactionManager;
 
 class PSPromotionManager {
   friend class PSScavenge;
-  friend class PSRefProcTaskExecutor;
+  friend class PSRefProcTask;
+  friend class ScavengeRootsTask;
  private:
   static PaddedEnd<PSPromotionManager>* _manager_array;
   static OopStarTaskQueueSet*           _stack_array_depth;
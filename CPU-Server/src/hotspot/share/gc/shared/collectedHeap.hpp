@@ -58,6 +58,16 @@ class VirtualSpaceSummary;
 class WorkGang;
 class nmethod;
 
+// Iterates over the objects of the heap from several worker threads at once,
+// see CollectedHeap::parallel_object_iterator().
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+ public:
+  // Applies the closure to the objects of the parts of the heap claimed
+  // by the given worker.
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 class GCMessage : public FormatBuffer<1024> {
  public:
   bool is_before;
@@ -436,6 +446,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator for thread_num workers of get_safepoint_workers()
+  // to iterate over all objects in parallel at a safepoint, or NULL if
+  // the heap can only be iterated serially. The caller deletes it.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
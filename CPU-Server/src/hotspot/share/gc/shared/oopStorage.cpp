@@ -758,7 +758,8 @@ OopStorage::OopStorage(const char* name,
   _active_mutex(active_mutex),
   _allocation_count(0),
   _concurrent_iteration_count(0),
-  _needs_cleanup(needs_cleanup_none)
+  _needs_cleanup(needs_cleanup_none),
+  _num_dead_callback(NULL)
 {
   _active_array->increment_refcount();
   assert(_active_mutex->rank() < _allocation_mutex->rank(),
@@ -817,6 +818,22 @@ void OopStorage::notify_needs_cleanup() {
   }
 }
 
+void OopStorage::register_num_dead_callback(NumDeadCallback f) {
+  assert(_num_dead_callback == NULL, "%s: callback already registered", _name);
+  _num_dead_callback = f;
+}
+
+bool OopStorage::should_report_num_dead() const {
+  return _num_dead_callback != NULL;
+}
+
+void OopStorage::report_num_dead(size_t num_dead) const {
+  if (_num_dead_callback != NULL) {
+    log_debug(oopstorage, ref)("%s: reporting " SIZE_FORMAT " dead entries", name(), num_dead);
+    _num_dead_callback(num_dead);
+  }
+}
+
 bool OopStorage::delete_empty_blocks() {
   MutexLockerEx ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
 
@@ -931,7 +948,8 @@ OopStorage::BasicParState::BasicParState(const OopStorage* storage,
   _block_count(0),              // initialized properly below
   _next_block(0),
   _estimated_thread_count(estimated_thread_count),
-  _concurrent(concurrent)
+  _concurrent(concurrent),
+  _num_dead(0)
 {
   assert(estimated_thread_count > 0, "estimated thread count must be positive");
   update_concurrent_iteration_count(1);
@@ -959,6 +977,16 @@ void OopStorage::BasicParState::update_concurrent_iteration_count(int value) {
   }
 }
 
+void OopStorage::BasicParState::increment_num_dead(size_t num_dead) {
+  if (num_dead > 0) {
+    Atomic::add(num_dead, &_num_dead);
+  }
+}
+
+void OopStorage::BasicParState::report_num_dead() const {
+  _storage->report_num_dead(Atomic::load(&_num_dead));
+}
+
 bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
   data->_processed += data->_segment_end - data->_segment_start;
   size_t start = OrderAccess::load_acquire(&_next_block);
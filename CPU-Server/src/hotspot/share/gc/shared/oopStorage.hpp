@@ -165,6 +165,26 @@ public:
   // whether a call to delete_empty_blocks should be made.
   bool needs_delete_empty_blocks() const;
 
+  // Support for dead entry notification.  The owner of a storage whose
+  // entries are weak may register a callback.  GC iterations over the
+  // storage count the entries found dead (cleared by the iteration) and
+  // report that count through the callback once the iteration completes,
+  // regardless of which GC performed the iteration.  The owner can then
+  // schedule concurrent cleanup of whatever refers to those entries,
+  // keeping that work out of the GC pause.
+  // The callback is invoked at the end of a GC iteration and must not
+  // block or safepoint.
+  typedef void (*NumDeadCallback)(size_t num_dead);
+
+  // Precondition: no callback has been registered for this storage.
+  void register_num_dead_callback(NumDeadCallback f);
+
+  // Returns true if a callback has been registered.
+  bool should_report_num_dead() const;
+
+  // Invokes the registered callback, if any.
+  void report_num_dead(size_t num_dead) const;
+
   // Debugging and logging support.
   const char* name() const;
   void print_on(outputStream* st) const PRODUCT_RETURN;
@@ -234,6 +254,8 @@ AIX_ONLY(private:)
 
   volatile uint _needs_cleanup;
 
+  NumDeadCallback _num_dead_callback;
+
   bool try_add_block();
   Block* block_for_allocation();
 
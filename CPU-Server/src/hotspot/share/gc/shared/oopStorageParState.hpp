@@ -125,6 +125,19 @@
 //   If *p == NULL then neither is_alive nor cl will be invoked for p.
 //   If is_alive->do_object_b(*p) is false, then cl will not be
 //   invoked on p.
+//
+// void increment_num_dead(size_t num_dead)
+//   Add num_dead to the number of entries found dead by this iteration.
+//   Intended to be called by each worker with the number of entries it
+//   cleared.
+//
+// size_t num_dead() const
+//   Returns the number of dead entries accumulated so far.
+//
+// void report_num_dead() const
+//   Report the accumulated number of dead entries to the storage's
+//   registered callback, if any.  Should be called once, after all
+//   workers have completed the iteration.
 
 class OopStorage::BasicParState {
   const OopStorage* _storage;
@@ -133,6 +146,7 @@ class OopStorage::BasicParState {
   volatile size_t _next_block;
   uint _estimated_thread_count;
   bool _concurrent;
+  volatile size_t _num_dead;
 
   // Noncopyable.
   BasicParState(const BasicParState&);
@@ -156,6 +170,10 @@ public:
   template<bool is_const, typename F> void iterate(F f);
 
   static uint default_estimated_thread_count(bool concurrent);
+
+  void increment_num_dead(size_t num_dead);
+  size_t num_dead() const { return _num_dead; }
+  void report_num_dead() const;
 };
 
 template<bool concurrent, bool is_const>
@@ -174,6 +192,10 @@ public:
 
   template<typename F> void iterate(F f);
   template<typename Closure> void oops_do(Closure* cl);
+
+  void increment_num_dead(size_t num_dead) { _basic_state.increment_num_dead(num_dead); }
+  size_t num_dead() const { return _basic_state.num_dead(); }
+  void report_num_dead() const { _basic_state.report_num_dead(); }
 };
 
 template<>
@@ -191,6 +213,10 @@ public:
   template<typename Closure> void weak_oops_do(Closure* cl);
   template<typename IsAliveClosure, typename Closure>
   void weak_oops_do(IsAliveClosure* is_alive, Closure* cl);
+
+  void increment_num_dead(size_t num_dead) { _basic_state.increment_num_dead(num_dead); }
+  size_t num_dead() const { return _basic_state.num_dead(); }
+  void report_num_dead() const { _basic_state.report_num_dead(); }
 };
 
 #endif // SHARE_GC_SHARED_OOPSTORAGEPARSTATE_HPP
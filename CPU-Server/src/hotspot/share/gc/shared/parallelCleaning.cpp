@@ -38,10 +38,6 @@ StringCleaningTask::StringCleaningTask(BoolObjectClosure* is_alive, StringDedupU
   _par_state_string(StringTable::weak_storage()),
   _initial_string_table_size((int) StringTable::the_table()->table_size()),
   _process_strings(process_strings), _strings_processed(0), _strings_removed(0) {
-
-  if (process_strings) {
-    StringTable::reset_dead_counter();
-  }
 }
 
 StringCleaningTask::~StringCleaningTask() {
@@ -50,7 +46,7 @@ StringCleaningTask::~StringCleaningTask() {
       "strings: " SIZE_FORMAT " processed, " SIZE_FORMAT " removed",
       strings_processed(), strings_removed());
   if (_process_strings) {
-    StringTable::finish_dead_counter();
+    _par_state_string.report_num_dead();
   }
 }
 
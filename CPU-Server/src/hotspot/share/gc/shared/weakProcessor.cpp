@@ -39,7 +39,14 @@ void WeakProcessor::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_a
     if (WeakProcessorPhases::is_serial(phase)) {
       WeakProcessorPhases::processor(phase)(is_alive, keep_alive);
     } else {
-      WeakProcessorPhases::oop_storage(phase)->weak_oops_do(is_alive, keep_alive);
+      OopStorage* storage = WeakProcessorPhases::oop_storage(phase);
+      if (storage->should_report_num_dead()) {
+        CountingIsAliveClosure<BoolObjectClosure> cl(is_alive);
+        storage->weak_oops_do(&cl, keep_alive);
+        storage->report_num_dead(cl.num_dead());
+      } else {
+        storage->weak_oops_do(is_alive, keep_alive);
+      }
     }
   }
 }
@@ -124,6 +131,12 @@ WeakProcessor::Task::~Task() {
   }
 }
 
+void WeakProcessor::Task::report_num_dead() {
+  for (uint i = 0; i < WeakProcessorPhases::oop_storage_phase_count; ++i) {
+    _storage_states[i].report_num_dead();
+  }
+}
+
 void WeakProcessor::GangTask::work(uint worker_id) {
   _erased_do_work(this, worker_id);
 }
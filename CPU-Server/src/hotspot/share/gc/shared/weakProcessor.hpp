@@ -90,6 +90,10 @@ public:
 
   template<typename IsAlive, typename KeepAlive>
   void work(uint worker_id, IsAlive* is_alive, KeepAlive* keep_alive);
+
+  // Report the number of dead entries found in each OopStorage to the
+  // storage's dead entry callback.  Call once after all workers completed.
+  void report_num_dead();
 };
 
 #endif // SHARE_VM_GC_SHARED_WEAKPROCESSOR_HPP
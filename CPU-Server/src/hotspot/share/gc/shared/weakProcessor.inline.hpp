@@ -36,6 +36,29 @@
 class BoolObjectClosure;
 class OopClosure;
 
+// Wraps an is-alive closure, counting the entries it examines and the
+// entries it finds dead.
+template<typename IsAlive>
+class CountingIsAliveClosure : public BoolObjectClosure {
+  IsAlive* _inner;
+
+  size_t _num_dead;
+  size_t _num_total;
+
+public:
+  CountingIsAliveClosure(IsAlive* cl) : _inner(cl), _num_dead(0), _num_total(0) { }
+
+  virtual bool do_object_b(oop obj) {
+    bool result = _inner->do_object_b(obj);
+    _num_dead += !result;
+    _num_total++;
+    return result;
+  }
+
+  size_t num_dead() const { return _num_dead; }
+  size_t num_total() const { return _num_total; }
+};
+
 template<typename IsAlive, typename KeepAlive>
 void WeakProcessor::Task::work(uint worker_id,
                                IsAlive* is_alive,
@@ -54,7 +77,12 @@ void WeakProcessor::Task::work(uint worker_id,
     } else {
       WeakProcessorPhaseTimeTracker pt(_phase_times, phase, worker_id);
       uint storage_index = WeakProcessorPhases::oop_storage_index(phase);
-      _storage_states[storage_index].weak_oops_do(is_alive, keep_alive);
+      CountingIsAliveClosure<IsAlive> cl(is_alive);
+      _storage_states[storage_index].weak_oops_do(&cl, keep_alive);
+      _storage_states[storage_index].increment_num_dead(cl.num_dead());
+      if (_phase_times != NULL) {
+        _phase_times->record_worker_items(worker_id, phase, cl.num_dead(), cl.num_total());
+      }
     }
   }
 
@@ -89,6 +117,7 @@ public:
   {}
 
   virtual void work(uint worker_id);
+  void report_num_dead() { _task.report_num_dead(); }
 };
 
 template<typename IsAlive, typename KeepAlive>
@@ -103,6 +132,7 @@ void WeakProcessor::weak_oops_do(WorkGang* workers,
 
   GangTask task("Weak Processor", is_alive, keep_alive, phase_times, nworkers);
   workers->run_task(&task, nworkers);
+  task.report_num_dead();
 }
 
 template<typename IsAlive, typename KeepAlive>
@@ -61,17 +61,21 @@ WeakProcessorPhaseTimes::WeakProcessorPhaseTimes(uint max_threads) :
   _max_threads(max_threads),
   _active_workers(0),
   _total_time_sec(uninitialized_time),
-  _worker_phase_times_sec()
+  _worker_phase_times_sec(),
+  _worker_dead_items(),
+  _worker_total_items()
 {
   assert(_max_threads > 0, "max_threads must not be zero");
 
   reset_times(_phase_times_sec, ARRAY_SIZE(_phase_times_sec));
 
-  if (_max_threads > 1) {
-    WorkerDataArray<double>** wpt = _worker_phase_times_sec;
-    FOR_EACH_WEAK_PROCESSOR_OOP_STORAGE_PHASE(phase) {
+  FOR_EACH_WEAK_PROCESSOR_OOP_STORAGE_PHASE(phase) {
+    uint index = WeakProcessorPhases::oop_storage_index(phase);
+    _worker_dead_items[index] = new WorkerDataArray<size_t>(_max_threads, "Dead Items:");
+    _worker_total_items[index] = new WorkerDataArray<size_t>(_max_threads, "Total Items:");
+    if (_max_threads > 1) {
       const char* description = WeakProcessorPhases::description(phase);
-      *wpt++ = new WorkerDataArray<double>(_max_threads, description);
+      _worker_phase_times_sec[index] = new WorkerDataArray<double>(_max_threads, description);
     }
   }
 }
@@ -79,6 +83,8 @@ WeakProcessorPhaseTimes::WeakProcessorPhaseTimes(uint max_threads) :
 WeakProcessorPhaseTimes::~WeakProcessorPhaseTimes() {
   for (size_t i = 0; i < ARRAY_SIZE(_worker_phase_times_sec); ++i) {
     delete _worker_phase_times_sec[i];
+    delete _worker_dead_items[i];
+    delete _worker_total_items[i];
   }
 }
 
@@ -100,10 +106,12 @@ void WeakProcessorPhaseTimes::reset() {
   _active_workers = 0;
   _total_time_sec = uninitialized_time;
   reset_times(_phase_times_sec, ARRAY_SIZE(_phase_times_sec));
-  if (_max_threads > 1) {
-    for (size_t i = 0; i < ARRAY_SIZE(_worker_phase_times_sec); ++i) {
+  for (size_t i = 0; i < ARRAY_SIZE(_worker_phase_times_sec); ++i) {
+    if (_max_threads > 1) {
       _worker_phase_times_sec[i]->reset();
     }
+    _worker_dead_items[i]->reset();
+    _worker_total_items[i]->reset();
   }
 }
 
@@ -155,6 +163,18 @@ void WeakProcessorPhaseTimes::record_worker_time_sec(uint worker_id,
   }
 }
 
+void WeakProcessorPhaseTimes::record_worker_items(uint worker_id,
+                                                  WeakProcessorPhase phase,
+                                                  size_t num_dead,
+                                                  size_t num_total) {
+  assert_oop_storage_phase(phase);
+  assert(worker_id < active_workers(),
+         "invalid worker id %u for %u", worker_id, active_workers());
+  uint index = WeakProcessorPhases::oop_storage_index(phase);
+  _worker_dead_items[index]->set(worker_id, num_dead);
+  _worker_total_items[index]->set(worker_id, num_total);
+}
+
 static double elapsed_time_sec(Ticks start_time, Ticks end_time) {
   return (end_time - start_time).seconds();
 }
@@ -241,6 +261,25 @@ void WeakProcessorPhaseTimes::log_mt_phase_details(WeakProcessorPhase phase,
   worker_data(phase)->print_details_on(&ls);
 }
 
+void WeakProcessorPhaseTimes::log_phase_items(WeakProcessorPhase phase,
+                                              uint indent,
+                                              bool details) const {
+  uint index = WeakProcessorPhases::oop_storage_index(phase);
+  WorkerDataArray<size_t>* items[] = { _worker_dead_items[index], _worker_total_items[index] };
+  for (size_t i = 0; i < ARRAY_SIZE(items); ++i) {
+    LogTarget(Debug, gc, phases) lt;
+    LogStream ls(lt);
+    ls.print("%s", indent_str(indent));
+    items[i]->print_summary_on(&ls, true);
+    if (details) {
+      LogTarget(Trace, gc, phases) ltt;
+      LogStream lst(ltt);
+      lst.print("%s", indent_str(indent + 1));
+      items[i]->print_details_on(&lst);
+    }
+  }
+}
+
 void WeakProcessorPhaseTimes::log_print_phases(uint indent) const {
   if (log_is_enabled(Debug, gc, phases)) {
     bool details_enabled = log_is_enabled(Trace, gc, phases);
@@ -253,6 +292,9 @@ void WeakProcessorPhaseTimes::log_print_phases(uint indent) const {
           log_mt_phase_details(phase, indent + 1);
         }
       }
+      if (!is_serial_phase(phase)) {
+        log_phase_items(phase, indent + 1, details_enabled && (active_workers() > 1));
+      }
     }
   }
 }
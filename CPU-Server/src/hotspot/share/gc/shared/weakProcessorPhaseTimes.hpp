@@ -47,11 +47,18 @@ class WeakProcessorPhaseTimes : public CHeapObj<mtGC> {
   // Per-worker times, if multiple threads used and the phase was executed.
   WorkerDataArray<double>* _worker_phase_times_sec[WeakProcessorPhases::oop_storage_phase_count];
 
+  // Per-worker number of entries found dead and number of entries
+  // examined, for each OopStorage phase.  Unlike times, these are also
+  // recorded if only one thread is used.
+  WorkerDataArray<size_t>* _worker_dead_items[WeakProcessorPhases::oop_storage_phase_count];
+  WorkerDataArray<size_t>* _worker_total_items[WeakProcessorPhases::oop_storage_phase_count];
+
   WorkerDataArray<double>* worker_data(WeakProcessorPhase phase) const;
 
   void log_st_phase(WeakProcessorPhase phase, uint indent) const;
   void log_mt_phase_summary(WeakProcessorPhase phase, uint indent) const;
   void log_mt_phase_details(WeakProcessorPhase phase, uint indent) const;
+  void log_phase_items(WeakProcessorPhase phase, uint indent, bool details) const;
 
 public:
   WeakProcessorPhaseTimes(uint max_threads);
@@ -68,6 +75,8 @@ public:
   void record_total_time_sec(double time_sec);
   void record_phase_time_sec(WeakProcessorPhase phase, double time_sec);
   void record_worker_time_sec(uint worker_id, WeakProcessorPhase phase, double time_sec);
+  // Precondition: WeakProcessorPhases::is_oop_storage(phase)
+  void record_worker_items(uint worker_id, WeakProcessorPhase phase, size_t num_dead, size_t num_total);
 
   void reset();
 
@@ -35,8 +35,8 @@ class ShenandoahBarrierSet: public BarrierSet {
 public:
   enum ArrayCopyStoreValMode {
     NONE,
-    READ_BARRIER,
-    WRITE_BARRIER
+    RESOLVE_BARRIER,
+    EVAC_BARRIER
   };
 private:
 
@@ -88,34 +88,29 @@ public:
   virtual void on_thread_attach(JavaThread* thread);
   virtual void on_thread_detach(JavaThread* thread);
 
-  virtual oop read_barrier(oop src);
-
   static inline oop resolve_forwarded_not_null(oop p);
   static inline oop resolve_forwarded(oop p);
 
-  virtual oop write_barrier(oop obj);
-
-  oop write_barrier_mutator(oop obj);
+  // Load reference barrier: makes sure that the reference loaded from the heap
+  // points to the to-space copy of the object, evacuating it if necessary.
+  oop load_reference_barrier(oop obj);
+  oop load_reference_barrier_not_null(oop obj);
 
-  virtual oop storeval_barrier(oop obj);
+  oop load_reference_barrier_mutator(oop obj);
 
-  virtual void keep_alive_barrier(oop obj);
+  void storeval_barrier(oop obj);
 
-  bool obj_equals(oop obj1, oop obj2);
-
-#ifdef CHECK_UNHANDLED_OOPS
-  bool oop_equals_operator_allowed() { return !ShenandoahVerifyObjectEquals; }
-#endif
+  void keep_alive_barrier(oop obj);
 
   void enqueue(oop obj);
 
 private:
   inline bool need_update_refs_barrier();
 
-  template <class T, bool STOREVAL_WRITE_BARRIER>
+  template <class T, bool STOREVAL_EVAC_BARRIER>
   void write_ref_array_loop(HeapWord* start, size_t count);
 
-  oop write_barrier_impl(oop obj);
+  oop load_reference_barrier_impl(oop obj);
 
   static void keep_alive_if_weak(DecoratorSet decorators, oop value) {
     assert((decorators & ON_UNKNOWN_OOP_REF) == 0, "Reference strength must be known");
@@ -162,7 +157,6 @@ public:
 
     template <typename T>
     static T load_in_heap_at(oop base, ptrdiff_t offset) {
-      base = ShenandoahBarrierSet::resolve_forwarded(base);
       return Raw::template load_at<T>(base, offset);
     }
 
@@ -174,7 +168,6 @@ public:
 
     template <typename T>
     static void store_in_heap_at(oop base, ptrdiff_t offset, T value) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
       Raw::store_at(base, offset, value);
     }
 
@@ -186,7 +179,6 @@ public:
 
     template <typename T>
     static T atomic_cmpxchg_in_heap_at(T new_value, oop base, ptrdiff_t offset, T compare_value) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
       return Raw::atomic_cmpxchg_at(new_value, base, offset, compare_value);
     }
 
@@ -198,7 +190,6 @@ public:
 
     template <typename T>
     static T atomic_xchg_in_heap_at(T new_value, oop base, ptrdiff_t offset) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
       return Raw::atomic_xchg_at(new_value, base, offset);
     }
 
@@ -212,15 +203,15 @@ public:
     // an oop_* overload, and the barrier strength is AS_NORMAL.
     template <typename T>
     static oop oop_load_in_heap(T* addr) {
-      // ShouldNotReachHere();
       oop value = Raw::template oop_load<oop>(addr);
+      value = ShenandoahBarrierSet::barrier_set()->load_reference_barrier(value);
       keep_alive_if_weak(decorators, value);
       return value;
     }
 
     static oop oop_load_in_heap_at(oop base, ptrdiff_t offset) {
-      base = ShenandoahBarrierSet::resolve_forwarded(base);
       oop value = Raw::template oop_load_at<oop>(base, offset);
+      value = ShenandoahBarrierSet::barrier_set()->load_reference_barrier(value);
       keep_alive_if_weak(AccessBarrierSupport::resolve_possibly_unknown_oop_ref_strength<decorators>(base, offset), value);
       return value;
     }
@@ -235,9 +226,7 @@ public:
     }
 
     static void oop_store_in_heap_at(oop base, ptrdiff_t offset, oop value) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
-      value = ShenandoahBarrierSet::barrier_set()->storeval_barrier(value);
-
+      ShenandoahBarrierSet::barrier_set()->storeval_barrier(value);
       oop_store_in_heap(AccessInternal::oop_field_addr<decorators>(base, offset), value);
     }
 
@@ -245,8 +234,7 @@ public:
     static oop oop_atomic_cmpxchg_in_heap(oop new_value, T* addr, oop compare_value);
 
     static oop oop_atomic_cmpxchg_in_heap_at(oop new_value, oop base, ptrdiff_t offset, oop compare_value) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
-      new_value = ShenandoahBarrierSet::barrier_set()->storeval_barrier(new_value);
+      ShenandoahBarrierSet::barrier_set()->storeval_barrier(new_value);
       return oop_atomic_cmpxchg_in_heap(new_value, AccessInternal::oop_field_addr<decorators>(base, offset), compare_value);
     }
 
@@ -254,8 +242,7 @@ public:
     static oop oop_atomic_xchg_in_heap(oop new_value, T* addr);
 
     static oop oop_atomic_xchg_in_heap_at(oop new_value, oop base, ptrdiff_t offset) {
-      base = ShenandoahBarrierSet::barrier_set()->write_barrier(base);
-      new_value = ShenandoahBarrierSet::barrier_set()->storeval_barrier(new_value);
+      ShenandoahBarrierSet::barrier_set()->storeval_barrier(new_value);
       return oop_atomic_xchg_in_heap(new_value, AccessInternal::oop_field_addr<decorators>(base, offset));
     }
 
@@ -271,18 +258,14 @@ public:
     template <typename T>
     static oop oop_load_not_in_heap(T* addr) {
       oop value = Raw::oop_load_not_in_heap(addr);
+      value = ShenandoahBarrierSet::barrier_set()->load_reference_barrier(value);
       keep_alive_if_weak(decorators, value);
       return value;
     }
 
     static oop resolve(oop obj) {
-      return ShenandoahBarrierSet::barrier_set()->write_barrier(obj);
+      return ShenandoahBarrierSet::barrier_set()->load_reference_barrier(obj);
     }
-
-    static bool equals(oop o1, oop o2) {
-      return ShenandoahBarrierSet::barrier_set()->obj_equals(o1, o2);
-    }
-
   };
 
 };
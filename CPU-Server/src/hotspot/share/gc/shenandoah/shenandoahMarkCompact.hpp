@@ -40,20 +40,26 @@
  * 1. Mark all live objects of the heap by traversing objects starting at GC roots.
  * 2. Calculate the new location of each live object. This is done by sequentially scanning
  *    the heap, keeping track of a next-location-pointer, which is then written to each
- *    object's fwdptr field.
+ *    object's mark word. Mark words that carry information are preserved aside.
  * 3. Update all references. This is implemented by another scan of the heap, and updates
- *    all references in live objects by what's stored in the target object's fwdptr.
- * 4. Compact the heap by copying all live objects to their new location.
+ *    all references in live objects by what's stored in the target object's mark word.
+ * 4. Compact the heap by copying all live objects to their new location, and restore
+ *    the preserved mark words.
  *
  * Parallelization is handled by assigning each GC worker the slice of the heap (the set of regions)
  * where it does sliding compaction, without interfering with other threads.
  */
 
+class PreservedMarksSet;
+
 class ShenandoahMarkCompact : public CHeapObj<mtGC> {
 private:
   GCTimer* _gc_timer;
 
+  PreservedMarksSet* _preserved_marks;
+
 public:
+  ShenandoahMarkCompact();
   void initialize(GCTimer* gc_timer);
   void do_it(GCCause::Cause gc_cause);
 
@@ -252,6 +252,10 @@ void ZHeap::release_page(ZPage* page, bool reclaimed) {
   }
 }
 
+uint64_t ZHeap::uncommit(uint64_t delay) {
+  return _page_allocator.uncommit(delay);
+}
+
 void ZHeap::flip_views() {
   // For debugging only
   if (ZUnmapBadViews) {
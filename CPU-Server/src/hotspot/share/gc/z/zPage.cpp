@@ -51,7 +51,8 @@ ZPage::ZPage(uint8_t type, ZVirtualMemory vmem, ZPhysicalMemory pmem) :
     _livemap(object_max_count()),
     _refcount(0),
     _forwarding(),
-    _physical(pmem) {
+    _physical(pmem),
+    _last_used(0) {
   assert(!_physical.is_null(), "Should not be null");
   assert(!_virtual.is_null(), "Should not be null");
   assert((type == ZPageTypeSmall && size() == ZPageSizeSmall) ||
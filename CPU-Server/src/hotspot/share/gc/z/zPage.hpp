@@ -49,6 +49,7 @@ private:
   volatile uint32_t    _refcount;         // Page reference count
   ZForwardingTable     _forwarding;       // Forwarding table
   ZPhysicalMemory      _physical;         // Physical memory for page
+  uint64_t             _last_used;        // Last used time, when cached (in seconds)
   ZListNode<ZPage>     _node;             // Page list node
 
   const char* type_to_string() const;
@@ -77,6 +78,9 @@ public:
   ZPhysicalMemory& physical_memory();
   const ZVirtualMemory& virtual_memory() const;
 
+  uint64_t last_used() const;
+  void set_last_used();
+
   void reset();
 
   bool inc_refcount();
@@ -36,6 +36,7 @@
 #include "gc/z/zVirtualMemory.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 
@@ -125,6 +126,14 @@ inline const ZVirtualMemory& ZPage::virtual_memory() const {
   return _virtual;
 }
 
+inline uint64_t ZPage::last_used() const {
+  return _last_used;
+}
+
+inline void ZPage::set_last_used() {
+  _last_used = os::elapsedTime();
+}
+
 inline uint8_t ZPage::numa_id() {
   if (_numa_id == (uint8_t)-1) {
     _numa_id = (uint8_t)ZNUMA::memory_id(ZAddress::good(start()));
@@ -34,8 +34,11 @@
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTracer.inline.hpp"
 #include "runtime/init.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
 
 static const ZStatCounter       ZCounterAllocationRate("Memory", "Allocation Rate", ZStatUnitBytesPerSecond);
+static const ZStatCounter       ZCounterUncommit("Memory", "Uncommit", ZStatUnitBytesPerSecond);
 static const ZStatCriticalPhase ZCriticalPhaseAllocationStall("Allocation Stall");
 
 class ZPageAllocRequest : public StackObj {
@@ -88,6 +91,7 @@ ZPageAllocator::ZPageAllocator(size_t min_capacity, size_t max_capacity, size_t
     _virtual(),
     _physical(max_capacity, ZPageSizeMin),
     _cache(),
+    _min_capacity(min_capacity),
     _max_reserve(max_reserve),
     _pre_mapped(_virtual, _physical, try_ensure_unused_for_pre_mapped(min_capacity)),
     _used_high(0),
@@ -96,7 +100,17 @@ ZPageAllocator::ZPageAllocator(size_t min_capacity, size_t max_capacity, size_t
     _allocated(0),
     _reclaimed(0),
     _queue(),
-    _detached() {}
+    _detached() {
+
+  if (!is_initialized()) {
+    return;
+  }
+
+  log_info(gc, init)("Uncommit: %s", ZUncommit ? "Enabled" : "Disabled");
+  if (ZUncommit) {
+    log_info(gc, init)("Uncommit Delay: " UINTX_FORMAT "s", ZUncommitDelay);
+  }
+}
 
 bool ZPageAllocator::is_initialized() const {
   return _physical.is_initialized() &&
@@ -104,6 +118,10 @@ bool ZPageAllocator::is_initialized() const {
          _pre_mapped.is_initialized();
 }
 
+size_t ZPageAllocator::min_capacity() const {
+  return _min_capacity;
+}
+
 size_t ZPageAllocator::max_capacity() const {
   return _physical.max_capacity();
 }
@@ -272,16 +290,141 @@ void ZPageAllocator::flush_detached_pages(ZList<ZPage>* list) {
   list->transfer(&_detached);
 }
 
-void ZPageAllocator::flush_cache(size_t size) {
+void ZPageAllocator::flush_cache(ZPageCacheFlushClosure* cl) {
   ZList<ZPage> list;
 
-  _cache.flush(&list, size);
+  _cache.flush(cl, &list);
 
   for (ZPage* page = list.remove_first(); page != NULL; page = list.remove_first()) {
     detach_page(page);
   }
 }
 
+class ZPageCacheFlushForAllocationClosure : public ZPageCacheFlushClosure {
+public:
+  ZPageCacheFlushForAllocationClosure(size_t requested) :
+      ZPageCacheFlushClosure(requested) {}
+
+  virtual bool do_page(const ZPage* page) {
+    if (_flushed < _requested) {
+      // Flush page
+      _flushed += page->size();
+      return true;
+    }
+
+    // Don't flush page
+    return false;
+  }
+};
+
+void ZPageAllocator::flush_cache_for_allocation(size_t requested) {
+  assert(requested <= _cache.available(), "Invalid request");
+
+  // Flush pages
+  ZPageCacheFlushForAllocationClosure cl(requested);
+  flush_cache(&cl);
+
+  log_info(gc, heap)("Page Cache Flushed: "
+                     SIZE_FORMAT "M requested, "
+                     SIZE_FORMAT "M(" SIZE_FORMAT "M->" SIZE_FORMAT "M) flushed",
+                     requested / M, cl.flushed() / M,
+                     (_cache.available() + cl.flushed()) / M, _cache.available() / M);
+}
+
+class ZPageCacheFlushForUncommitClosure : public ZPageCacheFlushClosure {
+private:
+  const uint64_t _now;
+  const uint64_t _delay;
+  uint64_t       _timeout;
+
+public:
+  ZPageCacheFlushForUncommitClosure(size_t requested, uint64_t delay) :
+      ZPageCacheFlushClosure(requested),
+      _now(os::elapsedTime()),
+      _delay(delay),
+      _timeout(_delay) {}
+
+  virtual bool do_page(const ZPage* page) {
+    const uint64_t expires = page->last_used() + _delay;
+    const uint64_t timeout = expires - MIN2(expires, _now);
+
+    if (_flushed < _requested && timeout == 0) {
+      // Flush page
+      _flushed += page->size();
+      return true;
+    }
+
+    // Record shortest non-expired timeout
+    _timeout = MIN2(_timeout, timeout);
+
+    // Don't flush page
+    return false;
+  }
+
+  uint64_t timeout() const {
+    return _timeout;
+  }
+};
+
+uint64_t ZPageAllocator::uncommit(uint64_t delay) {
+  // Set the default timeout, when no pages are found in the
+  // cache or when uncommit is disabled, equal to the delay.
+  uint64_t timeout = delay;
+
+  if (!ZUncommit) {
+    // Disabled
+    return timeout;
+  }
+
+  size_t capacity_before;
+  size_t capacity_after;
+  size_t uncommitted;
+
+  {
+    ZLocker<ZLock> locker(&_lock);
+
+    // Don't uncommit while there are stalled allocations, or if the
+    // pre-mapped memory has not yet been handed out or flushed.
+    if (!_queue.is_empty() || _pre_mapped.available() > 0) {
+      return timeout;
+    }
+
+    // Never uncommit the reserve, and never uncommit below min capacity
+    const size_t needed = MIN2(used() + max_reserve(), current_max_capacity());
+    const size_t guarded = MAX2(needed, _min_capacity);
+    const size_t uncommittable = _cache.available();
+    const size_t uncommit = MIN2(uncommittable, capacity() - MIN2(capacity(), guarded));
+
+    // Limit the amount of memory uncommitted per round, to avoid
+    // holding the lock, and blocking allocations, for too long.
+    const size_t limit = MIN2(align_up(current_max_capacity() >> 7, ZPageSizeMin), 256 * M);
+
+    // Flush pages that have been unused for longer than the delay
+    ZPageCacheFlushForUncommitClosure cl(MIN2(uncommit, limit), delay);
+    flush_cache(&cl);
+
+    // Uncommit the physical memory of the flushed pages
+    capacity_before = capacity();
+    uncommitted = _physical.try_uncommit_unused_capacity(cl.flushed());
+    capacity_after = capacity();
+
+    // Update timeout
+    timeout = cl.timeout();
+  }
+
+  if (uncommitted > 0) {
+    // Update statistics
+    ZStatInc(ZCounterUncommit, uncommitted);
+    log_info(gc, heap)("Capacity: " SIZE_FORMAT "M(%.0lf%%)->" SIZE_FORMAT "M(%.0lf%%), "
+                       "Uncommitted: " SIZE_FORMAT "M",
+                       capacity_before / M, percent_of(capacity_before, max_capacity()),
+                       capacity_after / M, percent_of(capacity_after, max_capacity()),
+                       uncommitted / M);
+  }
+
+  return timeout;
+}
+
 void ZPageAllocator::check_out_of_memory_during_initialization() {
   if (!is_init_completed()) {
     vm_exit_during_initialization("java.lang.OutOfMemoryError", "Java heap too small");
@@ -315,7 +458,7 @@ ZPage* ZPageAllocator::alloc_page_common_inner(uint8_t type, size_t size, ZAlloc
   const size_t unused = try_ensure_unused(size, flags.no_reserve());
   if (unused < size) {
     // Flush cache to free up more physical memory
-    flush_cache(size - unused);
+    flush_cache_for_allocation(size - unused);
   }
 
   // Create new page and allocate physical memory
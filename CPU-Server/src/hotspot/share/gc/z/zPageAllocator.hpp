@@ -43,6 +43,7 @@ private:
   ZVirtualMemoryManager    _virtual;
   ZPhysicalMemoryManager   _physical;
   ZPageCache               _cache;
+  const size_t             _min_capacity;
   const size_t             _max_reserve;
   ZPreMappedMemory         _pre_mapped;
   size_t                   _used_high;
@@ -66,7 +67,8 @@ private:
   void map_page(ZPage* page);
   void detach_page(ZPage* page);
   void flush_pre_mapped();
-  void flush_cache(size_t size);
+  void flush_cache(ZPageCacheFlushClosure* cl);
+  void flush_cache_for_allocation(size_t requested);
 
   void check_out_of_memory_during_initialization();
 
@@ -84,6 +86,7 @@ public:
 
   bool is_initialized() const;
 
+  size_t min_capacity() const;
   size_t max_capacity() const;
   size_t current_max_capacity() const;
   size_t capacity() const;
@@ -103,6 +106,8 @@ public:
 
   void flush_detached_pages(ZList<ZPage>* list);
 
+  uint64_t uncommit(uint64_t delay);
+
   void flip_pre_mapped();
 
   bool is_alloc_stalled() const;
@@ -118,7 +118,7 @@ void ZPhysicalMemoryManager::try_ensure_unused_capacity(size_t size) {
   // Try to expand
   const size_t old_capacity = capacity();
   const size_t new_capacity = MIN2(old_capacity + size - unused, current_max);
-  _capacity = _backing.try_expand(old_capacity, new_capacity);
+  _capacity += _backing.commit(new_capacity - old_capacity);
 
   if (_capacity != new_capacity) {
     // Failed, or partly failed, to expand
@@ -132,6 +132,13 @@ void ZPhysicalMemoryManager::try_ensure_unused_capacity(size_t size) {
   }
 }
 
+size_t ZPhysicalMemoryManager::try_uncommit_unused_capacity(size_t size) {
+  // Never uncommit more than the currently unused capacity
+  const size_t uncommitted = _backing.uncommit(MIN2(size, unused_capacity()));
+  _capacity -= uncommitted;
+  return uncommitted;
+}
+
 void ZPhysicalMemoryManager::nmt_commit(ZPhysicalMemory pmem, uintptr_t offset) {
   const uintptr_t addr = _backing.nmt_address(offset);
   const size_t size = pmem.size();
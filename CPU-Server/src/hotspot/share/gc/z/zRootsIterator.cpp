@@ -333,12 +333,10 @@ ZConcurrentWeakRootsIterator::ZConcurrentWeakRootsIterator() :
     _string_table_iter(StringTable::weak_storage()),
     _vm_weak_handles(this),
     _jni_weak_handles(this),
-    _string_table(this) {
-  StringTable::reset_dead_counter();
-}
+    _string_table(this) {}
 
 ZConcurrentWeakRootsIterator::~ZConcurrentWeakRootsIterator() {
-  StringTable::finish_dead_counter();
+  _string_table_iter.report_num_dead();
 }
 
 void ZConcurrentWeakRootsIterator::do_vm_weak_handles(ZRootsIteratorClosure* cl) {
@@ -354,15 +352,17 @@ void ZConcurrentWeakRootsIterator::do_jni_weak_handles(ZRootsIteratorClosure* cl
 class ZStringTableDeadCounterClosure : public ZRootsIteratorClosure  {
 private:
   ZRootsIteratorClosure* const _cl;
+  ZOopStorageIterator* const   _iter;
   size_t                       _ndead;
 
 public:
-  ZStringTableDeadCounterClosure(ZRootsIteratorClosure* cl) :
+  ZStringTableDeadCounterClosure(ZRootsIteratorClosure* cl, ZOopStorageIterator* iter) :
       _cl(cl),
+      _iter(iter),
       _ndead(0) {}
 
   ~ZStringTableDeadCounterClosure() {
-    StringTable::inc_dead_counter(_ndead);
+    _iter->increment_num_dead(_ndead);
   }
 
   virtual void do_oop(oop* p) {
@@ -379,7 +379,7 @@ public:
 
 void ZConcurrentWeakRootsIterator::do_string_table(ZRootsIteratorClosure* cl) {
   ZStatTimer timer(ZSubPhaseConcurrentWeakRootsStringTable);
-  ZStringTableDeadCounterClosure counter_cl(cl);
+  ZStringTableDeadCounterClosure counter_cl(cl, &_string_table_iter);
   _string_table_iter.oops_do(&counter_cl);
 }
 
@@ -33,6 +33,7 @@
 #include "runtime/thread.inline.hpp"
 
 static jbyteArray _metadata_blob = NULL;
+static volatile bool _metadata_updated = false;
 static Semaphore metadata_mutex_semaphore(1);
 
 void JfrMetadataEvent::lock() {
@@ -68,6 +69,7 @@ size_t JfrMetadataEvent::write(JfrChunkWriter& chunkwriter, jlong metadata_offse
   chunkwriter.write((u8)0); // duration
   chunkwriter.write((u8)0); // metadata id
   write_metadata_blob(chunkwriter, _metadata_blob); // payload
+  _metadata_updated = false;
   unlock(); // open up for java to provide updated metadata
   // fill in size of metadata descriptor event
   const jlong size_written = chunkwriter.current_offset() - metadata_offset;
@@ -85,5 +87,10 @@ void JfrMetadataEvent::update(jbyteArray metadata) {
   }
   const oop new_desc_oop = JfrJavaSupport::resolve_non_null(metadata);
   _metadata_blob = new_desc_oop != NULL ? (jbyteArray)JfrJavaSupport::global_jni_handle(new_desc_oop, thread) : NULL;
+  _metadata_updated = true;
   unlock();
 }
+
+bool JfrMetadataEvent::is_updated() {
+  return _metadata_updated;
+}
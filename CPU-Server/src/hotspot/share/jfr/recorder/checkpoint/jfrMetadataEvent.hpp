@@ -41,6 +41,8 @@ class JfrMetadataEvent : AllStatic {
   static void unlock();
   static size_t write(JfrChunkWriter& writer, jlong metadata_offset);
   static void update(jbyteArray metadata);
+  // true if Java provided new metadata since the last write
+  static bool is_updated();
 };
 
 #endif // SHARE_VM_JFR_RECORDER_CHECKPOINT_JFRMETADATAEVENT_HPP
@@ -37,6 +37,10 @@ static const u2 JFR_VERSION_MINOR = 0;
 static const size_t MAGIC_LEN = 4;
 static const size_t FILEHEADER_SLOT_SIZE = 8;
 static const size_t CHUNK_SIZE_OFFSET = 8;
+// first byte of the u4 chunk capabilities, which is otherwise always zero
+static const size_t FILE_STATE_OFFSET = CHUNK_SIZE_OFFSET + (7 * FILEHEADER_SLOT_SIZE);
+static const u1 COMPLETE = 0;
+static const u1 GUARD = 0xff;
 
 JfrChunkWriter::JfrChunkWriter() : JfrChunkWriterBase(NULL), _chunkstate(NULL) {}
 
@@ -85,6 +89,36 @@ size_t JfrChunkWriter::close(int64_t metadata_offset) {
   return (size_t)size_written();
 }
 
+//
+// Publishes everything written so far as a flush point of the chunk that
+// is still being written. The header then describes a chunk ending at the
+// current offset, so the file can be read up to that point while the
+// recording continues.
+//
+// The header fields are separate writes, so a concurrent reader could see
+// fields of two flush points. The file state byte is set to GUARD while the
+// header is updated and back to COMPLETE afterwards (each write_be_at_offset
+// reaches the file before the next one). A reader reads the file state and
+// the chunk size, then the header, then both again, and uses the header
+// only if the file state was COMPLETE and the chunk size did not change.
+//
+int64_t JfrChunkWriter::flush_chunk(int64_t metadata_offset) {
+  assert(this->is_valid(), "invariant");
+  assert(metadata_offset > 0, "invariant");
+  _chunkstate->set_metadata_offset(metadata_offset);
+  this->flush();
+  const int64_t chunk_size = size_written();
+  this->write_be_at_offset(GUARD, FILE_STATE_OFFSET);
+  this->write_be_at_offset(_chunkstate->previous_checkpoint_offset(), CHUNK_SIZE_OFFSET + (1 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(metadata_offset, CHUNK_SIZE_OFFSET + (2 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(_chunkstate->start_nanos(), CHUNK_SIZE_OFFSET + (3 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(_chunkstate->current_chunk_duration(), CHUNK_SIZE_OFFSET + (4 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(_chunkstate->start_ticks(), CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
+  this->write_be_at_offset(chunk_size, CHUNK_SIZE_OFFSET);
+  this->write_be_at_offset(COMPLETE, FILE_STATE_OFFSET);
+  return chunk_size;
+}
+
 void JfrChunkWriter::write_header(int64_t metadata_offset) {
   assert(this->is_valid(), "invariant");
   // Chunk size
@@ -117,6 +151,10 @@ void JfrChunkWriter::set_previous_checkpoint_offset(int64_t offset) {
   _chunkstate->set_previous_checkpoint_offset(offset);
 }
 
+int64_t JfrChunkWriter::metadata_offset() const {
+  return _chunkstate->metadata_offset();
+}
+
 void JfrChunkWriter::time_stamp_chunk_now() {
   _chunkstate->update_time_to_now();
 }
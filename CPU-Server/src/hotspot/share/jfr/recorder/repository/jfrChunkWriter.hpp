@@ -42,6 +42,7 @@ class JfrChunkWriter : public JfrChunkWriterBase {
 
   bool open();
   size_t close(int64_t metadata_offset);
+  int64_t flush_chunk(int64_t metadata_offset);
   void write_header(int64_t metadata_offset);
   void set_chunk_path(const char* chunk_path);
 
@@ -51,6 +52,7 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   int64_t size_written() const;
   int64_t previous_checkpoint_offset() const;
   void set_previous_checkpoint_offset(int64_t offset);
+  int64_t metadata_offset() const;
   void time_stamp_chunk_now();
 };
 
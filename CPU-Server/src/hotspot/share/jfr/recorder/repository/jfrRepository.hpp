@@ -56,6 +56,7 @@ class JfrRepository : public JfrCHeapObj {
   void set_chunk_path(const char* path);
   bool open_chunk(bool vm_error = false);
   size_t close_chunk(int64_t metadata_offset);
+  int64_t flush_chunk(int64_t metadata_offset);
   void on_vm_error();
   static void notify_on_new_chunk_path();
   static JfrChunkWriter& chunkwriter();
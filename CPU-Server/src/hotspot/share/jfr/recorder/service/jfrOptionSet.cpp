@@ -102,6 +102,14 @@ void JfrOptionSet::set_old_object_queue_size(jlong value) {
   _old_object_queue_size = value;
 }
 
+jlong JfrOptionSet::flush_interval() {
+  return _flush_interval;
+}
+
+void JfrOptionSet::set_flush_interval(jlong millis) {
+  _flush_interval = millis;
+}
+
 u4 JfrOptionSet::stackdepth() {
   return _stack_depth;
 }
@@ -174,6 +182,7 @@ const char* const default_sample_threads = "true";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
+const char* const default_flush_interval = "0";
 DEBUG_ONLY(const char* const default_sample_protection = "false";)
 
 // statics
@@ -226,6 +235,13 @@ static DCmdArgument<jlong> _dcmd_old_object_queue_size (
   false,
   default_old_object_queue_size);
 
+static DCmdArgument<NanoTimeArgument> _dcmd_flush_interval(
+  "flush-interval",
+  "How often the current disk chunk is made readable while it is written, at least 1 s, 0 to only do it when the chunk is complete. Every flush is a safepoint",
+  "NANOTIME",
+  false,
+  default_flush_interval);
+
 static DCmdArgument<bool> _dcmd_sample_threads(
   "samplethreads",
   "Thread sampling enable / disable (only sampling when event enabled and sampling enabled)",
@@ -269,6 +285,7 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_sample_threads);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
+  _parser.add_dcmd_option(&_dcmd_flush_interval);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
 }
 
@@ -307,6 +324,7 @@ jlong JfrOptionSet::_thread_buffer_size = 0;
 jlong JfrOptionSet::_memory_size = 0;
 jlong JfrOptionSet::_num_global_buffers = 0;
 jlong JfrOptionSet::_old_object_queue_size = 0;
+jlong JfrOptionSet::_flush_interval = 0;
 u4 JfrOptionSet::_stack_depth = STACK_DEPTH_DEFAULT;
 jboolean JfrOptionSet::_sample_threads = JNI_TRUE;
 jboolean JfrOptionSet::_retransform = JNI_TRUE;
@@ -325,6 +343,17 @@ bool JfrOptionSet::initialize(Thread* thread) {
     set_retransform(_dcmd_retransform.value());
   }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
+  const jlong flush_interval_nanos = _dcmd_flush_interval.value()._nanotime;
+  if (flush_interval_nanos < 0) {
+    log_error(arguments) ("FlightRecorderOptions flush-interval must not be negative");
+    return false;
+  }
+  // every flush shifts the epoch in a safepoint, see JfrRecorderService::flush()
+  if (flush_interval_nanos != 0 && flush_interval_nanos < NANOSECS_PER_SEC) {
+    log_error(arguments) ("FlightRecorderOptions flush-interval must be 0 or at least 1 s");
+    return false;
+  }
+  set_flush_interval(flush_interval_nanos / NANOSECS_PER_MILLISEC);
   return adjust_memory_options();
 }
 
@@ -501,6 +501,88 @@ void JfrRecorderService::post_safepoint_write() {
   assert(!_chunkwriter.is_valid(), "invariant");
 }
 
+//
+// A flush writes the same content as a chunk rotation, but leaves the chunk
+// open and only updates its header to make the flushed data readable.
+//
+// The bulk of the data, the storage, the string pool and the stack traces,
+// is written before the safepoint by pre_safepoint_write(), and the type
+// set and checkpoints after it. The safepoint itself only writes what was
+// recorded in the meantime and shifts the epoch. The epoch shift is what
+// makes the classes and methods tagged by the flushed events writable, so
+// it cannot be avoided. Every flush therefore costs one VM operation, which
+// is why flush intervals below one second are rejected.
+//
+void JfrRecorderService::flush() {
+  RotationLock rl(Thread::current());
+  if (rl.not_acquired()) {
+    return;
+  }
+  if (!is_recording() || !_chunkwriter.is_valid()) {
+    // nothing to flush for in-memory recordings
+    return;
+  }
+  ResourceMark rm;
+  HandleMark hm;
+  pre_safepoint_write();
+  invoke_safepoint_flush();
+  post_safepoint_flush();
+}
+
+void JfrRecorderService::invoke_safepoint_flush() {
+  JfrVMOperation<JfrRecorderService, &JfrRecorderService::safepoint_flush> safepoint_task(*this);
+  VMThread::execute(&safepoint_task);
+}
+
+//
+// safepoint flush sequence
+//
+//   lock stream lock ->
+//     write object sample stacktraces ->
+//       write stacktrace repository ->
+//         write string pool ->
+//           write safepoint dependent types ->
+//             write storage ->
+//               shift_epoch ->
+//                 release stream lock
+//
+// Unlike safepoint_write(), the chunk keeps its start time.
+//
+void JfrRecorderService::safepoint_flush() {
+  assert(SafepointSynchronize::is_at_safepoint(), "invariant");
+  MutexLockerEx stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  write_object_sample_stacktrace(_stack_trace_repository);
+  write_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter, true);
+  write_stringpool_checkpoint_safepoint(_string_pool, _chunkwriter);
+  _checkpoint_manager.write_safepoint_types();
+  _storage.write_at_safepoint();
+  _checkpoint_manager.shift_epoch();
+}
+
+//
+// post-safepoint flush sequence
+//
+//  lock stream lock ->
+//    write type set ->
+//      write checkpoints ->
+//        write metadata event, unless this chunk already has the current one ->
+//          write chunk header ->
+//            release stream lock
+//
+void JfrRecorderService::post_safepoint_flush() {
+  assert(_chunkwriter.is_valid(), "invariant");
+  _checkpoint_manager.write_type_set();
+  MutexLockerEx stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  _checkpoint_manager.write();
+  int64_t metadata_offset = _chunkwriter.metadata_offset();
+  if (metadata_offset == 0 || JfrMetadataEvent::is_updated()) {
+    JfrMetadataEvent::lock();
+    metadata_offset = write_metadata_event(_chunkwriter);
+  }
+  const int64_t chunk_size = _repository.flush_chunk(metadata_offset);
+  log_trace(jfr, system)("Flushed chunk, size " INT64_FORMAT, chunk_size);
+}
+
 void JfrRecorderService::vm_error_rotation() {
   if (_chunkwriter.is_valid()) {
     finalize_current_chunk_on_vm_error();
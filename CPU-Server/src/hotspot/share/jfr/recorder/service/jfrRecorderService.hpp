@@ -64,10 +64,15 @@ class JfrRecorderService : public StackObj {
   void invoke_safepoint_write();
   void post_safepoint_write();
 
+  void safepoint_flush();
+  void invoke_safepoint_flush();
+  void post_safepoint_flush();
+
  public:
   JfrRecorderService();
   void start();
   void rotate(int msgs);
+  void flush();
   void process_full_buffers();
   void scavenge();
   void evaluate_chunk_size_for_rotation();
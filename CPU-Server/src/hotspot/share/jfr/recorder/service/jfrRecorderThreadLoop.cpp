@@ -24,11 +24,13 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/service/jfrRecorderThread.hpp"
 #include "logging/log.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 
 //
@@ -50,12 +52,15 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
     bool done = false;
     int msgs = 0;
     JfrRecorderService service;
+    // with a flush interval, wake up at least that often to flush the current chunk
+    const jlong flush_interval = JfrOptionSet::flush_interval();
+    jlong last_flush = os::javaTimeMillis();
     MutexLockerEx msg_lock(JfrMsg_lock);
 
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait(false);
+        JfrMsg_lock->wait(false, flush_interval);
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
@@ -72,6 +77,10 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
         service.start();
       } else if (ROTATE) {
         service.rotate(msgs);
+        last_flush = os::javaTimeMillis();
+      } else if (flush_interval > 0 && os::javaTimeMillis() - last_flush >= flush_interval) {
+        service.flush();
+        last_flush = os::javaTimeMillis();
       }
       JfrMsg_lock->lock();
       post_box.notify_waiters();
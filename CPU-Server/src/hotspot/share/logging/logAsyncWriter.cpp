@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/semaphore.inline.hpp"
+#include "runtime/thread.inline.hpp"
+
+LogAsyncBuffer::LogAsyncBuffer(size_t capacity) :
+  _slots(NULL), _capacity(capacity), _enqueue_pos(0), _dequeue_pos(0), _dropped(0) {
+  _slots = NEW_C_HEAP_ARRAY(Slot, _capacity, mtLogging);
+  for (size_t i = 0; i < _capacity; i++) {
+    _slots[i]._sequence = i;
+    _slots[i]._line = NULL;
+  }
+}
+
+LogAsyncBuffer::~LogAsyncBuffer() {
+  for (char* line = dequeue(); line != NULL; line = dequeue()) {
+    os::free(line);
+  }
+  FREE_C_HEAP_ARRAY(Slot, _slots);
+}
+
+// A slot is free for the producer at position pos when its sequence is pos,
+// and holds a line for the consumer at position pos when its sequence is pos + 1.
+bool LogAsyncBuffer::enqueue(char* line) {
+  size_t pos = _enqueue_pos;
+  while (true) {
+    Slot* slot = &_slots[pos % _capacity];
+    size_t sequence = OrderAccess::load_acquire(&slot->_sequence);
+    intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+    if (diff == 0) {
+      size_t cur = Atomic::cmpxchg(pos + 1, &_enqueue_pos, pos);
+      if (cur == pos) {
+        slot->_line = line;
+        OrderAccess::release_store(&slot->_sequence, pos + 1);
+        return true;
+      }
+      pos = cur;
+    } else if (diff < 0) {
+      // The consumer has not freed this slot yet, the buffer is full
+      Atomic::inc(&_dropped);
+      return false;
+    } else {
+      // Another producer claimed the slot, retry with the new position
+      pos = _enqueue_pos;
+    }
+  }
+}
+
+char* LogAsyncBuffer::dequeue() {
+  Slot* slot = &_slots[_dequeue_pos % _capacity];
+  size_t sequence = OrderAccess::load_acquire(&slot->_sequence);
+  if (sequence != _dequeue_pos + 1) {
+    // Empty, or the producer has not published its line yet
+    return NULL;
+  }
+  char* line = slot->_line;
+  slot->_line = NULL;
+  OrderAccess::release_store(&slot->_sequence, _dequeue_pos + _capacity);
+  _dequeue_pos++;
+  return line;
+}
+
+size_t LogAsyncBuffer::take_dropped() {
+  if (_dropped == 0) {
+    return 0;
+  }
+  return Atomic::xchg((size_t)0, &_dropped);
+}
+
+LogAsyncWriter* volatile LogAsyncWriter::_instance = NULL;
+volatile bool LogAsyncWriter::_should_terminate = false;
+volatile int LogAsyncWriter::_wakeup_pending = 0;
+Semaphore LogAsyncWriter::_wakeup(0);
+Semaphore LogAsyncWriter::_terminated(0);
+
+LogAsyncWriter::LogAsyncWriter() : NonJavaThread() {
+}
+
+void LogAsyncWriter::initialize() {
+  if (!AsyncLogging) {
+    return;
+  }
+  LogAsyncWriter* writer = new LogAsyncWriter();
+  if (!os::create_thread(writer, os::os_thread)) {
+    delete writer;
+    log_warning(logging)("Could not create the log writer thread, logging synchronously");
+    return;
+  }
+  os::start_thread(writer);
+  OrderAccess::release_store(&_instance, writer);
+  LogConfiguration::enable_async_outputs(AsyncLogBufferEntries);
+}
+
+void LogAsyncWriter::run() {
+  this->set_native_thread_name(this->name());
+  while (!OrderAccess::load_acquire(&_should_terminate)) {
+    _wakeup.wait();
+    // Lines enqueued from here on wake us up again
+    OrderAccess::release_store(&_wakeup_pending, 0);
+    OrderAccess::fence();
+    LogConfiguration::write_async_messages();
+  }
+  _terminated.signal();
+}
+
+void LogAsyncWriter::notify() {
+  if (OrderAccess::load_acquire(&_wakeup_pending) == 0 &&
+      Atomic::cmpxchg(1, &_wakeup_pending, 0) == 0) {
+    _wakeup.signal();
+  }
+}
+
+void LogAsyncWriter::stop() {
+  LogAsyncWriter* writer = Atomic::xchg((LogAsyncWriter*)NULL, &_instance);
+  if (writer == NULL) {
+    return;
+  }
+  OrderAccess::release_store(&_should_terminate, true);
+  _wakeup.signal();
+  Thread* thread = Thread::current_or_null();
+  if (thread != NULL && thread->is_Java_thread() &&
+      ((JavaThread*)thread)->thread_state() == _thread_in_vm) {
+    _terminated.wait_with_safepoint_check((JavaThread*)thread);
+  } else {
+    _terminated.wait();
+  }
+  // Write out what is left and log synchronously from now on
+  LogConfiguration::disable_async_outputs();
+}
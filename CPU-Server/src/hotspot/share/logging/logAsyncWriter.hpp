@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#ifndef SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Bounded buffer of formatted log lines, one per asynchronous log output.
+// Any number of logging threads enqueue lines without taking a lock, by
+// claiming a slot with a CAS on the enqueue position. The log writer thread
+// is the only consumer. A line that does not fit is dropped and counted
+// instead of blocking the logging thread.
+class LogAsyncBuffer : public CHeapObj<mtLogging> {
+ private:
+  struct Slot {
+    volatile size_t _sequence;
+    char* _line;
+  };
+
+  Slot*           _slots;
+  size_t          _capacity;
+  volatile size_t _enqueue_pos;
+  size_t          _dequeue_pos;
+  volatile size_t _dropped;
+
+ public:
+  LogAsyncBuffer(size_t capacity);
+  ~LogAsyncBuffer();
+
+  size_t capacity() const {
+    return _capacity;
+  }
+
+  // Takes ownership of the C heap allocated line, unless the buffer is full.
+  bool enqueue(char* line);
+  // Returns the oldest line, to be freed by the caller, or NULL if empty.
+  // Must only be called by one thread at a time.
+  char* dequeue();
+  // Returns and resets the number of lines dropped so far.
+  size_t take_dropped();
+};
+
+// The log writer thread writes the lines buffered by asynchronous
+// log outputs (see AsyncLogging) to their files and streams.
+class LogAsyncWriter : public NonJavaThread {
+ private:
+  static LogAsyncWriter* volatile _instance;
+  static volatile bool _should_terminate;
+  static volatile int _wakeup_pending;
+  static Semaphore _wakeup;
+  static Semaphore _terminated;
+
+  LogAsyncWriter();
+
+ public:
+  virtual void run();
+  char* name() const { return (char*)"Log Writer Thread"; }
+
+  // Starts the writer thread and makes the configured outputs asynchronous.
+  static void initialize();
+  // Writes out all buffered lines, stops the writer thread and makes
+  // the outputs synchronous again.
+  static void stop();
+
+  static bool is_running() {
+    return _instance != NULL;
+  }
+
+  // Wakes up the writer thread after lines have been enqueued.
+  static void notify();
+};
+
+#endif // SHARE_VM_LOGGING_LOGASYNCWRITER_HPP
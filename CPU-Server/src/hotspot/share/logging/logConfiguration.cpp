@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -35,6 +36,7 @@
 #include "logging/logTagSet.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/semaphore.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -62,6 +64,18 @@ class ConfigurationLock : public StackObj {
     _semaphore.wait();
     debug_only(_locking_thread_id = os::current_thread_id());
   }
+  // Takes the lock if it is free, returns false otherwise. Paired with unlock().
+  static bool try_lock() {
+    if (!_semaphore.trywait()) {
+      return false;
+    }
+    debug_only(_locking_thread_id = os::current_thread_id());
+    return true;
+  }
+  static void unlock() {
+    debug_only(_locking_thread_id = -1);
+    _semaphore.signal();
+  }
   ~ConfigurationLock() {
     debug_only(_locking_thread_id = -1);
     _semaphore.signal();
@@ -199,6 +213,9 @@ size_t LogConfiguration::add_output(LogOutput* output) {
   size_t idx = _n_outputs++;
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
   _outputs[idx] = output;
+  if (LogAsyncWriter::is_running()) {
+    output->enable_async(AsyncLogBufferEntries);
+  }
   return idx;
 }
 
@@ -210,6 +227,8 @@ void LogConfiguration::delete_output(size_t idx) {
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
+  // Write out the lines still buffered for the output
+  output->disable_async();
   delete output;
 }
 
@@ -605,3 +624,34 @@ void LogConfiguration::notify_update_listeners() {
     _listener_callbacks[i]();
   }
 }
+
+void LogConfiguration::enable_async_outputs(size_t buffer_entries) {
+  ConfigurationLock cl;
+  for (size_t i = 0; i < _n_outputs; i++) {
+    _outputs[i]->enable_async(buffer_entries);
+  }
+}
+
+void LogConfiguration::disable_async_outputs() {
+  ConfigurationLock cl;
+  for (size_t i = 0; i < _n_outputs; i++) {
+    _outputs[i]->disable_async();
+  }
+}
+
+void LogConfiguration::write_async_messages() {
+  ConfigurationLock cl;
+  for (size_t i = 0; i < _n_outputs; i++) {
+    _outputs[i]->write_async_messages();
+  }
+}
+
+void LogConfiguration::try_write_async_messages() {
+  if (!LogAsyncWriter::is_running() || !ConfigurationLock::try_lock()) {
+    return;
+  }
+  for (size_t i = 0; i < _n_outputs; i++) {
+    _outputs[i]->write_async_messages();
+  }
+  ConfigurationLock::unlock();
+}
@@ -123,6 +123,14 @@ class LogConfiguration : public AllStatic {
 
   // Rotates all LogOutput
   static void rotate_all_outputs();
+
+  // Asynchronous logging support for the log writer thread (see LogAsyncWriter).
+  static void enable_async_outputs(size_t buffer_entries);
+  static void disable_async_outputs();
+  static void write_async_messages();
+  // Like write_async_messages(), but gives up if the configuration is locked.
+  // Used when the VM exits abruptly or crashes.
+  static void try_write_async_messages();
 };
 
 #endif // SHARE_VM_LOGGING_LOGCONFIGURATION_HPP
@@ -266,6 +266,12 @@ int LogFileOutput::write(const LogDecorations& decorations, const char* msg) {
     return 0;
   }
 
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    // Written and accounted for rotation by the log writer thread
+    return enqueue(buffer, decorations, msg);
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(decorations, msg);
   _current_size += written;
@@ -284,6 +290,11 @@ int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
     return 0;
   }
 
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    return enqueue(buffer, msg_iterator);
+  }
+
   _rotation_semaphore.wait();
   int written = LogFileStreamOutput::write(msg_iterator);
   _current_size += written;
@@ -296,6 +307,20 @@ int LogFileOutput::write(LogMessageBuffer::Iterator msg_iterator) {
   return written;
 }
 
+void LogFileOutput::write_async_messages() {
+  if (_stream == NULL) {
+    return;
+  }
+
+  _rotation_semaphore.wait();
+  _current_size += write_async_buffer();
+
+  if (should_rotate()) {
+    rotate();
+  }
+  _rotation_semaphore.signal();
+}
+
 void LogFileOutput::archive() {
   assert(_archive_name != NULL && _archive_name_len > 0, "Rotation must be configured before using this function.");
   int ret = jio_snprintf(_archive_name, _archive_name_len, "%s.%0*u",
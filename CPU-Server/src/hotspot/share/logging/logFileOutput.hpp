@@ -84,6 +84,7 @@ class LogFileOutput : public LogFileStreamOutput {
   virtual bool initialize(const char* options, outputStream* errstream);
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  virtual void write_async_messages();
   virtual void force_rotate();
   virtual void describe(outputStream* out);
 
@@ -23,11 +23,14 @@
  */
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logDecorators.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logFileStreamOutput.hpp"
 #include "logging/logMessageBuffer.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 
 static bool initialized;
 static union {
@@ -50,6 +53,11 @@ LogFileStreamInitializer::LogFileStreamInitializer() {
   }
 }
 
+LogFileStreamOutput::~LogFileStreamOutput() {
+  delete _async_buffer;
+  delete _retired_async_buffer;
+}
+
 int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
   int total_written = 0;
 
@@ -72,11 +80,194 @@ int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
   return total_written;
 }
 
+// Same as write_decorations(), but into a buffer
+int LogFileStreamOutput::format_decorations(char* buf, size_t len, const LogDecorations& decorations) {
+  int total_written = 0;
+  buf[0] = '\0';
+
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (!_decorators.is_decorator(decorator)) {
+      continue;
+    }
+
+    int written = jio_snprintf(buf + total_written, len - total_written, "[%-*s]",
+                               _decorator_padding[decorator],
+                               decorations.decoration(decorator));
+    if (written <= 0) {
+      return -1;
+    } else if (static_cast<size_t>(written - 2) > _decorator_padding[decorator]) {
+      _decorator_padding[decorator] = written - 2;
+    }
+    total_written += written;
+  }
+  return total_written;
+}
+
+LogAsyncBuffer* LogFileStreamOutput::async_buffer() const {
+  return OrderAccess::load_acquire(&_async_buffer);
+}
+
+// Appends a line made of the (possibly empty) decorations and the message
+// to the C heap allocated buffer. Returns NULL if out of memory.
+static char* append_line(char* line, size_t* length, const char* decorations, const char* msg) {
+  size_t decorations_len = strlen(decorations);
+  size_t msg_len = strlen(msg);
+  size_t new_length = *length + decorations_len + (decorations_len > 0 ? 1 : 0) + msg_len + 1;
+  char* new_line = (char*)os::realloc(line, new_length + 1, mtLogging);
+  if (new_line == NULL) {
+    os::free(line);
+    return NULL;
+  }
+  char* pos = new_line + *length;
+  if (decorations_len > 0) {
+    memcpy(pos, decorations, decorations_len);
+    pos += decorations_len;
+    *pos++ = ' ';
+  }
+  memcpy(pos, msg, msg_len);
+  pos += msg_len;
+  *pos++ = '\n';
+  *pos = '\0';
+  *length = new_length;
+  return new_line;
+}
+
+static int enqueue_line(LogAsyncBuffer* buffer, char* line, size_t length) {
+  if (line == NULL) {
+    return 0;
+  }
+  if (!buffer->enqueue(line)) {
+    // Dropped, the writer thread reports the number of dropped lines
+    os::free(line);
+    return 0;
+  }
+  LogAsyncWriter::notify();
+  return (int)length;
+}
+
+int LogFileStreamOutput::enqueue(LogAsyncBuffer* buffer, const LogDecorations& decorations, const char* msg) {
+  char decorations_buf[2 * LogDecorations::DecorationsBufferSize];
+  if (_decorators.is_empty() || format_decorations(decorations_buf, sizeof(decorations_buf), decorations) < 0) {
+    decorations_buf[0] = '\0';
+  }
+  size_t length = 0;
+  char* line = append_line(NULL, &length, decorations_buf, msg);
+  return enqueue_line(buffer, line, length);
+}
+
+// The lines of a message are enqueued together, so they are never interleaved with other lines
+int LogFileStreamOutput::enqueue(LogAsyncBuffer* buffer, LogMessageBuffer::Iterator msg_iterator) {
+  char decorations_buf[2 * LogDecorations::DecorationsBufferSize];
+  size_t length = 0;
+  char* line = NULL;
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    if (_decorators.is_empty() || format_decorations(decorations_buf, sizeof(decorations_buf), msg_iterator.decorations()) < 0) {
+      decorations_buf[0] = '\0';
+    }
+    line = append_line(line, &length, decorations_buf, msg_iterator.message());
+    if (line == NULL) {
+      return 0;
+    }
+  }
+  return enqueue_line(buffer, line, length);
+}
+
+// Writes at most max_lines lines of the buffer, and the number of dropped lines.
+// The caller holds the stream lock, which also serializes the dequeuing threads.
+int LogFileStreamOutput::write_buffered_lines(LogAsyncBuffer* buffer, size_t max_lines) {
+  int written = 0;
+  for (size_t i = 0; i < max_lines; i++) {
+    char* line = buffer->dequeue();
+    if (line == NULL) {
+      break;
+    }
+    written += jio_fprintf(_stream, "%s", line);
+    os::free(line);
+  }
+  size_t dropped = buffer->take_dropped();
+  if (dropped > 0) {
+    written += jio_fprintf(_stream, "[" SIZE_FORMAT " log messages dropped, the asynchronous log buffer was full]\n",
+                           dropped);
+  }
+  return written;
+}
+
+// Writes the lines that late loggers enqueued into the retired buffer,
+// ahead of the synchronously written line. The caller holds the stream lock.
+int LogFileStreamOutput::write_retired_lines() {
+  LogAsyncBuffer* buffer = _retired_async_buffer;
+  if (buffer == NULL) {
+    return 0;
+  }
+  return write_buffered_lines(buffer, SIZE_MAX);
+}
+
+int LogFileStreamOutput::write_async_buffer() {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer == NULL) {
+    buffer = _retired_async_buffer;
+    if (buffer == NULL) {
+      return 0;
+    }
+  }
+
+  os::flockfile(_stream);
+  // Write at most one buffer full, so that busy loggers can not keep the writer here
+  int written = write_buffered_lines(buffer, buffer->capacity());
+  if (written > 0) {
+    fflush(_stream);
+  }
+  os::funlockfile(_stream);
+
+  return written;
+}
+
+void LogFileStreamOutput::enable_async(size_t buffer_entries) {
+  if (async_buffer() != NULL) {
+    return;
+  }
+  // A buffer retired by disable_async() may still be in use by late
+  // loggers, so it is reused instead of being freed. Its remaining lines
+  // are written before the newer ones.
+  LogAsyncBuffer* buffer = _retired_async_buffer;
+  if (buffer == NULL) {
+    buffer = new LogAsyncBuffer(buffer_entries);
+  }
+  OrderAccess::release_store(&_async_buffer, buffer);
+  _retired_async_buffer = NULL;
+}
+
+void LogFileStreamOutput::disable_async() {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer == NULL) {
+    return;
+  }
+  // Loggers that still see the buffer may enqueue a last few lines. The
+  // buffer is kept until the output is deleted, and the synchronous writes
+  // write such lines first (see write_retired_lines()).
+  _retired_async_buffer = buffer;
+  OrderAccess::release_store(&_async_buffer, (LogAsyncBuffer*)NULL);
+  os::flockfile(_stream);
+  if (write_retired_lines() > 0) {
+    fflush(_stream);
+  }
+  os::funlockfile(_stream);
+}
+
+void LogFileStreamOutput::write_async_messages() {
+  write_async_buffer();
+}
+
 int LogFileStreamOutput::write(const LogDecorations& decorations, const char* msg) {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    return enqueue(buffer, decorations, msg);
+  }
   const bool use_decorations = !_decorators.is_empty();
 
-  int written = 0;
   os::flockfile(_stream);
+  int written = write_retired_lines();
   if (use_decorations) {
     written += write_decorations(decorations);
     written += jio_fprintf(_stream, " ");
@@ -89,10 +280,14 @@ int LogFileStreamOutput::write(const LogDecorations& decorations, const char* ms
 }
 
 int LogFileStreamOutput::write(LogMessageBuffer::Iterator msg_iterator) {
+  LogAsyncBuffer* buffer = async_buffer();
+  if (buffer != NULL) {
+    return enqueue(buffer, msg_iterator);
+  }
   const bool use_decorations = !_decorators.is_empty();
 
-  int written = 0;
   os::flockfile(_stream);
+  int written = write_retired_lines();
   for (; !msg_iterator.is_at_end(); msg_iterator++) {
     if (use_decorations) {
       written += write_decorations(msg_iterator.decorations());
@@ -28,6 +28,7 @@
 #include "logging/logOutput.hpp"
 #include "utilities/globalDefinitions.hpp"
 
+class LogAsyncBuffer;
 class LogDecorations;
 
 class LogFileStreamInitializer {
@@ -43,18 +44,36 @@ class LogFileStreamOutput : public LogOutput {
  protected:
   FILE*               _stream;
   size_t              _decorator_padding[LogDecorators::Count];
+  // Buffer of formatted lines while the output is asynchronous, NULL otherwise
+  LogAsyncBuffer* volatile _async_buffer;
+  // Buffer of an output that was made synchronous again, kept for late
+  // loggers until the output is deleted or made asynchronous again
+  LogAsyncBuffer*     _retired_async_buffer;
 
-  LogFileStreamOutput(FILE *stream) : _stream(stream) {
+  LogFileStreamOutput(FILE *stream) : _stream(stream), _async_buffer(NULL), _retired_async_buffer(NULL) {
     for (size_t i = 0; i < LogDecorators::Count; i++) {
       _decorator_padding[i] = 0;
     }
   }
 
   int write_decorations(const LogDecorations& decorations);
+  int format_decorations(char* buf, size_t len, const LogDecorations& decorations);
+
+  LogAsyncBuffer* async_buffer() const;
+  int enqueue(LogAsyncBuffer* buffer, const LogDecorations& decorations, const char* msg);
+  int enqueue(LogAsyncBuffer* buffer, LogMessageBuffer::Iterator msg_iterator);
+  int write_buffered_lines(LogAsyncBuffer* buffer, size_t max_lines);
+  int write_retired_lines();
+  // Writes the buffered lines to the stream, returns the number of bytes written
+  int write_async_buffer();
 
  public:
+  virtual ~LogFileStreamOutput();
   virtual int write(const LogDecorations& decorations, const char* msg);
   virtual int write(LogMessageBuffer::Iterator msg_iterator);
+  virtual void enable_async(size_t buffer_entries);
+  virtual void disable_async();
+  virtual void write_async_messages();
 };
 
 class LogStdoutOutput : public LogFileStreamOutput {
@@ -93,6 +93,17 @@ class LogOutput : public CHeapObj<mtLogging> {
     // Do nothing by default.
   }
 
+  // Asynchronous logging (see AsyncLogging). Outputs that support it buffer
+  // their lines once made asynchronous, and write them out when the log
+  // writer thread calls write_async_messages().
+  virtual void enable_async(size_t buffer_entries) {
+    // Synchronous by default.
+  }
+  virtual void disable_async() {
+  }
+  virtual void write_async_messages() {
+  }
+
   virtual void describe(outputStream *out);
 
   virtual const char* name() const = 0;
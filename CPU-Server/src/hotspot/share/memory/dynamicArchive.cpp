@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "logging/log.hpp"
+#include "memory/dynamicArchive.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+
+#ifndef _WINDOWS
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if INCLUDE_CDS
+
+volatile int DynamicArchive::_unarchived_classes = 0;
+
+void DynamicArchive::record_unarchived_class() {
+  Atomic::inc(&_unarchived_classes);
+}
+
+#ifndef _WINDOWS
+
+// Adds the options that the archived classes and the archive mapping
+// depend on, so that the next run can use the archive.
+static void add_dump_options(GrowableArray<const char*>* args) {
+  const char* cp = Arguments::get_appclasspath();
+  if (cp != NULL && cp[0] != '\0') {
+    args->append("-cp");
+    args->append(cp);
+  }
+  const char* append = Arguments::get_jdk_boot_class_path_append();
+  if (append != NULL && append[0] != '\0') {
+    stringStream opt;
+    opt.print("-Xbootclasspath/a:%s", append);
+    args->append(opt.as_string());
+  }
+  const char* module_path = Arguments::get_property("jdk.module.path");
+  if (module_path != NULL && module_path[0] != '\0') {
+    // The class list names classes of any module on the module path.
+    args->append("--module-path");
+    args->append(module_path);
+    args->append("--add-modules=ALL-MODULE-PATH");
+  }
+  args->append(UseCompressedOops ? "-XX:+UseCompressedOops" : "-XX:-UseCompressedOops");
+  args->append(UseCompressedClassPointers ? "-XX:+UseCompressedClassPointers" : "-XX:-UseCompressedClassPointers");
+}
+
+// Runs the dump in a grandchild of the VM, so that the exit of this run does
+// not wait for it. The intermediate child waits for the dump, renames the
+// temporary file over the archive if the dump succeeded and removes the
+// class list. Only async-signal-safe calls are made after fork().
+static bool start_dump(char* const* argv, const char* log_name,
+                       const char* tmp_name, const char* list_name) {
+  long max_fd = sysconf(_SC_OPEN_MAX);
+  if (max_fd < 0) {
+    max_fd = 1024;
+  }
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    return false;
+  }
+  if (pid == 0) {
+    // Detach from the VM and leave the waiter to init.
+    setsid();
+    pid_t waiter = fork();
+    if (waiter != 0) {
+      _exit(waiter < 0 ? 1 : 0);
+    }
+
+    // Do not keep the listening sockets and open files of the VM alive.
+    for (int fd = 3; fd < max_fd; fd++) {
+      close(fd);
+    }
+    int in = open("/dev/null", O_RDONLY);
+    int out = open(log_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (in < 0 || out < 0) {
+      unlink(list_name);
+      _exit(1);
+    }
+    dup2(in, 0);
+    dup2(out, 1);
+    dup2(out, 2);
+    if (in > 2) {
+      close(in);
+    }
+    if (out > 2) {
+      close(out);
+    }
+
+    int status = -1;
+    pid_t dumper = fork();
+    if (dumper == 0) {
+      execv(argv[0], argv);
+      _exit(127);
+    }
+    if (dumper > 0) {
+      while (waitpid(dumper, &status, 0) < 0 && errno == EINTR);
+    }
+    if (dumper > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+      rename(tmp_name, ArchiveClassesAtExit);
+    }
+    unlink(tmp_name);
+    unlink(list_name);
+    _exit(0);
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      return false;
+    }
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+#endif // !_WINDOWS
+
+void DynamicArchive::dump_at_exit() {
+  if (ArchiveClassesAtExit == NULL || classlist_file == NULL || !classlist_file->is_open()) {
+    return;
+  }
+  if (UseSharedSpaces && SharedArchiveFile != NULL &&
+      strcmp(SharedArchiveFile, ArchiveClassesAtExit) == 0 && _unarchived_classes == 0) {
+    log_info(cds)("All classes were loaded from %s, not updating it", ArchiveClassesAtExit);
+    remove(DumpLoadedClassList);
+    return;
+  }
+  classlist_file->flush();
+
+#ifndef _WINDOWS
+  ResourceMark rm;
+  // The dump runs in the background and may overlap with later runs. The
+  // class list of each run is private (see Arguments::parse), and the
+  // dump writes into a private temporary file, which is renamed over the
+  // archive once complete. A run that has the old archive mapped is not
+  // disturbed by the rename.
+  int pid = os::current_process_id();
+  stringStream tmp_name;
+  tmp_name.print("%s.%d.tmp", ArchiveClassesAtExit, pid);
+  stringStream log_name;
+  log_name.print("%s.%d.log", ArchiveClassesAtExit, pid);
+
+  // The arguments are passed to the dump as they are, without a shell.
+  GrowableArray<const char*> args;
+  stringStream java;
+  java.print("%s/bin/java", Arguments::get_java_home());
+  args.append(java.as_string());
+  args.append("-Xshare:dump");
+  stringStream list_opt;
+  list_opt.print("-XX:SharedClassListFile=%s", DumpLoadedClassList);
+  args.append(list_opt.as_string());
+  stringStream archive_opt;
+  archive_opt.print("-XX:SharedArchiveFile=%s", tmp_name.as_string());
+  args.append(archive_opt.as_string());
+  add_dump_options(&args);
+
+  stringStream cmd;
+  for (int i = 0; i < args.length(); i++) {
+    cmd.print("%s%s", i == 0 ? "" : " ", args.at(i));
+  }
+  args.append(NULL);
+
+  log_info(cds)("Dumping archive %s in the background: %s", ArchiveClassesAtExit, cmd.as_string());
+  if (!start_dump((char* const*)args.adr_at(0), log_name.as_string(),
+                  tmp_name.as_string(), DumpLoadedClassList)) {
+    log_warning(cds)("Could not start dumping archive %s", ArchiveClassesAtExit);
+    remove(DumpLoadedClassList);
+  }
+#endif // !_WINDOWS
+}
+
+#endif // INCLUDE_CDS
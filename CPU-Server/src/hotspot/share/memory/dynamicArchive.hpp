@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_MEMORY_DYNAMICARCHIVE_HPP
+#define SHARE_VM_MEMORY_DYNAMICARCHIVE_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/macros.hpp"
+
+// Support for -XX:ArchiveClassesAtExit=<archive>.
+//
+// The classes loaded by the built-in class loaders during the run are
+// recorded in a class list private to the process (see DumpLoadedClassList),
+// both those parsed from class files and those loaded from the mapped archive
+// (see SystemDictionary::load_shared_class), so a rewritten archive keeps the
+// classes of the previous one. At VM exit the list is handed to a detached
+// -Xshare:dump run of the same JDK with the same class path, module path and
+// -Xbootclasspath/a, which logs to <archive>.<pid>.log. The next run can then
+// map the archive with -XX:SharedArchiveFile, and it is validated against its
+// class path like any other archive. The archive is left alone when the run
+// mapped it and loaded every recorded class from it, so it is only rewritten
+// after the deployment changes.
+class DynamicArchive : AllStatic {
+ private:
+  static volatile int _unarchived_classes;
+
+ public:
+  // Called for every recorded class that was not loaded from the mapped archive.
+  static void record_unarchived_class() NOT_CDS_RETURN;
+
+  static void dump_at_exit() NOT_CDS_RETURN;
+};
+
+#endif // SHARE_VM_MEMORY_DYNAMICARCHIVE_HPP
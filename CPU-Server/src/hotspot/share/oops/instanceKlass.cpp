@@ -37,6 +37,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "code/dependencyContext.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/profileCache.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "interpreter/oopMapCache.hpp"
 #include "interpreter/rewriter.hpp"
@@ -857,6 +858,9 @@ bool InstanceKlass::link_class_impl(TRAPS) {
       }
 #endif
       set_init_state(linked);
+      if (UseProfileCache) {
+        ProfileCache::seed_profiles(this, THREAD);
+      }
       if (JvmtiExport::should_post_class_prepare()) {
         Thread *thread = THREAD;
         assert(thread->is_Java_thread(), "thread->is_Java_thread()");
@@ -90,7 +90,8 @@ class Method : public Metadata {
     _has_injected_profile  = 1 << 4,
     _running_emcp          = 1 << 5,
     _intrinsic_candidate   = 1 << 6,
-    _reserved_stack_access = 1 << 7
+    _reserved_stack_access = 1 << 7,
+    _hot_code              = 1 << 8
   };
   mutable u2 _flags;
 
@@ -884,6 +885,15 @@ class Method : public Metadata {
     _flags = x ? (_flags | _reserved_stack_access) : (_flags & ~_reserved_stack_access);
   }
 
+  // Level 4 code of hot methods is placed in the hot code heap (see HotCodeHeapSize)
+  bool is_hot_code() {
+    return (_flags & _hot_code) != 0;
+  }
+
+  void set_is_hot_code(bool x) {
+    _flags = x ? (_flags | _hot_code) : (_flags & ~_hot_code);
+  }
+
   JFR_ONLY(DEFINE_TRACE_FLAG_ACCESSOR;)
 
   ConstMethod::MethodType method_type() const {
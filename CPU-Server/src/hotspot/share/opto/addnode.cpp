@@ -849,6 +849,10 @@ const Type *MaxINode::add_ring( const Type *t0, const Type *t1 ) const {
 // "MIN2(x+c0,MIN2(y,x+c1))".  Pick the smaller constant: "MIN2(x+c0,y)"
 Node *MinINode::Ideal(PhaseGVN *phase, bool can_reshape) {
   Node *progress = NULL;
+  // Reassociating a reduction chain would hide it from SuperWord.
+  if (is_reduction()) {
+    return NULL;
+  }
   // Force a right-spline graph
   Node *l = in(1);
   Node *r = in(2);
@@ -219,6 +219,10 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(bool, UseLongCountedLoopNests, true,                              \
+          "Convert loops with a long induction variable into an outer "     \
+          "loop around an int counted loop")                                \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
@@ -541,6 +545,10 @@
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
+  product(bool, ReduceAllocationMerges, true,                               \
+          "Split field loads through Phis which merge allocations so "      \
+          "that the merged allocations can be scalar replaced")             \
+                                                                            \
   product(intx, EliminateAllocationArraySizeLimit, 64,                      \
           "Array size (number of elements) limit for scalar replacement")   \
           range(0, max_jint)                                                \
@@ -36,6 +36,7 @@
 #include "opto/convertnode.hpp"
 #include "opto/loopnode.hpp"
 #include "opto/machnode.hpp"
+#include "opto/matcher.hpp"
 #include "opto/movenode.hpp"
 #include "opto/narrowptrnode.hpp"
 #include "opto/mulnode.hpp"
@@ -1548,6 +1549,9 @@ static Node* is_absolute( PhaseGVN *phase, PhiNode *phi_root, int true_path) {
   Node *cmp = bol->in(1);
   const Type *tzero = NULL;
   switch( cmp->Opcode() ) {
+  case Op_CmpI:                                // Int ABS
+    if (!Matcher::match_rule_supported(Op_AbsI)) return NULL;
+    tzero = TypeInt::ZERO; break;
   case Op_CmpF:    tzero = TypeF::ZERO; break; // Float ABS
   case Op_CmpD:    tzero = TypeD::ZERO; break; // Double ABS
   default: return NULL;
@@ -1574,7 +1578,15 @@ static Node* is_absolute( PhaseGVN *phase, PhiNode *phi_root, int true_path) {
   Node *sub = phi_root->in(3 - phi_x_idx);
 
   // Allow only Sub(0,X) and fail out for all others; Neg is not OK
-  if( tzero == TypeF::ZERO ) {
+  if( tzero == TypeInt::ZERO ) {
+    if( sub->Opcode() != Op_SubI ||
+        sub->in(2) != x ||
+        phase->type(sub->in(1)) != tzero ) return NULL;
+    x = new AbsINode(x);
+    if (flip) {
+      x = new SubINode(sub->in(1), phase->transform(x));
+    }
+  } else if( tzero == TypeF::ZERO ) {
     if( sub->Opcode() != Op_SubF ||
         sub->in(2) != x ||
         phase->type(sub->in(1)) != tzero ) return NULL;
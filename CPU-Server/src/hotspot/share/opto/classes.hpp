@@ -277,9 +277,7 @@ shmacro(ShenandoahCompareAndSwapP)
 shmacro(ShenandoahWeakCompareAndSwapN)
 shmacro(ShenandoahWeakCompareAndSwapP)
 shmacro(ShenandoahEnqueueBarrier)
-shmacro(ShenandoahReadBarrier)
-shmacro(ShenandoahWriteBarrier)
-shmacro(ShenandoahWBMemProj)
+shmacro(ShenandoahLoadReferenceBarrier)
 macro(SCMemProj)
 macro(SqrtD)
 macro(SqrtF)
@@ -343,10 +341,15 @@ macro(MulReductionVF)
 macro(MulVD)
 macro(MulReductionVD)
 macro(MulAddVS2VI)
+macro(MinVI)
+macro(MinReductionVI)
+macro(MaxVI)
+macro(MaxReductionVI)
 macro(FmaVD)
 macro(FmaVF)
 macro(DivVF)
 macro(DivVD)
+macro(AbsVI)
 macro(AbsVF)
 macro(AbsVD)
 macro(NegVF)
@@ -26,6 +26,7 @@
 #include "opto/addnode.hpp"
 #include "opto/castnode.hpp"
 #include "opto/convertnode.hpp"
+#include "opto/loopnode.hpp"
 #include "opto/matcher.hpp"
 #include "opto/phaseX.hpp"
 #include "opto/subnode.hpp"
@@ -448,6 +449,36 @@ const Type* ConvL2INode::Value(PhaseGVN* phase) const {
   return bottom_type();
 }
 
+// Is 'iv' the int iv of the inner loop of a loop nest, or its increment,
+// and 'outer_iv' the long iv of the enclosing outer loop? See
+// PhaseIdealLoop::create_loop_nest().
+static bool is_loop_nest_iv(Node* outer_iv, Node* iv) {
+  if (iv->Opcode() == Op_AddI && iv->in(2)->is_Con()) {
+    iv = iv->in(1);
+  }
+  if (!iv->is_Phi() || !outer_iv->is_Phi()) {
+    return false;
+  }
+  Node* inner_head = iv->in(0);
+  Node* outer_head = outer_iv->in(0);
+  if (inner_head == NULL || outer_head == NULL || !inner_head->is_Loop() || !outer_head->is_Loop()) {
+    return false;
+  }
+  // Walk up from the inner loop entry, through predicates and a strip
+  // mined outer loop, to the outer loop head.
+  Node* ctrl = inner_head->in(LoopNode::EntryControl);
+  while (ctrl != NULL && !ctrl->is_top()) {
+    if (ctrl->is_OuterStripMinedLoop()) {
+      ctrl = ctrl->in(LoopNode::EntryControl);
+    } else if (ctrl->is_Region() || ctrl->is_Start()) {
+      break;
+    } else {
+      ctrl = ctrl->in(0);
+    }
+  }
+  return ctrl == outer_head;
+}
+
 //------------------------------Ideal------------------------------------------
 // Return a node which is more "ideal" than the current node.
 // Blow off prior masking to int
@@ -465,6 +496,19 @@ Node *ConvL2INode::Ideal(PhaseGVN *phase, bool can_reshape) {
   // Swap with a prior add: convL2I(addL(x,y)) ==> addI(convL2I(x),convL2I(y))
   // This replaces an 'AddL' with an 'AddI'.
   if( andl_op == Op_AddL ) {
+    // The iv of a long loop nest, the outer long iv plus the inner int iv:
+    // convL2I(addL(x,convI2L(y))) ==> addI(convL2I(x),y). This keeps array
+    // indexing on the inner int iv, whatever the other users of the add.
+    for (uint i = 1; i <= 2; i++) {
+      Node* y = andl->in(i);
+      Node* x = andl->in(3 - i);
+      if (y->Opcode() == Op_ConvI2L && is_loop_nest_iv(x, y->in(1))) {
+        if (phase->type(x) == Type::TOP || phase->type(y) == Type::TOP) return NULL;
+        Node* add1 = phase->transform(new ConvL2INode(x));
+        return new AddINode(add1, y->in(1));
+      }
+    }
+
     // Don't do this for nodes which have more than one user since
     // we'll end up computing the long add anyway.
     if (andl->outcnt() > 1) return NULL;
@@ -96,6 +96,10 @@ void ConnectionGraph::do_analysis(Compile *C, PhaseIterGVN *igvn) {
   // to create space for them in ConnectionGraph::_nodes[].
   Node* oop_null = igvn->zerocon(T_OBJECT);
   Node* noop_null = igvn->zerocon(T_NARROWOOP);
+  if (ReduceAllocationMerges && EliminateAllocations) {
+    reduce_allocation_merges(C, igvn);
+    if (C->failing())  return;
+  }
   ConnectionGraph* congraph = new(C->comp_arena()) ConnectionGraph(C, igvn);
   // Perform escape analysis
   if (congraph->compute_escape()) {
@@ -109,6 +113,111 @@ void ConnectionGraph::do_analysis(Compile *C, PhaseIterGVN *igvn) {
     igvn->hash_delete(noop_null);
 }
 
+// Check if a Phi which merges allocations can be removed by splitting
+// all its users through it: every input must be the result of a
+// (non array) allocation and every use must be a field load at a
+// constant offset.  Merges referenced by safepoints, null checks or
+// stores are left alone: the allocations stay merged and are not
+// scalar replaced.
+bool ConnectionGraph::can_reduce_phi(PhiNode* phi) {
+  Node* region = phi->in(0);
+  if (region == NULL || !region->is_Region() || region->is_Loop() ||
+      phi->type()->isa_oopptr() == NULL) {
+    return false;
+  }
+  for (uint i = 1; i < phi->req(); i++) {
+    Node* in = phi->in(i);
+    if (in == NULL || region->in(i) == NULL || !in->is_CheckCastPP()) {
+      return false;
+    }
+    AllocateNode* alloc = AllocateNode::Ideal_allocation(in, NULL);
+    if (alloc == NULL || alloc->is_AllocateArray()) {
+      return false;
+    }
+  }
+  for (DUIterator_Fast imax, i = phi->fast_outs(imax); i < imax; i++) {
+    Node* addp = phi->fast_out(i);
+    if (!addp->is_AddP() ||
+        addp->in(AddPNode::Base) != phi ||
+        addp->in(AddPNode::Address) != phi ||
+        !addp->in(AddPNode::Offset)->is_Con()) {
+      return false;
+    }
+    for (DUIterator_Fast jmax, j = addp->fast_outs(jmax); j < jmax; j++) {
+      Node* use = addp->fast_out(j);
+      if (!use->is_Load() ||
+          use->in(MemNode::Address) != addp ||
+          use->as_Load()->is_mismatched_access()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Split field loads through Phis which merge allocations so that
+// the Phis die and the allocations can be scalar replaced when they
+// do not escape otherwise.
+void ConnectionGraph::reduce_allocation_merges(Compile* C, PhaseIterGVN* igvn) {
+  Unique_Node_List merges;
+  for (int i = 0; i < C->macro_count(); i++) {
+    Node* n = C->macro_node(i);
+    if (!n->is_Allocate() || n->is_AllocateArray()) {
+      continue;
+    }
+    Node* res = n->as_Allocate()->result_cast();
+    if (res == NULL) {
+      continue;
+    }
+    for (DUIterator_Fast jmax, j = res->fast_outs(jmax); j < jmax; j++) {
+      Node* use = res->fast_out(j);
+      if (use->is_Phi()) {
+        merges.push(use);
+      }
+    }
+  }
+
+  bool progress = false;
+  Node_List loads;
+  for (uint i = 0; i < merges.size(); i++) {
+    PhiNode* phi = merges.at(i)->as_Phi();
+    if (phi->outcnt() == 0 || !can_reduce_phi(phi)) {
+      continue;
+    }
+    loads.clear();
+    for (DUIterator_Fast jmax, j = phi->fast_outs(jmax); j < jmax; j++) {
+      Node* addp = phi->fast_out(j);
+      for (DUIterator_Fast kmax, k = addp->fast_outs(kmax); k < kmax; k++) {
+        loads.push(addp->fast_out(k));
+      }
+    }
+#ifndef PRODUCT
+    if (PrintEliminateAllocations) {
+      tty->print("=== Reducing allocation merge ");
+      phi->dump();
+    }
+#endif
+    while (loads.size() > 0) {
+      LoadNode* load = loads.pop()->as_Load();
+      Node* data_phi = load->split_through_phi(igvn, true);
+      if (data_phi == NULL) {
+        continue;
+      }
+      if (data_phi != load) {
+        igvn->replace_node(load, data_phi);
+      } else {
+        igvn->_worklist.push(load);
+      }
+      progress = true;
+    }
+  }
+  if (progress) {
+    // Fold the split loads into the initializing stores and
+    // remove the now dead merges before building the graph.
+    igvn->optimize();
+  }
+}
+
 bool ConnectionGraph::compute_escape() {
   Compile* C = _compile;
   PhaseGVN* igvn = _igvn;
@@ -1003,7 +1112,8 @@ void ConnectionGraph::process_call_arguments(CallNode *call) {
                   strcmp(call->as_CallLeaf()->_name, "mulAdd") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "montgomery_multiply") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "montgomery_square") == 0 ||
-                  strcmp(call->as_CallLeaf()->_name, "vectorizedMismatch") == 0)
+                  strcmp(call->as_CallLeaf()->_name, "vectorizedMismatch") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "vectorizedHashCode") == 0)
                  ))) {
             call->dump();
             fatal("EA unexpected CallLeaf %s", call->as_CallLeaf()->_name);
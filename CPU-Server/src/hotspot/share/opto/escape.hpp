@@ -561,6 +561,10 @@ private:
   // Compute the escape information
   bool compute_escape();
 
+  // Split field loads through Phis which only merge allocations.
+  static bool can_reduce_phi(PhiNode* phi);
+  static void reduce_allocation_merges(Compile* C, PhaseIterGVN* igvn);
+
 public:
   ConnectionGraph(Compile *C, PhaseIterGVN *igvn);
 
@@ -323,6 +323,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_montgomeryMultiply();
   bool inline_montgomerySquare();
   bool inline_vectorizedMismatch();
+  bool inline_vectorizedHashCode(vmIntrinsics::ID id);
   bool inline_fma(vmIntrinsics::ID id);
   bool inline_character_compare(vmIntrinsics::ID id);
 
@@ -830,6 +831,14 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_vectorizedMismatch:
     return inline_vectorizedMismatch();
 
+  case vmIntrinsics::_hashCodeL:
+  case vmIntrinsics::_hashCodeU:
+  case vmIntrinsics::_hashCodeB:
+  case vmIntrinsics::_hashCodeC:
+  case vmIntrinsics::_hashCodeS:
+  case vmIntrinsics::_hashCodeI:
+    return inline_vectorizedHashCode(intrinsic_id());
+
   case vmIntrinsics::_ghash_processBlocks:
     return inline_ghash_processBlocks();
   case vmIntrinsics::_base64_encodeBlock:
@@ -4471,7 +4480,7 @@ JVMState* LibraryCallKit::arraycopy_restore_alloc_state(AllocateArrayNode* alloc
         for (MergeMemStream mms(merged_memory(), mem->as_MergeMem()); mms.next_non_empty2(); ) {
           Node* n = mms.memory();
           if (n != mms.memory2() && !(n->is_Proj() && n->in(0) == alloc->initialization())) {
-            assert(n->is_Store() || n->Opcode() == Op_ShenandoahWBMemProj, "what else?");
+            assert(n->is_Store(), "what else?");
             no_interfering_store = false;
             break;
           }
@@ -4480,7 +4489,7 @@ JVMState* LibraryCallKit::arraycopy_restore_alloc_state(AllocateArrayNode* alloc
         for (MergeMemStream mms(merged_memory()); mms.next_non_empty(); ) {
           Node* n = mms.memory();
           if (n != mem && !(n->is_Proj() && n->in(0) == alloc->initialization())) {
-            assert(n->is_Store() || n->Opcode() == Op_ShenandoahWBMemProj, "what else?");
+            assert(n->is_Store(), "what else?");
             no_interfering_store = false;
             break;
           }
@@ -5363,6 +5372,101 @@ bool LibraryCallKit::inline_vectorizedMismatch() {
   return true;
 }
 
+//-------------inline_vectorizedHashCode------------------------------
+// Computes the polynomial hash h = 31 * h + e over all elements of an array.
+// int StringLatin1.hashCode(byte[] value)  -- unsigned bytes, starts from 0
+// int StringUTF16.hashCode(byte[] value)   -- chars, starts from 0
+// int Arrays.hashCode(byte[]/char[]/short[]/int[] a) -- 0 for null, starts from 1
+bool LibraryCallKit::inline_vectorizedHashCode(vmIntrinsics::ID id) {
+  assert(UseVectorizedHashCodeIntrinsic, "not implementated on this platform");
+
+  address stubAddr = StubRoutines::vectorizedHashCode();
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char* stubName = "vectorizedHashCode";
+  assert(callee()->signature()->size() == 1, "hashCode has 1 parameter");
+
+  BasicType array_type;  // element type of the Java array
+  BasicType hash_type;   // type of the hashed elements, as seen by the stub
+  bool is_string = false;
+  switch (id) {
+  case vmIntrinsics::_hashCodeL: array_type = T_BYTE;  hash_type = T_BOOLEAN; is_string = true; break;
+  case vmIntrinsics::_hashCodeU: array_type = T_BYTE;  hash_type = T_CHAR;    is_string = true; break;
+  case vmIntrinsics::_hashCodeB: array_type = T_BYTE;  hash_type = T_BYTE;  break;
+  case vmIntrinsics::_hashCodeC: array_type = T_CHAR;  hash_type = T_CHAR;  break;
+  case vmIntrinsics::_hashCodeS: array_type = T_SHORT; hash_type = T_SHORT; break;
+  case vmIntrinsics::_hashCodeI: array_type = T_INT;   hash_type = T_INT;   break;
+  default:
+    fatal_unexpected_iid(id);
+    return false;
+  }
+
+  Node* array = argument(0);
+  const TypeAryPtr* top_a = array->Value(&_gvn)->isa_aryptr();
+  if (top_a == NULL || top_a->klass() == NULL) {
+    // failed array check
+    return false;
+  }
+
+  enum { _null_path = 1, _hash_path, PATH_LIMIT };
+  RegionNode* result_reg = new RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new PhiNode(result_reg, TypeInt::INT);
+  PhiNode*    result_io  = new PhiNode(result_reg, Type::ABIO);
+  PhiNode*    result_mem = new PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+  if (is_string) {
+    // String.value is never null.
+    array = null_check(array, T_ARRAY);
+    if (stopped()) {
+      return true;
+    }
+    result_reg->init_req(_null_path, top());
+    result_val->init_req(_null_path, top());
+    result_io ->init_req(_null_path, top());
+    result_mem->init_req(_null_path, top());
+  } else {
+    // Arrays.hashCode(null) == 0
+    Node* null_ctl = top();
+    array = null_check_oop(array, &null_ctl);
+    if (stopped()) {
+      set_control(null_ctl);
+      set_result(intcon(0));
+      return true;
+    }
+    Node* init_mem = reset_memory();
+    set_all_memory(init_mem);
+    result_reg->init_req(_null_path, null_ctl);
+    result_val->init_req(_null_path, intcon(0));
+    result_io ->init_req(_null_path, i_o());
+    result_mem->init_req(_null_path, init_mem);
+  }
+
+  array = access_resolve(array, ACCESS_READ);
+  Node* length = load_array_length(array);
+  if (id == vmIntrinsics::_hashCodeU) {
+    // UTF16 strings store each char in two bytes.
+    length = _gvn.transform(new RShiftINode(length, intcon(1)));
+  }
+  Node* array_adr = array_element_address(array, intcon(0), array_type);
+
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+    OptoRuntime::vectorizedHashCode_Type(),
+    stubAddr, stubName, TypePtr::BOTTOM,
+    array_adr, length, intcon(is_string ? 0 : 1), intcon(hash_type));
+  Node* hash = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+
+  result_reg->init_req(_hash_path, control());
+  result_val->init_req(_hash_path, hash);
+  result_io ->init_req(_hash_path, i_o());
+  result_mem->init_req(_hash_path, reset_memory());
+
+  set_i_o(        _gvn.transform(result_io)  );
+  set_all_memory( _gvn.transform(result_mem));
+  set_control(    _gvn.transform(result_reg));
+  set_result(     _gvn.transform(result_val));
+  return true;
+}
+
 /**
  * Calculate CRC32 for byte.
  * int java.util.zip.CRC32.update(int crc, int b)
@@ -37,6 +37,7 @@
 #include "opto/divnode.hpp"
 #include "opto/idealGraphPrinter.hpp"
 #include "opto/loopnode.hpp"
+#include "opto/movenode.hpp"
 #include "opto/mulnode.hpp"
 #include "opto/rootnode.hpp"
 #include "opto/superword.hpp"
@@ -264,6 +265,30 @@ void PhaseIdealLoop::set_subtree_ctrl( Node *n ) {
   set_early_ctrl( n );
 }
 
+// Create a loop tree node for 'outer_l' and insert it in the loop tree
+// as the parent of 'loop'.
+IdealLoopTree* PhaseIdealLoop::insert_outer_loop(IdealLoopTree* loop, LoopNode* outer_l, Node* outer_ift) {
+  IdealLoopTree* outer_ilt = new IdealLoopTree(this, outer_l, outer_ift);
+  IdealLoopTree* parent = loop->_parent;
+  IdealLoopTree* sibling = parent->_child;
+  if (sibling == loop) {
+    parent->_child = outer_ilt;
+  } else {
+    while (sibling->_next != loop) {
+      sibling = sibling->_next;
+    }
+    sibling->_next = outer_ilt;
+  }
+  outer_ilt->_next = loop->_next;
+  outer_ilt->_parent = parent;
+  outer_ilt->_child = loop;
+  outer_ilt->_nest = loop->_nest;
+  loop->_parent = outer_ilt;
+  loop->_next = NULL;
+  loop->_nest++;
+  return outer_ilt;
+}
+
 // Create a skeleton strip mined outer loop: a Loop head before the
 // inner strip mined loop, a safepoint and an exit condition guarded
 // by an opaque node after the inner strip mined loop with a backedge
@@ -294,24 +319,7 @@ IdealLoopTree* PhaseIdealLoop::create_outer_strip_mined_loop(BoolNode *test, Nod
   LoopNode *outer_l = new OuterStripMinedLoopNode(C, init_control, outer_ift);
   entry_control = outer_l;
 
-  IdealLoopTree* outer_ilt = new IdealLoopTree(this, outer_l, outer_ift);
-  IdealLoopTree* parent = loop->_parent;
-  IdealLoopTree* sibling = parent->_child;
-  if (sibling == loop) {
-    parent->_child = outer_ilt;
-  } else {
-    while (sibling->_next != loop) {
-      sibling = sibling->_next;
-    }
-    sibling->_next = outer_ilt;
-  }
-  outer_ilt->_next = loop->_next;
-  outer_ilt->_parent = parent;
-  outer_ilt->_child = loop;
-  outer_ilt->_nest = loop->_nest;
-  loop->_parent = outer_ilt;
-  loop->_next = NULL;
-  loop->_nest++;
+  IdealLoopTree* outer_ilt = insert_outer_loop(loop, outer_l, outer_ift);
 
   set_loop(iffalse, outer_ilt);
   register_control(outer_le, outer_ilt, iffalse);
@@ -899,6 +907,250 @@ bool PhaseIdealLoop::is_counted_loop(Node* x, IdealLoopTree*& loop) {
   return true;
 }
 
+//------------------------------create_loop_nest-------------------------------
+// Convert a loop counted with a long induction variable into a loop nest:
+//
+//   for (long i = init; i < limit; i += stride) { body(i); }
+//
+// becomes
+//
+//   long j = init;
+//   do {
+//     int L = (j < limit) ? (int)MIN2(limit - j, max_jint - |stride|) : 0;
+//     for (int k = 0; ; k += stride) {
+//       body(j + k);
+//       if (!(k + stride < L)) break;
+//     }
+//     j += k + stride;
+//   } while (j < limit);
+//
+// The inner loop has an int induction variable and is turned into a
+// CountedLoop by is_counted_loop(), so that range check elimination,
+// unrolling and vectorization apply to it. An inner iteration is only
+// taken if the original long exit test would also have continued; the
+// outer loop evaluates the original test and gets a copy of the backedge
+// safepoint. The inner loop keeps the original one unless counted loops
+// need no safepoints (LoopStripMiningIter == 0). Returns the loop tree
+// node of the outer loop, or NULL if 'loop' does not have the expected
+// shape.
+IdealLoopTree* PhaseIdealLoop::create_loop_nest(IdealLoopTree* loop) {
+  Node* x = loop->_head;
+  // Only a plain loop head with an entry and a single backedge
+  if (x->Opcode() != Op_Loop || x->req() != 3 || loop->_irreducible) {
+    return NULL;
+  }
+  Node* entry_control = x->in(LoopNode::EntryControl);
+  Node* sfpt = x->in(LoopNode::LoopBackControl);
+  if (entry_control == NULL || sfpt == NULL ||
+      entry_control->is_top() || sfpt->is_top()) {
+    return NULL;
+  }
+  // The safepoint on the backedge moves to the outer loop. Without one
+  // there is no valid JVM state for the outer backedge.
+  if (sfpt->Opcode() != Op_SafePoint) {
+    return NULL;
+  }
+  Node* back_control = sfpt->in(TypeFunc::Control);
+  uint back_op = back_control->Opcode();
+  if (back_op != Op_IfTrue && back_op != Op_IfFalse) {
+    return NULL;
+  }
+  IfNode* exit_test = back_control->in(0)->as_If();
+  if (get_loop(exit_test) != loop || !exit_test->in(1)->is_Bool()) {
+    return NULL;
+  }
+  BoolNode* test = exit_test->in(1)->as_Bool();
+  BoolTest::mask bt = test->_test._test;
+  if (back_op == Op_IfFalse) {
+    bt = BoolTest(bt).negate();
+  }
+  Node* cmp = test->in(1);
+  if (cmp->Opcode() != Op_CmpL) {
+    return NULL;
+  }
+  Node* incr = cmp->in(1);
+  Node* limit = cmp->in(2);
+  if (!is_member(loop, get_ctrl(incr))) {
+    incr = cmp->in(2);
+    limit = cmp->in(1);
+    bt = BoolTest(bt).commute();
+  }
+  if (is_member(loop, get_ctrl(limit)) || !is_member(loop, get_ctrl(incr))) {
+    return NULL;
+  }
+  if (incr->Opcode() != Op_AddL) {
+    return NULL;
+  }
+  Node* phi = incr->in(1);
+  Node* stride = incr->in(2);
+  if (!stride->is_Con()) {
+    phi = incr->in(2);
+    stride = incr->in(1);
+  }
+  if (!stride->is_Con() || !phi->is_Phi() || phi->in(0) != x || phi->req() != 3 ||
+      phi->in(LoopNode::LoopBackControl) != incr) {
+    return NULL;
+  }
+  jlong stride_con = stride->get_long();
+  if (stride_con == 0 || stride_con >= max_jint || stride_con <= min_jint) {
+    return NULL;
+  }
+  // Only the canonical forms of the exit test; others are left alone.
+  if ((stride_con > 0 && bt != BoolTest::lt) ||
+      (stride_con < 0 && bt != BoolTest::gt)) {
+    return NULL;
+  }
+
+  // =================================================
+  // ---- SUCCESS!   Found A Long Counted Loop!  -----
+  //
+  Node* exit_branch = exit_test->proj_out(back_op == Op_IfTrue ? 0 : 1);
+  int dd = dom_depth(exit_branch);
+
+  // Clone the control flow of the loop test to build the outer loop:
+  // the inner loop exits to a copy of the original long test which
+  // either leaves the nest or loops back through the safepoint.
+  Node* inner_exit_branch = exit_branch->clone();
+  IfNode* outer_exit_test = new IfNode(inner_exit_branch, test, exit_test->_prob, exit_test->_fcnt);
+  Node* outer_back_branch = back_control->clone();
+  outer_back_branch->set_req(0, outer_exit_test);
+  Node* outer_sfpt = sfpt->clone();
+  outer_sfpt->set_req(TypeFunc::Control, outer_back_branch);
+  LoopNode* outer_head = new LoopNode(entry_control, outer_sfpt);
+
+  IdealLoopTree* outer_ilt = insert_outer_loop(loop, outer_head, outer_sfpt);
+  outer_ilt->_has_sfpt = 1;
+
+  _igvn.register_new_node_with_optimizer(outer_head);
+  set_loop(outer_head, outer_ilt);
+  set_idom(outer_head, entry_control, dom_depth(x));
+  _igvn.replace_input_of(x, LoopNode::EntryControl, outer_head);
+  set_idom(x, outer_head, dom_depth(x));
+
+  _igvn.register_new_node_with_optimizer(inner_exit_branch);
+  set_loop(inner_exit_branch, outer_ilt);
+  set_idom(inner_exit_branch, exit_test, dd);
+  register_control(outer_exit_test, outer_ilt, inner_exit_branch);
+  _igvn.replace_input_of(exit_branch, 0, outer_exit_test);
+  set_idom(exit_branch, outer_exit_test, dd);
+  register_control(outer_back_branch, outer_ilt, outer_exit_test);
+  register_control(outer_sfpt, outer_ilt, outer_back_branch);
+
+  // The inner loop keeps the safepoint on its backedge if counted loops
+  // must poll, so that it is strip mined like any other counted loop and
+  // does not run up to max_jint iterations without a safepoint poll.
+  // Otherwise the safepoint of the outer loop is enough.
+  if (LoopStripMiningIter == 0) {
+    lazy_replace(sfpt, back_control);
+    if (loop->_safepts != NULL) {
+      loop->_safepts->yank(sfpt);
+    }
+  }
+
+  // Outer iv, and the number of iterations the inner loop may run
+  // without the long exit test failing or the int iv overflowing.
+  Node* outer_phi = phi->clone();
+  outer_phi->set_req(0, outer_head);
+  register_new_node(outer_phi, outer_head);
+
+  jlong iters_limit = max_jint - ABS(stride_con);
+  const TypeLong* iters_t = TypeLong::make(0, iters_limit, Type::WidenMin);
+  Node* zero = _igvn.longcon(0);
+  Node* iters_limit_node = _igvn.longcon(iters_limit);
+  set_ctrl(zero, C->root());
+  set_ctrl(iters_limit_node, C->root());
+
+  Node* diff = (stride_con > 0) ? new SubLNode(limit, outer_phi) : new SubLNode(outer_phi, limit);
+  register_new_node(diff, outer_head);
+  Node* diff_cmp = new CmpLNode(diff, iters_limit_node);
+  register_new_node(diff_cmp, outer_head);
+  Node* diff_bol = new BoolNode(diff_cmp, BoolTest::lt);
+  register_new_node(diff_bol, outer_head);
+  // The difference may have overflowed; clamp it and only use it if the
+  // iv has not already reached the limit.
+  Node* clamped = CMoveNode::make(NULL, diff_bol, iters_limit_node, diff, TypeLong::LONG);
+  register_new_node(clamped, outer_head);
+  Node* pos_cmp = new CmpLNode(clamped, zero);
+  register_new_node(pos_cmp, outer_head);
+  Node* pos_bol = new BoolNode(pos_cmp, BoolTest::gt);
+  register_new_node(pos_bol, outer_head);
+  clamped = CMoveNode::make(NULL, pos_bol, zero, clamped, iters_t);
+  register_new_node(clamped, outer_head);
+  Node* reached_cmp = new CmpLNode(outer_phi, limit);
+  register_new_node(reached_cmp, outer_head);
+  Node* reached_bol = new BoolNode(reached_cmp, bt);
+  register_new_node(reached_bol, outer_head);
+  Node* inner_iters = CMoveNode::make(NULL, reached_bol, zero, clamped, iters_t);
+  register_new_node(inner_iters, outer_head);
+
+  Node* inner_limit = new ConvL2INode(inner_iters);
+  register_new_node(inner_limit, outer_head);
+  Node* int_zero = _igvn.intcon(0);
+  set_ctrl(int_zero, C->root());
+  if (stride_con < 0) {
+    inner_limit = new SubINode(int_zero, inner_limit);
+    register_new_node(inner_limit, outer_head);
+  }
+
+  // The int iv of the inner loop and its exit test
+  Node* int_stride = _igvn.intcon((jint)stride_con);
+  set_ctrl(int_stride, C->root());
+  Node* inner_phi = new PhiNode(x, TypeInt::INT);
+  Node* inner_incr = new AddINode(inner_phi, int_stride);
+  inner_phi->init_req(LoopNode::EntryControl, int_zero);
+  inner_phi->init_req(LoopNode::LoopBackControl, inner_incr);
+  register_new_node(inner_phi, x);
+  register_new_node(inner_incr, get_ctrl(incr));
+  Node* inner_cmp = new CmpINode(inner_incr, inner_limit);
+  register_new_node(inner_cmp, get_ctrl(cmp));
+  BoolTest::mask inner_bt = (back_op == Op_IfTrue) ? bt : BoolTest(bt).negate();
+  Node* inner_bol = new BoolNode(inner_cmp, inner_bt);
+  register_new_node(inner_bol, get_ctrl(cmp));
+  _igvn.replace_input_of(exit_test, 1, inner_bol);
+
+  // Every other phi of the loop head gets an outer loop copy
+  for (uint i = 0; i < x->outcnt(); i++) {
+    Node* u = x->raw_out(i);
+    if (u->is_Phi() && u != inner_phi && u != phi) {
+      assert(u->in(0) == x, "inconsistent");
+      Node* clone = u->clone();
+      clone->set_req(0, outer_head);
+      register_new_node(clone, outer_head);
+      _igvn.replace_input_of(u, LoopNode::EntryControl, clone);
+    }
+  }
+
+  // Replace the long iv and its increment by the outer iv plus the
+  // inner int iv. The outer phi's backedge picks up the latter.
+  loop_nest_replace_iv(phi, inner_phi, outer_phi);
+  loop_nest_replace_iv(incr, inner_incr, outer_phi);
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("LoopNest     ");
+    loop->dump_head();
+  }
+#endif
+  C->set_major_progress();
+  return outer_ilt;
+}
+
+Node* PhaseIdealLoop::loop_nest_replace_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi) {
+  Node* iv_as_long = new ConvI2LNode(inner_iv);
+  register_new_node(iv_as_long, get_ctrl(inner_iv));
+  Node* iv_replacement = new AddLNode(outer_phi, iv_as_long);
+  register_new_node(iv_replacement, get_ctrl(inner_iv));
+  for (DUIterator_Last imin, i = iv_to_replace->last_outs(imin); i >= imin;) {
+    Node* u = iv_to_replace->last_out(i);
+    _igvn.rehash_node_delayed(u);
+    int nb = u->replace_edge(iv_to_replace, iv_replacement);
+    i -= nb;
+  }
+  // Now dead; let IGVN clean it up
+  _igvn._worklist.push(iv_to_replace);
+  return iv_replacement;
+}
+
 //----------------------exact_limit-------------------------------------------
 Node* PhaseIdealLoop::exact_limit( IdealLoopTree *loop ) {
   assert(loop->_head->is_CountedLoop(), "");
@@ -2415,6 +2667,12 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
   }
 
   IdealLoopTree* loop = this;
+  IdealLoopTree* loop_nest = NULL;
+  if (UseLongCountedLoopNests && !_head->is_CountedLoop()) {
+    // A loop over a long index becomes an outer loop around an int loop
+    // with the same head, which may then be made a counted loop below.
+    loop_nest = phase->create_loop_nest(this);
+  }
   if (_head->is_CountedLoop() ||
       phase->is_counted_loop(_head, loop)) {
 
@@ -2441,6 +2699,7 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
   assert(loop->_child != this || (loop->_child->_child == NULL && loop->_child->_next == NULL), "would miss some loops");
   if (loop->_child && loop->_child != this) loop->_child->counted_loop(phase);
   if (loop->_next)  loop->_next ->counted_loop(phase);
+  if (loop_nest != NULL && loop_nest->_next != NULL) loop_nest->_next->counted_loop(phase);
 }
 
 #ifndef PRODUCT
@@ -3973,7 +4232,7 @@ Node *PhaseIdealLoop::get_late_ctrl( Node *n, Node *early ) {
     }
     while(worklist.size() != 0 && LCA != early) {
       Node* s = worklist.pop();
-      if (s->is_Load() || s->is_ShenandoahBarrier() || s->Opcode() == Op_SafePoint ||
+      if (s->is_Load() || s->Opcode() == Op_SafePoint ||
           (s->is_CallStaticJava() && s->as_CallStaticJava()->uncommon_trap_request() != 0)) {
         continue;
       } else if (s->is_MergeMem()) {
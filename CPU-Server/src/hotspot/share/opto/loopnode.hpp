@@ -38,8 +38,7 @@ class IdealLoopTree;
 class LoopNode;
 class Node;
 class OuterStripMinedLoopEndNode;
-class ShenandoahBarrierNode;
-class ShenandoahWriteBarrierNode;
+class ShenandoahBarrierC2Support;
 class PathFrequency;
 class PhaseIdealLoop;
 class CountedLoopReserveKit;
@@ -638,8 +637,7 @@ class PhaseIdealLoop : public PhaseTransform {
   friend class IdealLoopTree;
   friend class SuperWord;
   friend class CountedLoopReserveKit;
-  friend class ShenandoahBarrierNode;
-  friend class ShenandoahWriteBarrierNode;
+  friend class ShenandoahBarrierC2Support;
 
   // Pre-computed def-use info
   PhaseIterGVN &_igvn;
@@ -978,6 +976,9 @@ public:
   virtual Node *transform( Node *a_node ) { return 0; }
 
   bool is_counted_loop(Node* x, IdealLoopTree*& loop);
+  IdealLoopTree* create_loop_nest(IdealLoopTree* loop);
+  Node* loop_nest_replace_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi);
+  IdealLoopTree* insert_outer_loop(IdealLoopTree* loop, LoopNode* outer_l, Node* outer_ift);
   IdealLoopTree* create_outer_strip_mined_loop(BoolNode *test, Node *cmp, Node *init_control,
                                                IdealLoopTree* loop, float cl_prob, float le_fcnt,
                                                Node*& entry_control, Node*& iffalse);
@@ -1256,6 +1257,8 @@ public:
 
   // Attempt to use a conditional move instead of a phi/branch
   Node *conditional_move( Node *n );
+  // Replace a min/max diamond in a vectorizable loop with a MinI/MaxI
+  Node *convert_min_max( Node *n );
 
   // Reorganize offset computations to lower register pressure.
   // Mostly prevent loop-fallout uses of the pre-incremented trip counter
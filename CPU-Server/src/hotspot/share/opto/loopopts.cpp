@@ -40,6 +40,7 @@
 #include "opto/opaquenode.hpp"
 #include "opto/rootnode.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_ZGC
 #include "gc/z/c2/zBarrierSetC2.hpp"
@@ -736,6 +737,87 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   return iff->in(1);
 }
 
+//------------------------------convert_min_max--------------------------------
+// Replace the int Phi of a "(P < Q) ? P : Q" style diamond, or of one of its
+// mirrored forms, with a MinI/MaxI. Removing the control flow lets SuperWord
+// vectorize the loop and treat a loop-carried min/max as a reduction. Unlike
+// conditional_move(), this ignores the branch profile, so it is only done in
+// the innermost counted loops that SuperWord can vectorize with MinV/MaxV;
+// everywhere else the diamond is left to conditional_move() and its cost model.
+Node *PhaseIdealLoop::convert_min_max( Node *region ) {
+  assert(region->is_Region(), "sanity check");
+  if (!UseSuperWord || region->req() != 3) return NULL;
+
+  // Check for CFG diamond with nothing pinned in its arms
+  Node *lp = region->in(1);
+  Node *rp = region->in(2);
+  if (!lp || !rp) return NULL;
+  Node *lp_c = lp->in(0);
+  if (lp_c == NULL || lp_c != rp->in(0) || !lp_c->is_If()) return NULL;
+  IfNode *iff = lp_c->as_If();
+  if (lp->outcnt() > 1 || rp->outcnt() > 1) return NULL;
+
+  // Only in the body of an innermost counted loop SuperWord may vectorize
+  IdealLoopTree* loop = get_loop(region);
+  if (loop == _ltree_root || loop->_child != NULL || !loop->_head->is_CountedLoop()) return NULL;
+  CountedLoopNode* cl = loop->_head->as_CountedLoop();
+  if (cl->is_pre_loop() || cl->is_post_loop()) return NULL;
+
+  PhiNode* phi = region->as_Region()->has_unique_phi();
+  if (phi == NULL || phi->type()->basic_type() != T_INT) return NULL;
+
+  Node* bol = iff->in(1);
+  if (!bol->is_Bool()) return NULL;
+  Node* cmp = bol->in(1);
+  if (cmp->Opcode() != Op_CmpI) return NULL;
+
+  bool is_min;
+  switch (bol->as_Bool()->_test._test) {
+  case BoolTest::lt:
+  case BoolTest::le: is_min = true;  break;
+  case BoolTest::gt:
+  case BoolTest::ge: is_min = false; break;
+  default:           return NULL;
+  }
+
+  uint true_path = (lp->Opcode() == Op_IfTrue) ? 1 : 2;
+  Node *p = cmp->in(1);
+  Node *q = cmp->in(2);
+  Node *t = phi->in(  true_path);
+  Node *f = phi->in(3-true_path);
+  if (t == q && f == p) {
+    // "(P < Q) ? Q : P" is max(P, Q), and vice versa.
+    is_min = !is_min;
+  } else if (t != p || f != q) {
+    return NULL;
+  }
+
+  int opc = is_min ? Op_MinI : Op_MaxI;
+  uint vlen = Matcher::max_vector_size(T_INT);
+  if (!VectorNode::implemented(opc, vlen, T_INT) && !ReductionNode::implemented(opc, vlen, T_INT)) {
+    return NULL;
+  }
+
+  // P and Q feed the compare, so they dominate the diamond: nothing needs
+  // to be executed speculatively.
+  Node *ctrl = iff->in(0);
+  Node *minmax = is_min ? (Node*)new MinINode(p, q) : (Node*)new MaxINode(p, q);
+  register_new_node(minmax, ctrl);
+  _igvn.replace_node(phi, minmax);
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("%s  ", is_min ? "MinI" : "MaxI");
+    loop->dump_head();
+  }
+#endif
+
+  // The useless CFG diamond will fold up later; see the optimization in
+  // RegionNode::Ideal.
+  _igvn._worklist.push(region);
+
+  return iff->in(1);
+}
+
 static void enqueue_cfg_uses(Node* m, Unique_Node_List& wq) {
   for (DUIterator_Fast imax, i = m->fast_outs(imax); i < imax; i++) {
     Node* u = m->fast_out(i);
@@ -953,6 +1035,11 @@ Node *PhaseIdealLoop::split_if_with_blocks_pre( Node *n ) {
   // Do not clone-up CmpFXXX variations, as these are always
   // followed by a CmpI
   if( n->is_Cmp() ) return n;
+  // Attempt to turn a min/max diamond into a MinI/MaxI for SuperWord
+  if( n_op == Op_Region ) {
+    Node *minmax = convert_min_max( n );
+    if( minmax ) return minmax;
+  }
   // Attempt to use a conditional move instead of a phi/branch
   if( ConditionalMoveLimit > 0 && n_op == Op_Region ) {
     Node *cmov = conditional_move( n );
@@ -1083,7 +1170,7 @@ static bool merge_point_safe(Node* region) {
         if (m->is_FastLock())
           return false;
 #if INCLUDE_SHENANDOAHGC
-        if (m->is_ShenandoahBarrier() && m->has_out_with(Op_FastLock)) {
+        if (m->Opcode() == Op_ShenandoahLoadReferenceBarrier && m->has_out_with(Op_FastLock)) {
           return false;
         }
 #endif
@@ -3210,7 +3297,7 @@ bool PhaseIdealLoop::partial_peel( IdealLoopTree *loop, Node_List &old_new ) {
 
           // if not pinned and not a load (which maybe anti-dependent on a store)
           // and not a CMove (Matcher expects only bool->cmove).
-          if (n->in(0) == NULL && !n->is_Load() && !n->is_CMove() && n->Opcode() != Op_ShenandoahWBMemProj) {
+          if (n->in(0) == NULL && !n->is_Load() && !n->is_CMove()) {
             cloned_for_outside_use += clone_for_use_outside_loop( loop, n, worklist );
             sink_list.push(n);
             peel     >>= n->_idx; // delete n from peel set.
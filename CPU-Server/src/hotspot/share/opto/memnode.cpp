@@ -1343,13 +1343,17 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
 }
 //------------------------------split_through_phi------------------------------
 // Split instance or boxed field load through Phi.
-Node *LoadNode::split_through_phi(PhaseGVN *phase) {
+// With ignore_missing_instance_id the load is split even though its
+// address has no unique instance type yet (used by escape analysis to
+// reduce Phis which merge allocations).
+Node *LoadNode::split_through_phi(PhaseGVN *phase, bool ignore_missing_instance_id) {
   Node* mem     = in(Memory);
   Node* address = in(Address);
   const TypeOopPtr *t_oop = phase->type(address)->isa_oopptr();
 
   assert((t_oop != NULL) &&
-         (t_oop->is_known_instance_field() ||
+         (ignore_missing_instance_id ||
+          t_oop->is_known_instance_field() ||
           t_oop->is_ptr_to_boxed_value()), "invalide conditions");
 
   Compile* C = phase->C;
@@ -1361,7 +1365,7 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (ignore_missing_instance_id || load_boxed_values || t_oop->is_known_instance_field()))) {
     return NULL; // memory is not Phi
   }
 
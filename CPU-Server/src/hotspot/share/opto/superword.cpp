@@ -2414,7 +2414,7 @@ void SuperWord::output() {
           vlen_in_bytes = vn->as_Vector()->length_in_bytes();
         }
       } else if (opc == Op_SqrtF || opc == Op_SqrtD ||
-                 opc == Op_AbsF || opc == Op_AbsD ||
+                 opc == Op_AbsI || opc == Op_AbsF || opc == Op_AbsD ||
                  opc == Op_NegF || opc == Op_NegD ||
                  opc == Op_PopCountI) {
         assert(n->req() == 2, "only one input expected");
@@ -568,6 +568,9 @@ static SpecialFlag const special_jvm_flags[] = {
   { "SyncKnobs",                     JDK_Version::undefined(), JDK_Version::jdk(12), JDK_Version::jdk(13) },
   { "MonitorInUseLists",             JDK_Version::jdk(10),     JDK_Version::jdk(12), JDK_Version::jdk(13) },
   { "AggressiveOpts",                JDK_Version::jdk(11),     JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "BindGCTaskThreadsToCPUs",       JDK_Version::undefined(), JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "UseGCTaskAffinity",             JDK_Version::undefined(), JDK_Version::jdk(12), JDK_Version::jdk(13) },
+  { "GCTaskTimeStampEntries",        JDK_Version::undefined(), JDK_Version::jdk(12), JDK_Version::jdk(13) },
 
 #ifdef TEST_VERIFY_SPECIAL_JVM_FLAGS
   { "dep > obs",                    JDK_Version::jdk(9), JDK_Version::jdk(8), JDK_Version::undefined() },
@@ -1928,13 +1931,6 @@ jint Arguments::set_aggressive_heap_flags() {
     return JNI_EINVAL;
   }
 
-  // Get around early Solaris scheduling bug
-  // (affinity vs other jobs on system)
-  // but disallow DR and offlining (5008695).
-  if (FLAG_SET_CMDLINE(bool, BindGCTaskThreadsToCPUs, true) != JVMFlag::SUCCESS) {
-    return JNI_EINVAL;
-  }
-
   return JNI_OK;
 }
 
@@ -3907,6 +3903,36 @@ jint Arguments::parse(const JavaVMInitArgs* initial_cmd_args) {
     return result;
   }
 
+#if INCLUDE_CDS
+  if (ArchiveClassesAtExit != NULL) {
+    if (DumpSharedSpaces) {
+      // The dump started at exit may inherit the option through JAVA_TOOL_OPTIONS.
+      FLAG_SET_DEFAULT(ArchiveClassesAtExit, NULL);
+    } else if (DumpLoadedClassList != NULL) {
+      warning("ArchiveClassesAtExit is ignored when DumpLoadedClassList is specified");
+      FLAG_SET_DEFAULT(ArchiveClassesAtExit, NULL);
+    } else {
+#ifdef _WINDOWS
+      warning("ArchiveClassesAtExit is not supported on this platform");
+      FLAG_SET_DEFAULT(ArchiveClassesAtExit, NULL);
+#else
+      // Record the loaded classes next to the archive, in a list private to
+      // this process, since the dump at exit may overlap with later runs.
+      size_t len = strlen(ArchiveClassesAtExit) + strlen(".2147483647.classlist") + 1;
+      char* list_name = NEW_C_HEAP_ARRAY(char, len, mtArguments);
+      jio_snprintf(list_name, len, "%s.%d.classlist", ArchiveClassesAtExit, os::current_process_id());
+      FLAG_SET_ERGO(ccstr, DumpLoadedClassList, list_name);
+
+      // Map the archive written by a previous run, unless another one is requested.
+      struct stat st;
+      if (SharedArchiveFile == NULL && os::stat(ArchiveClassesAtExit, &st) == 0) {
+        FLAG_SET_ERGO(ccstr, SharedArchiveFile, ArchiveClassesAtExit);
+      }
+#endif // _WINDOWS
+    }
+  }
+#endif // INCLUDE_CDS
+
   // Call get_shared_archive_path() here, after possible SharedArchiveFile option got parsed.
   SharedArchivePath = get_shared_archive_path();
   if (SharedArchivePath == NULL) {
@@ -4102,15 +4128,17 @@ jint Arguments::adjust_after_os() {
          FLAG_SET_DEFAULT(MinHeapDeltaBytes, 64*M);
       }
     }
-    // UseNUMAInterleaving is set to ON for all collectors and
-    // platforms when UseNUMA is set to ON. NUMA-aware collectors
+    // UseNUMAInterleaving is set to ON for all collectors but G1 and
+    // all platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
     // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
+    // Non NUMA-aware collectors such as CMS and Serial-GC on
     // all platforms and ParallelGC on Windows will interleave all
     // of the heap spaces across NUMA nodes.
-    if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
+    // G1 places each heap region on a specific node itself, so
+    // interleaving would only fight its placement.
+    if (FLAG_IS_DEFAULT(UseNUMAInterleaving) && !UseG1GC) {
       FLAG_SET_ERGO(bool, UseNUMAInterleaving, true);
     }
   }
@@ -459,6 +459,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   diagnostic(bool, UseVectorizedMismatchIntrinsic, false,                   \
           "Enables intrinsification of ArraysSupport.vectorizedMismatch()") \
                                                                             \
+  diagnostic(bool, UseVectorizedHashCodeIntrinsic, false,                   \
+          "Enables intrinsification of String.hashCode() and "              \
+          "Arrays.hashCode() of byte, char, short and int arrays")          \
+                                                                            \
   diagnostic(ccstrlist, DisableIntrinsic, "",                               \
          "do not expand intrinsics whose (internal) names appear here")     \
                                                                             \
@@ -650,6 +654,12 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(size_t, NativeMemoryTrackingSampleInterval, 0,                    \
+          "Average number of malloc'ed bytes between the allocations "      \
+          "whose call sites are recorded by detail native memory "          \
+          "tracking (0 records every allocation)")                          \
+          range(0, max_intx)                                                \
+                                                                            \
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -813,6 +823,19 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Allow parallel defineClass requests for class loaders "          \
           "registering as parallel capable")                                \
                                                                             \
+  product(bool, ParallelClassLinking, false,                                \
+          "Link (verify and rewrite) classes defined by the builtin class " \
+          "loaders eagerly in background threads")                          \
+                                                                            \
+  product(uintx, ParallelClassLinkingThreads, 2,                            \
+          "Number of threads used by ParallelClassLinking")                 \
+          range(1, 64)                                                      \
+                                                                            \
+  product(uintx, ParallelClassLinkingQueueSize, 10000,                      \
+          "Maximum number of classes waiting to be linked by "              \
+          "ParallelClassLinking; further classes are linked on demand")     \
+          range(1, max_juint)                                               \
+                                                                            \
   product_pd(bool, DontYieldALot,                                           \
           "Throw away obvious excess yield calls")                          \
                                                                             \
@@ -837,6 +860,16 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
                 "The check is performed on GuaranteedSafepointInterval.")   \
                 range(0, 100)                                               \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors, false,                            \
+          "Deflate idle monitors in the ServiceThread instead of during "   \
+          "safepoint cleanup")                                              \
+                                                                            \
+  product(intx, AsyncDeflationInterval, 250,                                \
+          "Interval in milliseconds at which the ServiceThread checks "     \
+          "MonitorUsedDeflationThreshold when AsyncDeflateIdleMonitors "    \
+          "is enabled (a threshold of 0 deflates on every interval)")       \
+          range(1, max_jint)                                                \
+                                                                            \
   experimental(intx, hashCode, 5,                                           \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -1278,6 +1311,15 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, DisplayVMOutputToStdout, false,                             \
           "If DisplayVMOutput is true, display all VM output to stdout")    \
                                                                             \
+  product(bool, AsyncLogging, false,                                        \
+          "Buffer unified logging messages and write them to the log "      \
+          "outputs from a separate thread")                                 \
+                                                                            \
+  product(uintx, AsyncLogBufferEntries, 8192,                               \
+          "Number of messages each log output buffers with AsyncLogging. "  \
+          "Messages logged while the buffer is full are dropped")           \
+          range(16, 1*M)                                                    \
+                                                                            \
   product(bool, UseHeavyMonitors, false,                                    \
           "use heavyweight instead of lightweight Java monitors")           \
                                                                             \
@@ -1894,6 +1936,21 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Size of code heap with non-nmethods (in bytes)")                 \
           range(os::vm_page_size(), max_uintx)                              \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of code heap with the level 4 code of hot methods, taken "  \
+          "from the non-profiled code heap (in bytes, 0 disables it)")      \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(intx, HotCodeSampleThreshold, 100,                                \
+          "Number of times an nmethod must be found on a thread stack at "  \
+          "a safepoint before it is recompiled into the hot code heap")     \
+          range(1, max_jint)                                                \
+                                                                            \
+  product(intx, HotCodeSweepInterval, 1000,                                 \
+          "Interval (in ms) at which the sweeper looks for hot nmethods "   \
+          "if the hot code heap is used")                                   \
+          range(1, max_jint)                                                \
+                                                                            \
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
           range(32*K, max_uintx)                                            \
@@ -2003,6 +2060,17 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, DumpReplayDataOnError, true,                                \
           "Record replay data for crashing compiler threads")               \
                                                                             \
+  product(ccstr, ProfileCacheFile, NULL,                                    \
+          "File holding the profiles of hot methods persisted across runs") \
+                                                                            \
+  product(bool, UseProfileCache, false,                                     \
+          "Seed method profiles and counters from ProfileCacheFile when "   \
+          "classes are linked")                                             \
+                                                                            \
+  product(bool, DumpProfileCacheAtExit, false,                              \
+          "Write the profiles of methods compiled at the highest tier to "  \
+          "ProfileCacheFile at exit")                                       \
+                                                                            \
   product(bool, CICompilerCountPerCPU, false,                               \
           "1 compiler thread for log(N CPUs)")                              \
                                                                             \
@@ -2520,6 +2588,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Dump the names all loaded classes, that could be stored into "   \
           "the CDS archive, in the specified file")                         \
                                                                             \
+  product(ccstr, ArchiveClassesAtExit, NULL,                                \
+          "Write a CDS archive with the classes loaded by the built-in "    \
+          "class loaders in this run to the specified file at VM exit")     \
+                                                                            \
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
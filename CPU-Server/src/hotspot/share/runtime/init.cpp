@@ -75,6 +75,7 @@ void vmStructs_init();
 void vtableStubs_init();
 void InlineCacheBuffer_init();
 void compilerOracle_init();
+void profileCache_init();
 bool compileBroker_init();
 void dependencyContext_init();
 
@@ -133,6 +134,7 @@ jint init_globals() {
   vtableStubs_init();
   InlineCacheBuffer_init();
   compilerOracle_init();
+  profileCache_init();
   dependencyContext_init();
 
   if (!compileBroker_init()) {
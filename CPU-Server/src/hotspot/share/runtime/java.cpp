@@ -32,6 +32,7 @@
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/profileCache.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/support/jfrThreadId.hpp"
@@ -40,7 +41,10 @@
 #include "jvmci/jvmciRuntime.hpp"
 #endif
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
+#include "memory/dynamicArchive.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -465,6 +469,9 @@ void before_exit(JavaThread* thread) {
     os::infinite_sleep();
   }
 
+  ProfileCache::dump_at_exit();
+  DynamicArchive::dump_at_exit();
+
   EventThreadEnd event;
   if (event.should_commit()) {
     event.set_thread(JFR_THREAD_ID(thread));
@@ -519,6 +526,9 @@ void before_exit(JavaThread* thread) {
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  // Write out the buffered log messages, log synchronously from now on
+  LogAsyncWriter::stop();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
@@ -567,6 +577,7 @@ void notify_vm_shutdown() {
 }
 
 void vm_direct_exit(int code) {
+  LogConfiguration::try_write_async_messages();
   notify_vm_shutdown();
   os::wait_for_keypress_at_exit();
   os::exit(code);
@@ -125,6 +125,13 @@ class ObjectWaiter : public StackObj {
 //     intptr_t. There's no reason to use a 64-bit type for this field
 //     in a 64-bit JVM.
 
+// The ServiceThread stores DEFLATER_MARKER in _owner while it decides
+// whether an idle monitor can be deflated asynchronously (see
+// ObjectSynchronizer::deflate_monitor_async()). It is never a valid
+// Thread* or BasicLock*, so every acquisition path simply fails its CAS
+// of _owner from NULL and treats the monitor as owned.
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
 class ObjectMonitor {
  public:
   enum {
@@ -166,6 +173,8 @@ class ObjectMonitor {
   volatile jint  _count;            // reference count to prevent reclamation/deflation
                                     // at stop-the-world time.  See deflate_idle_monitors().
                                     // _count is approximately |_WaitSet| + |_EntryList|
+                                    // A negative _count marks a monitor that was deflated
+                                    // asynchronously.  See deflate_monitor_async().
  protected:
   ObjectWaiter * volatile _WaitSet; // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
@@ -250,6 +259,16 @@ class ObjectMonitor {
   jint      contentions() const;
   intptr_t  recursions() const                                         { return _recursions; }
 
+  // Asynchronous deflation support.  A thread that found the monitor in
+  // an object's mark word pins it with try_inc_count() before it relies
+  // on the monitor staying associated with the object.  The pin fails
+  // if the ServiceThread has already deflated the monitor, in which case
+  // the caller must re-read the mark word and inflate again.
+  bool      try_inc_count();
+  void      dec_count();
+  bool      is_async_deflated() const                                  { return _count < 0; }
+  void      clear_async_deflated();
+
   // JVM/TI GetObjectMonitorUsage() needs this:
   ObjectWaiter* first_waiter()                                         { return _WaitSet; }
   ObjectWaiter* next_waiter(ObjectWaiter* o)                           { return o->_next; }
@@ -290,7 +309,9 @@ class ObjectMonitor {
   void      check_slow(TRAPS);
   void      clear();
 
-  void      enter(TRAPS);
+  // enter() and reenter() return false, without entering the monitor, if
+  // the monitor was deflated asynchronously after the caller looked it up.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -298,7 +319,7 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter(ObjectWaiter * waiter);
@@ -25,6 +25,8 @@
 #ifndef SHARE_VM_RUNTIME_OBJECTMONITOR_INLINE_HPP
 #define SHARE_VM_RUNTIME_OBJECTMONITOR_INLINE_HPP
 
+#include "runtime/atomic.hpp"
+
 inline intptr_t ObjectMonitor::is_entered(TRAPS) const {
   if (THREAD == _owner || THREAD->is_lock_owned((address) _owner)) {
     return 1;
@@ -69,6 +71,20 @@ inline void ObjectMonitor::clear() {
   _object = NULL;
 }
 
+// Prepare a monitor deflated by the ServiceThread for the free list.  By
+// now a safepoint has passed since the deflation, so no thread can still
+// be looking at the monitor through a stale mark word.
+inline void ObjectMonitor::clear_async_deflated() {
+  assert(_count == -max_jint, "Fatal logic error in ObjectMonitor count!");
+  assert(_owner == DEFLATER_MARKER, "Fatal logic error in ObjectMonitor owner!");
+  assert(_object == NULL, "Fatal logic error in ObjectMonitor object!");
+  assert(_waiters == 0, "Fatal logic error in ObjectMonitor waiters!");
+
+  _header = NULL;
+  _owner = NULL;
+  _count = 0;
+}
+
 
 inline void* ObjectMonitor::object() const {
   return _object;
@@ -98,7 +114,21 @@ inline bool ObjectMonitor::check(TRAPS) {
 
 // return number of threads contending for this monitor
 inline jint ObjectMonitor::contentions() const {
-  return _count;
+  jint count = _count;
+  return count > 0 ? count : 0;
+}
+
+inline bool ObjectMonitor::try_inc_count() {
+  if (Atomic::add(1, &_count) > 0) {
+    return true;
+  }
+  // The deflater won the race; undo our increment.
+  Atomic::dec(&_count);
+  return false;
+}
+
+inline void ObjectMonitor::dec_count() {
+  Atomic::dec(&_count);
 }
 
 // Do NOT set _count = 0. There is a race such that _count could
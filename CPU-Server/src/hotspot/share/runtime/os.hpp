@@ -407,6 +407,9 @@ class os: AllStatic {
   static size_t numa_get_leaf_groups(int *ids, size_t size);
   static bool   numa_topology_changed();
   static int    numa_get_group_id();
+  // Returns the group id of the memory backing the given address, or -1 if
+  // it cannot be determined (e.g. the page has not been touched yet).
+  static int    numa_get_group_id_for_address(const void* address);
 
   // Page manipulation
   struct page_info {
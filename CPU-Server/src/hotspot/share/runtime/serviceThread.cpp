@@ -33,6 +33,7 @@
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/resolvedMethodTable.hpp"
 #include "services/diagnosticArgument.hpp"
@@ -124,6 +125,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool resolved_method_table_work = false;
     bool protection_domain_table_work = false;
     bool oopstorage_work = false;
+    bool deflate_idle_monitors = false;
     bool oopstorages_cleanup[oopstorage_count] = {}; // Zero (false) initialize.
     JvmtiDeferredEvent jvmti_event;
     {
@@ -152,11 +154,14 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (protection_domain_table_work = SystemDictionary::pd_cache_table()->has_work()) |
               (oopstorage_work = needs_oopstorage_cleanup(oopstorages,
                                                           oopstorages_cleanup,
-                                                          oopstorage_count)))
+                                                          oopstorage_count)) |
+              (deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed()))
 
              == 0) {
-        // Wait until notified that there is some work to do.
-        ml.wait(Mutex::_no_safepoint_check_flag);
+        // Wait until notified that there is some work to do.  Idle
+        // monitors are checked for periodically, nobody notifies us.
+        ml.wait(Mutex::_no_safepoint_check_flag,
+                AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -199,6 +204,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (oopstorage_work) {
       cleanup_oopstorages(oopstorages, oopstorages_cleanup, oopstorage_count);
     }
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_async(jt);
+    }
   }
 }
 
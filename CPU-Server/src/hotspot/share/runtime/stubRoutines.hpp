@@ -195,6 +195,7 @@ class StubRoutines: AllStatic {
   static address _montgomerySquare;
 
   static address _vectorizedMismatch;
+  static address _vectorizedHashCode;
 
   static address _dexp;
   static address _dlog;
@@ -370,6 +371,7 @@ class StubRoutines: AllStatic {
   static address montgomerySquare()    { return _montgomerySquare; }
 
   static address vectorizedMismatch()  { return _vectorizedMismatch; }
+  static address vectorizedHashCode()  { return _vectorizedHashCode; }
 
   static address dexp()                { return _dexp; }
   static address dlog()                { return _dlog; }
@@ -159,6 +159,7 @@ int    NMethodSweeper::_hotness_counter_reset_val       = 0;
 long   NMethodSweeper::_total_nof_methods_reclaimed     = 0;   // Accumulated nof methods flushed
 long   NMethodSweeper::_total_nof_c2_methods_reclaimed  = 0;   // Accumulated nof methods flushed
 size_t NMethodSweeper::_total_flushed_size              = 0;   // Total number of bytes flushed from the code cache
+long   NMethodSweeper::_total_nof_hot_recompiles        = 0;   // Accumulated nof hot methods recompiled into the hot code heap
 Tickspan NMethodSweeper::_total_time_sweeping;                 // Accumulated time sweeping
 Tickspan NMethodSweeper::_total_time_this_sweep;               // Total time this sweep
 Tickspan NMethodSweeper::_peak_sweep_time;                     // Peak time for a full sweep
@@ -170,6 +171,7 @@ public:
     assert(cb->is_nmethod(), "CodeBlob should be nmethod");
     nmethod* nm = (nmethod*)cb;
     nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
+    nm->inc_hot_samples();
     // If we see an activation belonging to a non_entrant nmethod, we mark it.
     if (nm->is_not_entrant()) {
       nm->mark_as_seen_on_stack();
@@ -184,6 +186,7 @@ public:
     assert(cb->is_nmethod(), "CodeBlob should be nmethod");
     nmethod* nm = (nmethod*)cb;
     nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
+    nm->inc_hot_samples();
   }
 };
 static SetHotnessClosure set_hotness_closure;
@@ -342,8 +345,11 @@ void NMethodSweeper::sweeper_loop() {
     {
       ThreadBlockInVM tbivm(JavaThread::current());
       MutexLockerEx waiter(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-      const long wait_time = 60*60*24 * 1000;
+      // With a hot code heap, wake up periodically to look for hot nmethods
+      const bool hot_heap = CodeCache::heap_available(CodeBlobType::MethodHot);
+      const long wait_time = hot_heap ? HotCodeSweepInterval : 60*60*24 * 1000;
       timeout = CodeCache_lock->wait(Mutex::_no_safepoint_check_flag, wait_time);
+      timeout = timeout && !hot_heap;
     }
     if (!timeout) {
       possibly_sweep();
@@ -738,6 +744,7 @@ NMethodSweeper::MethodStateChange NMethodSweeper::process_compiled_method(Compil
     }
   } else {
     if (cm->is_nmethod()) {
+      possibly_move_to_hot_heap((nmethod*)cm);
       possibly_flush((nmethod*)cm);
     }
     // Clean inline caches that point to zombie/non-entrant/unloaded nmethods
@@ -748,6 +755,51 @@ NMethodSweeper::MethodStateChange NMethodSweeper::process_compiled_method(Compil
 }
 
 
+// Recompiles the level 4 code of a method into the hot code heap if its nmethod
+// was found often enough on thread stacks since the last sweep. Installing the
+// new code makes the old nmethod not entrant, the sweeper reclaims it later.
+void NMethodSweeper::possibly_move_to_hot_heap(nmethod* nm) {
+  if (!CodeCache::heap_available(CodeBlobType::MethodHot)) {
+    return;
+  }
+  int samples = nm->hot_samples();
+  nm->reset_hot_samples();
+  // Blocking compiles would stall the sweeper until the compile finished
+  if (samples < HotCodeSampleThreshold || !BackgroundCompilation ||
+      !nm->is_in_use() || nm->is_osr_method() || nm->is_native_method() ||
+      nm->comp_level() != CompLevel_full_optimization ||
+      CodeCache::get_code_blob_type(nm) == CodeBlobType::MethodHot ||
+      CodeCache::unallocated_capacity(CodeBlobType::MethodHot) < (size_t)nm->total_size()) {
+    return;
+  }
+  Method* method = nm->method();
+  if (method->is_hot_code() || method->code() != nm) {
+    // Already requested or superseded
+    return;
+  }
+
+  JavaThread* thread = JavaThread::current();
+  HandleMark hm(thread);
+  methodHandle mh(thread, method);
+  // Keep the holder alive in case we block at a safepoint while submitting the compile
+  Handle holder(thread, mh->method_holder()->klass_holder());
+  mh->set_is_hot_code(true);
+  CompileBroker::compile_method(mh, InvocationEntryBci, CompLevel_full_optimization, mh, samples,
+                                CompileTask::Reason_HotCode, thread);
+  if (thread->has_pending_exception()) {
+    thread->clear_pending_exception();
+  }
+  if (!mh->queued_for_compilation() && mh->code() == nm) {
+    // The compile was rejected (queue full, not compilable), so the next
+    // level 4 compile of the method must not go to the hot code heap.
+    mh->set_is_hot_code(false);
+    return;
+  }
+  log_debug(codecache, sweep)("Recompiling hot nmethod %d (%d samples) of %s into the hot code heap",
+                              nm->compile_id(), samples, mh->name_and_sig_as_C_string());
+  _total_nof_hot_recompiles++;
+}
+
 void NMethodSweeper::possibly_flush(nmethod* nm) {
   if (UseCodeCacheFlushing) {
     if (!nm->is_locked_by_vm() && !nm->is_native_method() && !nm->is_not_installed() && !nm->is_unloading()) {
@@ -881,4 +933,7 @@ void NMethodSweeper::print(outputStream* out) {
   out->print_cr("  Total number of flushed methods: %ld (thereof %ld C2 methods)", _total_nof_methods_reclaimed,
                                                     _total_nof_c2_methods_reclaimed);
   out->print_cr("  Total size of flushed methods:   " SIZE_FORMAT " kB", _total_flushed_size/K);
+  if (CodeCache::heap_available(CodeBlobType::MethodHot)) {
+    out->print_cr("  Total number of hot recompiles:  %ld", _total_nof_hot_recompiles);
+  }
 }
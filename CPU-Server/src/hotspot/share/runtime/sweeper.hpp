@@ -81,6 +81,7 @@ class NMethodSweeper : public AllStatic {
   static long      _total_nof_methods_reclaimed;    // Accumulated nof methods flushed
   static long      _total_nof_c2_methods_reclaimed; // Accumulated nof C2-compiled methods flushed
   static size_t    _total_flushed_size;             // Total size of flushed methods
+  static long      _total_nof_hot_recompiles;       // Accumulated nof methods recompiled into the hot code heap
   static int       _hotness_counter_reset_val;
 
   static Tickspan  _total_time_sweeping;          // Accumulated time sweeping
@@ -123,6 +124,7 @@ class NMethodSweeper : public AllStatic {
   static void report_state_change(nmethod* nm);
   static void possibly_enable_sweeper();
   static void possibly_flush(nmethod* nm);
+  static void possibly_move_to_hot_heap(nmethod* nm);
   static void print(outputStream* out);   // Printing/debugging
   static void print() { print(tty); }
 };
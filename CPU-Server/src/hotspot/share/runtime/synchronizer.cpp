@@ -40,11 +40,13 @@
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
 #include "runtime/timer.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -128,6 +130,14 @@ static volatile intptr_t gListLock = 0;      // protects global monitor lists
 static volatile int gMonitorFreeCount  = 0;  // # on gFreeList
 static volatile int gMonitorPopulation = 0;  // # Extant -- in circulation
 
+// Monitors deflated by the ServiceThread wait on gDeflatedList until a
+// safepoint has passed before they are returned to gFreeList.  Only the
+// ServiceThread updates these.  See recycle_deflated_monitors().
+static ObjectMonitor * volatile gDeflatedList = NULL;
+static int gDeflatedCount = 0;
+static uint64_t gDeflatedSafepointCounter = 0;
+static jlong gLastAsyncDeflation = 0;        // javaTimeMillis() of last pass
+
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
 
@@ -169,7 +179,8 @@ bool ObjectSynchronizer::quick_notify(oopDesc * obj, Thread * self, bool all) {
 
   if (mark->has_monitor()) {
     ObjectMonitor * const mon = mark->monitor();
-    assert(oopDesc::equals((oop) mon->object(), obj), "invariant");
+    assert(oopDesc::equals((oop) mon->object(), obj) ||
+           (AsyncDeflateIdleMonitors && mon->is_async_deflated()), "invariant");
     if (mon->owner() != self) return false;  // slow-path for IMS exception
 
     if (mon->first_waiter() != NULL) {
@@ -213,7 +224,8 @@ bool ObjectSynchronizer::quick_enter(oop obj, Thread * Self,
 
   if (mark->has_monitor()) {
     ObjectMonitor * const m = mark->monitor();
-    assert(oopDesc::equals((oop) m->object(), obj), "invariant");
+    assert(oopDesc::equals((oop) m->object(), obj) ||
+           (AsyncDeflateIdleMonitors && m->is_async_deflated()), "invariant");
     Thread * const owner = (Thread *) m->_owner;
 
     // Lock contention and Transactional Lock Elision (TLE) diagnostics
@@ -361,9 +373,11 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD,
-                              obj(),
-                              inflate_cause_monitor_enter)->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD,
+                                      obj(),
+                                      inflate_cause_monitor_enter)->enter(THREAD)) {
+    // The monitor was deflated asynchronously; inflate again.
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -406,11 +420,14 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
-                                                       obj(),
-                                                       inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  // The object is unlocked between complete_exit() and reenter(), so its
+  // monitor may have been deflated asynchronously in the meantime.
+  ObjectMonitor* monitor;
+  do {
+    monitor = ObjectSynchronizer::inflate(THREAD,
+                                          obj(),
+                                          inflate_cause_vm_internal);
+  } while (!monitor->reenter(recursion, THREAD));
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -422,7 +439,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD)) {
+    // The monitor was deflated asynchronously; inflate again.
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -776,8 +795,12 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
     // correctly.
   }
 
-  // Inflate the monitor to set hash code
-  monitor = ObjectSynchronizer::inflate(Self, obj, inflate_cause_hash_code);
+  // Inflate the monitor to set hash code.  Pin it while we update the
+  // header so that an asynchronous deflation cannot restore the object's
+  // mark from a header without the hash.
+  do {
+    monitor = ObjectSynchronizer::inflate(Self, obj, inflate_cause_hash_code);
+  } while (!monitor->try_inc_count());
   // Load displaced header and check it has hash code
   mark = monitor->header();
   assert(mark->is_neutral(), "invariant");
@@ -796,6 +819,7 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
       assert(hash != 0, "Trivial unexpected object/monitor header usage.");
     }
   }
+  monitor->dec_count();
   // We finally get the hash
   return hash;
 }
@@ -955,6 +979,11 @@ static bool monitors_used_above_threshold() {
 }
 
 bool ObjectSynchronizer::is_cleanup_needed() {
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the ServiceThread.  It only needs a
+    // safepoint to pass before it can reuse the monitors it deflated.
+    return gDeflatedList != NULL;
+  }
   if (MonitorUsedDeflationThreshold > 0) {
     return monitors_used_above_threshold();
   }
@@ -1032,6 +1061,12 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // The ServiceThread deflates without a safepoint; just wake it up.
+      MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+      Service_lock->notify_all();
+      return;
+    }
     // Induce a 'null' safepoint to scavenge monitors
     // Must VM_Operation instance be heap allocated as the op will be enqueue and posted
     // to the VMthread and have a lifespan longer than that of this activation record.
@@ -1040,6 +1075,22 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   }
 }
 
+// With AsyncDeflateIdleMonitors the ServiceThread unlinks idle monitors
+// from a thread's omInUseList while that thread keeps inflating, so
+// changes to omInUseList and omInUseCount are made under the thread's
+// omInUseListLock.  Safepoint-time walks of the list don't need it.
+static inline void lock_in_use_list(Thread* t) {
+  if (AsyncDeflateIdleMonitors) {
+    Thread::SpinAcquire(&t->omInUseListLock, "omInUseListLock");
+  }
+}
+
+static inline void unlock_in_use_list(Thread* t) {
+  if (AsyncDeflateIdleMonitors) {
+    Thread::SpinRelease(&t->omInUseListLock);
+  }
+}
+
 ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
   // A large MAXPRIVATE value reduces both list lock contention
   // and list coherency traffic, but also tends to increase the
@@ -1061,9 +1112,11 @@ ObjectMonitor* ObjectSynchronizer::omAlloc(Thread * Self) {
       Self->omFreeList = m->FreeNext;
       Self->omFreeCount--;
       guarantee(m->object() == NULL, "invariant");
+      lock_in_use_list(Self);
       m->FreeNext = Self->omInUseList;
       Self->omInUseList = m;
       Self->omInUseCount++;
+      unlock_in_use_list(Self);
       return m;
     }
 
@@ -1186,6 +1239,7 @@ void ObjectSynchronizer::omRelease(Thread * Self, ObjectMonitor * m,
   guarantee(((m->is_busy()|m->_recursions) == 0), "freeing in-use monitor");
   // Remove from omInUseList
   if (fromPerThreadAlloc) {
+    lock_in_use_list(Self);
     ObjectMonitor* cur_mid_in_use = NULL;
     bool extracted = false;
     for (ObjectMonitor* mid = Self->omInUseList; mid != NULL; cur_mid_in_use = mid, mid = mid->FreeNext) {
@@ -1201,6 +1255,7 @@ void ObjectSynchronizer::omRelease(Thread * Self, ObjectMonitor * m,
         break;
       }
     }
+    unlock_in_use_list(Self);
     assert(extracted, "Should have extracted from in-use list");
   }
 
@@ -1251,6 +1306,7 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
     guarantee(tail != NULL && list != NULL, "invariant");
   }
 
+  lock_in_use_list(Self);
   ObjectMonitor * inUseList = Self->omInUseList;
   ObjectMonitor * inUseTail = NULL;
   int inUseTally = 0;
@@ -1269,6 +1325,7 @@ void ObjectSynchronizer::omFlush(Thread * Self) {
     Self->omInUseCount = 0;
     guarantee(inUseTail != NULL && inUseList != NULL, "invariant");
   }
+  unlock_in_use_list(Self);
 
   Thread::muxAcquire(&gListLock, "omFlush");
   if (tail != NULL) {
@@ -1338,7 +1395,10 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread * Self,
     if (mark->has_monitor()) {
       ObjectMonitor * inf = mark->monitor();
       assert(inf->header()->is_neutral(), "invariant");
-      assert(oopDesc::equals((oop) inf->object(), object), "invariant");
+      // An asynchronously deflated monitor drops its object right after
+      // the mark word was restored, which may be after we read the mark.
+      assert(oopDesc::equals((oop) inf->object(), object) ||
+             (AsyncDeflateIdleMonitors && inf->is_async_deflated()), "invariant");
       assert(ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
       return inf;
     }
@@ -1627,6 +1687,10 @@ void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* c
 
 void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors) {
+    // The ServiceThread scans gOmInUseList, see deflate_idle_monitors_async().
+    return;
+  }
   bool deflated = false;
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
@@ -1674,10 +1738,12 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 
   // Consider: audit gFreeList to ensure that gMonitorFreeCount and list agree.
 
-  ForceMonitorScavenge = 0;    // Reset
-
   OM_PERFDATA_OP(Deflations, inc(counters->nScavenged));
-  OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+  if (!AsyncDeflateIdleMonitors) {
+    // Otherwise the ServiceThread resets these after its own pass.
+    ForceMonitorScavenge = 0;    // Reset
+    OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+  }
 
   // TODO: Add objectMonitor leak detection.
   // Audit/inventory the objectMonitors -- make sure they're all accounted for.
@@ -1687,6 +1753,12 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors && thread->is_Java_thread()) {
+    // Java threads' monitors are deflated by the ServiceThread, see
+    // deflate_idle_monitors_async().  The few monitors inflated by other
+    // threads are still deflated here.
+    return;
+  }
 
   ObjectMonitor * freeHeadp = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor * freeTailp = NULL;
@@ -1722,6 +1794,206 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
   Thread::muxRelease(&gListLock);
 }
 
+// -----------------------------------------------------------------------------
+// Asynchronous monitor deflation
+// ------------------------------
+// With AsyncDeflateIdleMonitors the ServiceThread deflates idle monitors
+// while Java threads keep running, so safepoint cleanup no longer walks
+// the in-use lists of all threads.  Taking a monitor away from its object
+// takes three steps, each of which a racing thread can make fail:
+//
+//   1. CAS _owner from NULL to DEFLATER_MARKER.  All acquisition paths
+//      CAS _owner from NULL, so from now on nobody can enter, wait on or
+//      notify the monitor.
+//   2. Re-check that nobody waits on or is queued for the monitor.  The
+//      is_busy() check before step 1 may be stale: a thread could have
+//      called wait() and released the monitor in between.
+//   3. CAS _count from 0 to -max_jint.  Contending threads and
+//      FastHashCode() pin the monitor by incrementing _count before they
+//      depend on it (see ObjectMonitor::try_inc_count()), so success
+//      means nobody can.  A thread that later finds _count negative
+//      re-reads the mark word and inflates again.
+//
+// If step 2 or 3 fails, threads may have queued up behind DEFLATER_MARKER,
+// so the ServiceThread releases the monitor through the regular exit()
+// path, which wakes a successor.  Otherwise the object's header is
+// restored and the monitor is unlinked from its in-use list.
+//
+// A thread may still be using a pointer to the dead monitor that it read
+// from the mark word before the header was restored, but it cannot carry
+// it across a safepoint check.  Deflated monitors therefore wait on
+// gDeflatedList until a safepoint has completed before they are reused.
+
+bool ObjectSynchronizer::deflate_monitor_async(ObjectMonitor* mid, Thread* self) {
+  oop obj = (oop) mid->object();
+  // Skip monitors that are not (yet) published in their object's header:
+  // the inflating thread may still fail its CAS and release the monitor.
+  if (obj == NULL || mid->is_busy() || obj->mark() != markOopDesc::encode(mid)) {
+    return false;
+  }
+
+  if (Atomic::cmpxchg(DEFLATER_MARKER, &mid->_owner, (void*)NULL) != NULL) {
+    return false;
+  }
+
+  if (mid->_waiters != 0 || mid->_cxq != NULL || mid->_EntryList != NULL ||
+      Atomic::cmpxchg(-max_jint, &mid->_count, (jint)0) != 0) {
+    // The monitor came back into use; undo step 1.
+    mid->_owner = self;
+    mid->exit(true, self);
+    return false;
+  }
+
+  if (log_is_enabled(Debug, monitorinflation)) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      log_debug(monitorinflation)("Async deflating object " INTPTR_FORMAT " , "
+                                  "mark " INTPTR_FORMAT " , type %s",
+                                  p2i(obj), p2i(obj->mark()),
+                                  obj->klass()->external_name());
+    }
+  }
+
+  // Nobody else changes the mark word of an inflated object outside of
+  // a safepoint.  Keep the header in the monitor until it is recycled;
+  // late readers of the mark word may still look at it.
+  markOop dmw = mid->header();
+  guarantee(dmw->is_neutral(), "invariant");
+  markOop res = obj->cas_set_mark(dmw, markOopDesc::encode(mid));
+  guarantee(res == markOopDesc::encode(mid), "invariant");
+  mid->set_object(NULL);
+  return true;
+}
+
+// Walk a per-thread or the global in-use list and move the monitors
+// deflated by deflate_monitor_async() to gDeflatedList.  The caller holds
+// the lock that protects the list.
+int ObjectSynchronizer::deflate_monitor_list_async(ObjectMonitor** listHeadp, Thread* self) {
+  ObjectMonitor* mid;
+  ObjectMonitor* next;
+  ObjectMonitor* cur_mid_in_use = NULL;
+  int deflated_count = 0;
+
+  for (mid = *listHeadp; mid != NULL;) {
+    next = mid->FreeNext;
+    if (deflate_monitor_async(mid, self)) {
+      if (mid == *listHeadp) {
+        *listHeadp = next;
+      } else if (cur_mid_in_use != NULL) {
+        cur_mid_in_use->FreeNext = next;
+      }
+      mid->FreeNext = gDeflatedList;
+      gDeflatedList = mid;
+      deflated_count++;
+    } else {
+      cur_mid_in_use = mid;
+    }
+    mid = next;
+  }
+  return deflated_count;
+}
+
+// Return the monitors on gDeflatedList to gFreeList once a safepoint has
+// completed since they were deflated.
+void ObjectSynchronizer::recycle_deflated_monitors() {
+  if (gDeflatedList == NULL ||
+      SafepointSynchronize::safepoint_counter() - gDeflatedSafepointCounter < 2) {
+    // The counter is odd while a safepoint is in progress, so an increase
+    // of two or more means at least one safepoint began and ended since.
+    return;
+  }
+
+  ObjectMonitor* tail = NULL;
+  for (ObjectMonitor* mid = gDeflatedList; mid != NULL; mid = mid->FreeNext) {
+    mid->clear_async_deflated();
+    tail = mid;
+  }
+
+  Thread::muxAcquire(&gListLock, "recycle_deflated_monitors");
+  tail->FreeNext = gFreeList;
+  gFreeList = gDeflatedList;
+  gMonitorFreeCount += gDeflatedCount;
+  Thread::muxRelease(&gListLock);
+
+  gDeflatedList = NULL;
+  gDeflatedCount = 0;
+}
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (ForceMonitorScavenge != 0) {
+    // MonitorBound was exceeded, see InduceScavenge().
+    return true;
+  }
+  if (gDeflatedList != NULL &&
+      SafepointSynchronize::safepoint_counter() - gDeflatedSafepointCounter >= 2) {
+    return true;
+  }
+  if (AsyncDeflationInterval > 0 &&
+      os::javaTimeMillis() - gLastAsyncDeflation >= AsyncDeflationInterval) {
+    return MonitorUsedDeflationThreshold == 0 || monitors_used_above_threshold();
+  }
+  return false;
+}
+
+void ObjectSynchronizer::deflate_idle_monitors_async(JavaThread* self) {
+  assert(AsyncDeflateIdleMonitors, "sanity");
+  assert(self == Thread::current() && self->thread_state() == _thread_in_vm, "invariant");
+
+  recycle_deflated_monitors();
+
+  int in_circulation = 0;
+  int in_use = 0;
+  int deflated = 0;
+  elapsedTimer timer;
+  timer.start();
+
+  // Moribund threads' monitors, see omFlush().
+  Thread::muxAcquire(&gListLock, "deflate_idle_monitors_async");
+  in_circulation += gOmInUseCount;
+  int deflated_count = deflate_monitor_list_async((ObjectMonitor**)&gOmInUseList, self);
+  gOmInUseCount -= deflated_count;
+  deflated += deflated_count;
+  in_use += gOmInUseCount;
+  Thread::muxRelease(&gListLock);
+
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
+    lock_in_use_list(jt);
+    in_circulation += jt->omInUseCount;
+    deflated_count = deflate_monitor_list_async(jt->omInUseList_addr(), self);
+    jt->omInUseCount -= deflated_count;
+    deflated += deflated_count;
+    in_use += jt->omInUseCount;
+    unlock_in_use_list(jt);
+
+    if (SafepointSynchronize::is_synchronizing()) {
+      // Don't hold up a pending safepoint while we walk the remaining
+      // threads.  We hold no oops and no monitor pointers here.
+      ThreadBlockInVM tbivm(self);
+    }
+  }
+
+  timer.stop();
+
+  gDeflatedCount += deflated;
+  if (gDeflatedList != NULL) {
+    gDeflatedSafepointCounter = SafepointSynchronize::safepoint_counter();
+  }
+  gLastAsyncDeflation = os::javaTimeMillis();
+  ForceMonitorScavenge = 0;    // Reset
+
+  OM_PERFDATA_OP(Deflations, inc(deflated));
+  OM_PERFDATA_OP(MonExtant, set_value(in_circulation));
+
+  if (deflated > 0) {
+    log_info(monitorinflation)("async deflation: %d monitors in use, %d deflated, "
+                               "%d awaiting reuse, %3.7f secs",
+                               in_use, deflated, gDeflatedCount, timer.seconds());
+  }
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
@@ -148,6 +148,11 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** freeHeadp,
                               ObjectMonitor** freeTailp);
   static bool is_cleanup_needed();
+
+  // Asynchronous deflation by the ServiceThread (AsyncDeflateIdleMonitors)
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_async(JavaThread* self);
+
   static void oops_do(OopClosure* f);
   // Process oops in thread local used monitors
   static void thread_local_used_oops_do(Thread* thread, OopClosure* f);
@@ -169,6 +174,10 @@ class ObjectSynchronizer : AllStatic {
   // count of entries in gOmInUseList
   static int gOmInUseCount;
 
+  static bool deflate_monitor_async(ObjectMonitor* mid, Thread* self);
+  static int  deflate_monitor_list_async(ObjectMonitor** listheadp, Thread* self);
+  static void recycle_deflated_monitors();
+
   // Process oops in all global used monitors (i.e. moribund thread's monitors)
   static void global_used_oops_do(OopClosure* f);
   // Process oops in monitors on the given list
@@ -27,6 +27,7 @@
 #include "classfile/classLoader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
+#include "classfile/parallelClassLinker.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
@@ -43,6 +44,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -261,6 +263,7 @@ Thread::Thread() {
   omFreeProvision = 32;
   omInUseList = NULL;
   omInUseCount = 0;
+  omInUseListLock = 0;
 
 #ifdef ASSERT
   _visited_for_critical_count = false;
@@ -3725,6 +3728,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // Initialize Java-Level synchronization subsystem
   ObjectMonitor::Initialize();
 
+  // Start writing log messages asynchronously, if requested
+  LogAsyncWriter::initialize();
+
   // Initialize global modules
   jint status = init_globals();
   if (status != JNI_OK) {
@@ -3886,6 +3892,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // cache the system and platform class loaders
   SystemDictionary::compute_java_loaders(CHECK_JNI_ERR);
 
+  if (ParallelClassLinking && !DumpSharedSpaces) {
+    ParallelClassLinker::initialize(CHECK_JNI_ERR);
+  }
+
 #if INCLUDE_CDS
   if (DumpSharedSpaces) {
     // capture the module path info from the ModuleEntryTable
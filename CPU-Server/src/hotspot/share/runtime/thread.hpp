@@ -79,7 +79,6 @@ class vframeArray;
 class DeoptResourceMark;
 class jvmtiDeferredLocalVariableSet;
 
-class GCTaskQueue;
 class ThreadClosure;
 class ICRefillVerifier;
 class IdealGraphPrinter;
@@ -392,6 +391,8 @@ class Thread: public ThreadShadow {
   int omFreeProvision;                          // reload chunk size
   ObjectMonitor* omInUseList;                   // SLL to track monitors in circulation
   int omInUseCount;                             // length of omInUseList
+  volatile int omInUseListLock;                 // guards omInUseList against the
+                                                // async monitor deflater
 
 #ifdef ASSERT
  private:
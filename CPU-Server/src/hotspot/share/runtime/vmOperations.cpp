@@ -27,6 +27,7 @@
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/profileCache.hpp"
 #include "gc/shared/isGCActiveMark.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
@@ -498,6 +499,10 @@ void VM_PrintCompileQueue::doit() {
   CompileBroker::print_compile_queues(_out);
 }
 
+void VM_DumpProfileCache::doit() {
+  _count = ProfileCache::dump(_filename, _out);
+}
+
 #if INCLUDE_SERVICES
 void VM_PrintClassHierarchy::doit() {
   KlassHierarchy::print_class_hierarchy(_out, _print_interfaces, _print_subclasses, _classname);
@@ -69,6 +69,7 @@
   template(G1CollectFull)                         \
   template(G1Concurrent)                          \
   template(ZOperation)                            \
+  template(EpsilonCollect)                        \
   template(HandshakeOneThread)                    \
   template(HandshakeAllThreads)                   \
   template(HandshakeFallback)                     \
@@ -117,6 +118,7 @@
   template(DumpTouchedMethods)                    \
   template(MarkActiveNMethods)                    \
   template(PrintCompileQueue)                     \
+  template(DumpProfileCache)                      \
   template(PrintClassHierarchy)                   \
   template(ThreadSuspend)                         \
   template(CTWThreshold)                          \
@@ -501,6 +503,20 @@ class VM_PrintCompileQueue: public VM_Operation {
   void doit();
 };
 
+class VM_DumpProfileCache: public VM_Operation {
+ private:
+  const char*   _filename;
+  outputStream* _out;
+  int           _count;
+
+ public:
+  VM_DumpProfileCache(const char* filename, outputStream* st) :
+    _filename(filename), _out(st), _count(-1) {}
+  VMOp_Type type() const { return VMOp_DumpProfileCache; }
+  void doit();
+  int count() const { return _count; }
+};
+
 #if INCLUDE_SERVICES
 class VM_PrintClassHierarchy: public VM_Operation {
  private:
@@ -109,6 +109,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ProfileCacheDumpDCmd>(full_export, true, false));
 
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesPrintDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesAddDCmd>(full_export, true, false));
@@ -503,17 +504,36 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _gzip("-gz", "If specified, the heap dump is written in gzipped format "
+               "using the given compression level. 1 (recommended) is the fastest, "
+               "9 the strongest compression.", "INT", false, "0"),
+  _parallel("-parallel", "Number of GC worker threads dumping the objects, "
+            "0 for all of them. The objects are dumped serially if the "
+            "collector does not support parallel heap iteration.", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_parallel);
   _dcmdparser.add_dcmd_argument(&_filename);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
+  jlong level = _gzip.value();
+  if (level < 0 || level > 9) {
+    output()->print_cr("Compression level out of range (0-9): " JLONG_FORMAT, level);
+    return;
+  }
+  jlong parallel = _parallel.value();
+  if (parallel < 0 || parallel > (jlong)max_juint) {
+    output()->print_cr("Invalid number of dump threads: " JLONG_FORMAT, parallel);
+    return;
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), (int)level, (uint)parallel);
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -939,6 +959,37 @@ void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
 
+ProfileCacheDumpDCmd::ProfileCacheDumpDCmd(outputStream* output, bool heap) :
+                                           DCmdWithParser(output, heap),
+  _filename("filename", "Name of the profile cache file, ProfileCacheFile if omitted",
+            "STRING", false) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+int ProfileCacheDumpDCmd::num_arguments() {
+  ResourceMark rm;
+  ProfileCacheDumpDCmd* dcmd = new ProfileCacheDumpDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void ProfileCacheDumpDCmd::execute(DCmdSource source, TRAPS) {
+  const char* filename = _filename.has_value() ? _filename.value() : ProfileCacheFile;
+  if (filename == NULL) {
+    output()->print_cr("No file name given and ProfileCacheFile is not set");
+    return;
+  }
+  VM_DumpProfileCache op(filename, output());
+  VMThread::execute(&op);
+  if (op.count() >= 0) {
+    output()->print_cr("Wrote profiles of %d methods to %s", op.count(), filename);
+  }
+}
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 CodeHeapAnalyticsDCmd::CodeHeapAnalyticsDCmd(outputStream* output, bool heap) :
                                              DCmdWithParser(output, heap),
@@ -331,6 +331,8 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _gzip;
+  DCmdArgument<jlong> _parallel;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -642,6 +644,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class ProfileCacheDumpDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  ProfileCacheDumpDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.dump_profiles";
+  }
+  static const char* description() {
+    return "Write the profiles of hot methods to a profile cache file.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of loaded classes.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 class CodeHeapAnalyticsDCmd : public DCmdWithParser {
 protected:
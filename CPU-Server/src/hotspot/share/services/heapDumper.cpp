@@ -25,12 +25,14 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "classfile/classLoaderData.inline.hpp"
+#include "classfile/classLoader.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -42,6 +44,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/reflectionUtils.hpp"
 #include "runtime/thread.inline.hpp"
@@ -375,92 +378,49 @@ enum {
   INITIAL_CLASS_COUNT = 200
 };
 
-// Supports I/O operations on a dump file
+// The file a heap dump is written to. In a parallel dump it is shared by
+// the DumpWriters of all dumping threads, which write whole buffers under
+// its lock.
 
-class DumpWriter : public StackObj {
+class DumpFile : public StackObj {
  private:
-  enum {
-    io_buffer_size  = 8*M
-  };
-
-  int _fd;              // file descriptor (-1 if dump file not open)
+  int _fd;               // file descriptor (-1 if dump file not open)
   julong _bytes_written; // number of byte written to dump file
+  char* _error;          // error message when I/O fails
+  Mutex* _lock;          // serializes the writes of the dumping threads
 
-  char* _buffer;    // internal buffer
-  size_t _size;
-  size_t _pos;
-
-  jlong _dump_start;
-
-  char* _error;   // error message when I/O fails
-
-  void set_file_descriptor(int fd)              { _fd = fd; }
-  int file_descriptor() const                   { return _fd; }
-
-  char* buffer() const                          { return _buffer; }
-  size_t buffer_size() const                    { return _size; }
-  size_t position() const                       { return _pos; }
-  void set_position(size_t pos)                 { _pos = pos; }
-
-  void set_error(const char* error)             { _error = (char*)os::strdup(error); }
+  void set_file_descriptor(int fd)      { _fd = fd; }
+  int file_descriptor() const           { return _fd; }
 
-  // all I/O go through this function
-  void write_internal(void* s, size_t len);
+  // the lock, unless the current thread already holds it
+  Mutex* lock_if_not_owned() const      { return _lock->owned_by_self() ? NULL : _lock; }
 
  public:
-  DumpWriter(const char* path);
-  ~DumpWriter();
+  DumpFile(const char* path);
+  ~DumpFile();
 
+  // The dumping threads may fail and close the file concurrently, so the
+  // file descriptor and the error are only accessed under the lock.
   void close();
-  bool is_open() const                  { return file_descriptor() >= 0; }
-  void flush();
+  bool is_open() const;
 
-  jlong dump_start() const                      { return _dump_start; }
-  void set_dump_start(jlong pos);
-  julong current_record_length();
+  Mutex* lock() const                   { return _lock; }
 
   // total number of bytes written to the disk
   julong bytes_written() const          { return _bytes_written; }
 
-  // adjust the number of bytes written to disk (used to keep the count
-  // of the number of bytes written in case of rewrites)
-  void adjust_bytes_written(jlong n)    { _bytes_written += n; }
-
-  // number of (buffered) bytes as yet unwritten to the dump file
-  size_t bytes_unwritten() const        { return position(); }
-
+  // only read once the dumping threads are done
   char* error() const                   { return _error; }
+  void set_error(const char* error);
 
-  jlong current_offset();
-  void seek_to_offset(jlong pos);
-
-  // writer functions
-  void write_raw(void* s, size_t len);
-  void write_u1(u1 x)                   { write_raw((void*)&x, 1); }
-  void write_u2(u2 x);
-  void write_u4(u4 x);
-  void write_u8(u8 x);
-  void write_objectID(oop o);
-  void write_symbolID(Symbol* o);
-  void write_classID(Klass* k);
-  void write_id(u4 x);
+  // writes the bytes to the file, the caller holds the lock
+  void write(const char* s, size_t len);
 };
 
-DumpWriter::DumpWriter(const char* path) {
-  // try to allocate an I/O buffer of io_buffer_size. If there isn't
-  // sufficient memory then reduce size until we can allocate something.
-  _size = io_buffer_size;
-  do {
-    _buffer = (char*)os::malloc(_size, mtInternal);
-    if (_buffer == NULL) {
-      _size = _size >> 1;
-    }
-  } while (_buffer == NULL && _size > 0);
-  assert((_size > 0 && _buffer != NULL) || (_size == 0 && _buffer == NULL), "sanity check");
-  _pos = 0;
+DumpFile::DumpFile(const char* path) {
   _error = NULL;
   _bytes_written = 0L;
-  _dump_start = (jlong)-1;
+  _lock = new Mutex(Mutex::leaf, "HeapDumpFile_lock", true, Monitor::_safepoint_check_never);
   _fd = os::create_binary_file(path, false);    // don't replace existing file
 
   // if the open failed we record the error
@@ -469,45 +429,40 @@ DumpWriter::DumpWriter(const char* path) {
   }
 }
 
-DumpWriter::~DumpWriter() {
-  // flush and close dump file
-  if (is_open()) {
-    close();
-  }
-  if (_buffer != NULL) os::free(_buffer);
+DumpFile::~DumpFile() {
+  close();
+  delete _lock;
   if (_error != NULL) os::free(_error);
 }
 
 // closes dump file (if open)
-void DumpWriter::close() {
-  // flush and close dump file
-  if (is_open()) {
-    flush();
+void DumpFile::close() {
+  MutexLockerEx ml(lock_if_not_owned(), Mutex::_no_safepoint_check_flag);
+  if (file_descriptor() >= 0) {
     os::close(file_descriptor());
     set_file_descriptor(-1);
   }
 }
 
-// sets the dump starting position
-void DumpWriter::set_dump_start(jlong pos) {
-  _dump_start = pos;
+bool DumpFile::is_open() const {
+  MutexLockerEx ml(lock_if_not_owned(), Mutex::_no_safepoint_check_flag);
+  return file_descriptor() >= 0;
 }
 
-julong DumpWriter::current_record_length() {
-  if (is_open()) {
-    // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
-    assert(dump_end == (size_t)current_offset(), "checking");
-    julong dump_len = dump_end - dump_start() - 4;
-    return dump_len;
+// records the first error and stops writing
+void DumpFile::set_error(const char* error) {
+  MutexLockerEx ml(lock_if_not_owned(), Mutex::_no_safepoint_check_flag);
+  if (_error == NULL) {
+    _error = (char*)os::strdup(error);
   }
-  return 0;
+  close();
 }
 
 // write directly to the file
-void DumpWriter::write_internal(void* s, size_t len) {
-  if (is_open()) {
-    const char* pos = (char*)s;
+void DumpFile::write(const char* s, size_t len) {
+  assert(_lock->owned_by_self(), "must hold the file lock");
+  if (file_descriptor() >= 0) {
+    const char* pos = s;
     ssize_t n = 0;
     while (len > 0) {
       uint tmp = (uint)MIN2(len, (size_t)UINT_MAX);
@@ -516,8 +471,6 @@ void DumpWriter::write_internal(void* s, size_t len) {
       if (n < 0) {
         // EINTR cannot happen here, os::write will take care of that
         set_error(os::strerror(errno));
-        os::close(file_descriptor());
-        set_file_descriptor(-1);
         return;
       }
 
@@ -528,55 +481,178 @@ void DumpWriter::write_internal(void* s, size_t len) {
   }
 }
 
-// write raw bytes
-void DumpWriter::write_raw(void* s, size_t len) {
-  if (is_open()) {
-    // flush buffer to make room
-    if ((position() + len) >= buffer_size()) {
-      flush();
-    }
+// Supports I/O operations on a dump file.
+//
+// The sub-records of a HPROF_HEAP_DUMP_SEGMENT are collected in the buffer
+// together with the segment header, whose length is fixed up in the buffer
+// before it is flushed. A sub-record that does not fit in the buffer is
+// written as the only sub-record of a segment, with the length known up
+// front. So no seeking is needed, every buffer of a segment can be compressed
+// independently, and the segments of several writers can share a file.
 
-    // buffer not available or too big to buffer it
-    if ((buffer() == NULL) || (len >= buffer_size())) {
-      write_internal(s, len);
-    } else {
-      // Should optimize this for u1/u2/u4/u8 sizes.
-      memcpy(buffer() + position(), s, len);
-      set_position(position() + len);
+class DumpWriter : public StackObj {
+ private:
+  enum {
+    io_buffer_size  = 8*M,
+    dump_segment_header_size = 9
+  };
+
+  DumpFile* _file;       // the file to write to
+
+  char* _buffer;    // internal buffer
+  size_t _size;
+  size_t _pos;
+
+  int _compression_level;   // gzip level, 0 if not compressed
+  char* _out_buffer;        // buffer for the compressed bytes
+  size_t _out_size;
+
+  bool _in_dump_segment;    // are we currently in a dump segment?
+  bool _is_huge_sub_record; // is the current sub-record larger than the buffer?
+  bool _holds_file_lock;    // does this writer keep the file locked?
+  bool _is_open;            // was the file open when this writer last wrote to it?
+  DEBUG_ONLY(size_t _sub_record_left;) // number of bytes not yet written of the sub-record
+  DEBUG_ONLY(bool _sub_record_ended;)  // has end_sub_record() been called?
+
+  char* buffer() const                          { return _buffer; }
+  size_t buffer_size() const                    { return _size; }
+  size_t position() const                       { return _pos; }
+  void set_position(size_t pos)                 { _pos = pos; }
+
+  // writes the buffer to the file, compressed if requested
+  void write_buffer();
+
+ public:
+  DumpWriter(DumpFile* file, int compression_level);
+  ~DumpWriter();
+
+  DumpFile* file() const                { return _file; }
+  int compression_level() const         { return _compression_level; }
+  // The file may be closed by another writer that failed. The state is
+  // refreshed whenever the buffer is written, under the file lock.
+  bool is_open() const                  { return _is_open; }
+  void flush();
+
+  // writer functions
+  void write_raw(void* s, size_t len);
+  void write_u1(u1 x)                   { write_raw((void*)&x, 1); }
+  void write_u2(u2 x);
+  void write_u4(u4 x);
+  void write_u8(u8 x);
+  void write_objectID(oop o);
+  void write_symbolID(Symbol* o);
+  void write_classID(Klass* k);
+  void write_id(u4 x);
+
+  // starts a new sub-record of a HPROF_HEAP_DUMP_SEGMENT of the given
+  // length, including the tag, and starts a new segment if needed
+  void start_sub_record(u1 tag, u4 len);
+  // ends the current sub-record
+  void end_sub_record();
+  // fixes up the length of the current segment and flushes it
+  void finish_dump_segment();
+};
+
+DumpWriter::DumpWriter(DumpFile* file, int compression_level) {
+  _file = file;
+  _compression_level = compression_level;
+  _pos = 0;
+  _out_buffer = NULL;
+  _out_size = 0;
+  _in_dump_segment = false;
+  _is_huge_sub_record = false;
+  _holds_file_lock = false;
+  _is_open = file->is_open();
+  DEBUG_ONLY(_sub_record_left = 0;)
+  DEBUG_ONLY(_sub_record_ended = false;)
+
+  // try to allocate an I/O buffer of io_buffer_size. If there isn't
+  // sufficient memory then reduce size until we can allocate something.
+  _size = io_buffer_size;
+  do {
+    _buffer = (char*)os::malloc(_size, mtInternal);
+    if (_buffer == NULL) {
+      _size = _size >> 1;
+    }
+  } while (_buffer == NULL && _size > dump_segment_header_size);
+
+  if (_buffer == NULL) {
+    _size = 0;
+    _file->set_error("Could not allocate dump buffer");
+    _is_open = false;
+  } else if (_compression_level > 0) {
+    _out_size = (size_t)ClassLoader::gzip_bound((jlong)_size, _compression_level);
+    _out_buffer = (_out_size == 0) ? NULL : (char*)os::malloc(_out_size, mtInternal);
+    if (_out_buffer == NULL) {
+      _file->set_error("Could not allocate compression buffer");
+      _is_open = false;
     }
   }
 }
 
-// flush any buffered bytes to the file
-void DumpWriter::flush() {
-  if (is_open() && position() > 0) {
-    write_internal(buffer(), position());
-    set_position(0);
+DumpWriter::~DumpWriter() {
+  assert(!_in_dump_segment || !is_open(), "dump segment not finished");
+  // flush any remaining bytes of a writer that did not finish normally
+  flush();
+  if (_holds_file_lock) {
+    _file->lock()->unlock();
   }
+  if (_buffer != NULL) os::free(_buffer);
+  if (_out_buffer != NULL) os::free(_out_buffer);
 }
 
-jlong DumpWriter::current_offset() {
-  if (is_open()) {
-    // the offset is the file offset plus whatever we have buffered
-    jlong offset = os::current_file_offset(file_descriptor());
-    assert(offset >= 0, "lseek failed");
-    return offset + position();
-  } else {
-    return (jlong)-1;
+void DumpWriter::write_buffer() {
+  const char* data = buffer();
+  size_t len = position();
+
+  if (_compression_level > 0) {
+    char* msg = NULL;
+    jlong out_len = ClassLoader::gzip(buffer(), (jlong)position(), _out_buffer,
+                                      (jlong)_out_size, _compression_level, &msg);
+    if (out_len <= 0) {
+      _file->set_error(msg != NULL ? msg : "Compression failed");
+      _is_open = false;
+      return;
+    }
+    data = _out_buffer;
+    len = (size_t)out_len;
   }
+
+  MutexLockerEx ml(_holds_file_lock ? NULL : _file->lock(), Mutex::_no_safepoint_check_flag);
+  _file->write(data, len);
+  _is_open = _file->is_open();
 }
 
-void DumpWriter::seek_to_offset(jlong off) {
-  assert(off >= 0, "bad offset");
+// write raw bytes
+void DumpWriter::write_raw(void* s, size_t len) {
+  assert(!_in_dump_segment || _sub_record_left >= len, "sub-record too large");
+  DEBUG_ONLY(if (_in_dump_segment) _sub_record_left -= len;)
 
-  // need to flush before seeking
-  flush();
+  if (!is_open()) {
+    return;
+  }
 
-  // may be closed due to I/O error
-  if (is_open()) {
-    jlong n = os::seek_to_file_offset(file_descriptor(), off);
-    assert(n >= 0, "lseek failed");
+  // flush buffer to make room, only huge sub-records span several buffers
+  while (len > buffer_size() - position()) {
+    assert(!_in_dump_segment || _is_huge_sub_record, "sub-record does not fit in the buffer");
+    size_t to_write = buffer_size() - position();
+    memcpy(buffer() + position(), s, to_write);
+    s = (void*)((char*)s + to_write);
+    len -= to_write;
+    set_position(position() + to_write);
+    flush();
   }
+
+  memcpy(buffer() + position(), s, len);
+  set_position(position() + len);
+}
+
+// flush any buffered bytes to the file
+void DumpWriter::flush() {
+  if (is_open() && position() > 0) {
+    write_buffer();
+  }
+  set_position(0);
 }
 
 void DumpWriter::write_u2(u2 x) {
@@ -628,6 +704,64 @@ void DumpWriter::write_classID(Klass* k) {
   write_objectID(k->java_mirror());
 }
 
+void DumpWriter::start_sub_record(u1 tag, u4 len) {
+  if (!_in_dump_segment) {
+    flush();
+    assert(position() == 0, "must be at the start of the buffer");
+
+    // A huge sub-record is the only one of its segment, so the length is
+    // already known, otherwise it is fixed up when the segment is finished.
+    // The file stays locked until then, as the segment spans several buffers.
+    _is_huge_sub_record = len > buffer_size() - dump_segment_header_size;
+    if (_is_huge_sub_record && !_holds_file_lock) {
+      _file->lock()->lock_without_safepoint_check();
+      _holds_file_lock = true;
+    }
+
+    write_u1(HPROF_HEAP_DUMP_SEGMENT);
+    write_u4(0); // current ticks
+    write_u4(len);
+    _in_dump_segment = true;
+  } else if (_is_huge_sub_record || len > buffer_size() - position()) {
+    // The sub-record does not fit in the current segment or the last one
+    // was huge. Finish the segment and start a new one.
+    finish_dump_segment();
+    start_sub_record(tag, len);
+    return;
+  }
+
+  DEBUG_ONLY(_sub_record_left = len;)
+  DEBUG_ONLY(_sub_record_ended = false;)
+  write_u1(tag);
+}
+
+void DumpWriter::end_sub_record() {
+  assert(_in_dump_segment, "must be in a dump segment");
+  assert(_sub_record_left == 0 || !is_open(), "sub-record not written completely");
+  assert(!_sub_record_ended, "sub-record already ended");
+  DEBUG_ONLY(_sub_record_ended = true;)
+}
+
+void DumpWriter::finish_dump_segment() {
+  if (_in_dump_segment) {
+    assert(_sub_record_left == 0 || !is_open(), "last sub-record not written completely");
+    assert(_sub_record_ended, "last sub-record not ended");
+
+    // The length of a segment holding a huge sub-record was correct from the start
+    if (!_is_huge_sub_record && is_open()) {
+      assert(position() > dump_segment_header_size, "dump segment should have some content");
+      Bytes::put_Java_u4((address)(buffer() + 5), (u4)(position() - dump_segment_header_size));
+    }
+
+    flush();
+    _in_dump_segment = false;
+    _is_huge_sub_record = false;
+    if (_holds_file_lock) {
+      _file->lock()->unlock();
+      _holds_file_lock = false;
+    }
+  }
+}
 
 
 // Support class with a collection of functions used when dumping the heap
@@ -645,6 +779,11 @@ class DumperSupport : AllStatic {
 
   // returns the size of the instance of the given class
   static u4 instance_size(Klass* k);
+  // returns the size of the static fields of the given class in a
+  // HPROF_GC_CLASS_DUMP record, and their number in field_count
+  static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
+  // returns the number of instance fields of the given class
+  static u2 get_instance_fields_count(InstanceKlass* ik);
 
   // dump a jfloat
   static void dump_float(DumpWriter* writer, jfloat f);
@@ -675,16 +814,13 @@ class DumperSupport : AllStatic {
   static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
+  static int calculate_array_max_length(arrayOop array, short header_size);
 
-  // writes a HPROF_HEAP_DUMP_SEGMENT record
-  static void write_dump_header(DumpWriter* writer);
-
-  // fixes up the length of the current dump record
-  static void write_current_dump_record_length(DumpWriter* writer);
-
-  // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+  // finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
+
+  // size of the HPROF_GC_CLASS_DUMP record of an array class
+  static const u4 array_class_dump_size = 1 + 7 * sizeof(address) + 4 + 4 + 2 + 2 + 2;
 };
 
 // write a header of the given type
@@ -844,15 +980,37 @@ u4 DumperSupport::instance_size(Klass* k) {
   return size;
 }
 
-// dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+// returns the size of the static fields, including the resolved references
+// and the init lock written along with them
+u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
   HandleMark hm;
-  InstanceKlass* ik = InstanceKlass::cast(k);
+  field_count = 0;
+  u4 size = 0;
 
-  // pass 1 - count the static fields
-  u2 field_count = 0;
   for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
-    if (fldc.access_flags().is_static()) field_count++;
+    if (fldc.access_flags().is_static()) {
+      field_count++;
+      size += sizeof(address) + 1;    // name and type
+
+      switch (fldc.signature()->char_at(0)) {
+        case JVM_SIGNATURE_CLASS   :
+        case JVM_SIGNATURE_ARRAY   : size += sizeof(address); break;
+
+        case JVM_SIGNATURE_BYTE    :
+        case JVM_SIGNATURE_BOOLEAN : size += 1; break;
+
+        case JVM_SIGNATURE_CHAR    :
+        case JVM_SIGNATURE_SHORT   : size += 2; break;
+
+        case JVM_SIGNATURE_INT     :
+        case JVM_SIGNATURE_FLOAT   : size += 4; break;
+
+        case JVM_SIGNATURE_LONG    :
+        case JVM_SIGNATURE_DOUBLE  : size += 8; break;
+
+        default : ShouldNotReachHere();
+      }
+    }
   }
 
   // Add in resolved_references which is referenced by the cpCache
@@ -861,12 +1019,14 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop resolved_references = ik->constants()->resolved_references_or_null();
   if (resolved_references != NULL) {
     field_count++;
+    size += 2 * sizeof(address) + 1;
 
     // Add in the resolved_references of the used previous versions of the class
     // in the case of RedefineClasses
     InstanceKlass* prev = ik->previous_versions();
     while (prev != NULL && prev->constants()->resolved_references_or_null() != NULL) {
       field_count++;
+      size += 2 * sizeof(address) + 1;
       prev = prev->previous_versions();
     }
   }
@@ -876,8 +1036,24 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop init_lock = ik->init_lock();
   if (init_lock != NULL) {
     field_count++;
+    size += 2 * sizeof(address) + 1;
   }
 
+  return size;
+}
+
+// dumps static fields of the given class
+void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  InstanceKlass* ik = InstanceKlass::cast(k);
+
+  // pass 1 - count the static fields
+  u2 field_count;
+  get_static_fields_size(ik, field_count);
+
+  oop resolved_references = ik->constants()->resolved_references_or_null();
+  oop init_lock = ik->init_lock();
+
   writer->write_u2(field_count);
 
   // pass 2 - dump the field descriptors and raw values
@@ -930,16 +1106,23 @@ void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
   }
 }
 
+// returns the number of instance fields declared by the given class
+u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
+  HandleMark hm;
+  u2 field_count = 0;
+  for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
+    if (!fldc.access_flags().is_static()) field_count++;
+  }
+  return field_count;
+}
+
 // dumps the definition of the instance fields for a given class
 void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
   HandleMark hm;
   InstanceKlass* ik = InstanceKlass::cast(k);
 
   // pass 1 - count the instance fields
-  u2 field_count = 0;
-  for (FieldStream fldc(ik, true, true); !fldc.eos(); fldc.next()) {
-    if (!fldc.access_flags().is_static()) field_count++;
-  }
+  u2 field_count = get_instance_fields_count(ik);
 
   writer->write_u2(field_count);
 
@@ -957,8 +1140,10 @@ void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k
 // creates HPROF_GC_INSTANCE_DUMP record for the given object
 void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   Klass* k = o->klass();
+  u4 is = instance_size(k);
+  u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
 
-  writer->write_u1(HPROF_GC_INSTANCE_DUMP);
+  writer->start_sub_record(HPROF_GC_INSTANCE_DUMP, size);
   writer->write_objectID(o);
   writer->write_u4(STACK_TRACE_ID);
 
@@ -966,10 +1151,12 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   writer->write_classID(k);
 
   // number of bytes that follow
-  writer->write_u4(instance_size(k) );
+  writer->write_u4(is);
 
   // field values
   dump_instance_fields(writer, o);
+
+  writer->end_sub_record();
 }
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
@@ -984,7 +1171,13 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     return;
   }
 
-  writer->write_u1(HPROF_GC_CLASS_DUMP);
+  u2 static_fields_count = 0;
+  u4 static_size = get_static_fields_size(ik, static_fields_count);
+  u2 instance_fields_count = get_instance_fields_count(ik);
+  u4 instance_fields_size = instance_fields_count * (sizeof(address) + 1);
+  u4 size = 1 + 7 * sizeof(address) + 4 + 4 + 2 + 2 + static_size + 2 + instance_fields_size;
+
+  writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
 
   // class ID
   writer->write_classID(ik);
@@ -1018,13 +1211,15 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
   // description of instance fields
   dump_instance_field_descriptors(writer, k);
 
+  writer->end_sub_record();
+
   // array classes
   k = k->array_klass_or_null();
   while (k != NULL) {
     Klass* klass = k;
     assert(klass->is_objArray_klass(), "not an ObjArrayKlass");
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, array_class_dump_size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1044,6 +1239,8 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1056,7 +1253,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
  while (k != NULL) {
     Klass* klass = k;
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, array_class_dump_size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1076,6 +1273,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1083,7 +1282,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1098,19 +1297,9 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 
   size_t length_in_bytes = (size_t)length * type_size;
 
-  // Create a new record if the current record is non-empty and the array can't fit.
-  julong current_record_length = writer->current_record_length();
-  if (current_record_length > 0 &&
-      (current_record_length + header_size + length_in_bytes) > max_juint) {
-    write_current_dump_record_length(writer);
-    write_dump_header(writer);
-
-    // We now have an empty record.
-    current_record_length = 0;
-  }
-
-  // Calculate max bytes we can use.
-  uint max_bytes = max_juint - (header_size + current_record_length);
+  // Calculate max bytes we can use, the array gets a segment of its own
+  // if it does not fit in the current one.
+  uint max_bytes = max_juint - header_size;
 
   // Array too long for the record?
   // Calculate max length and return it.
@@ -1129,9 +1318,10 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
+  u4 size = header_size + length * sizeof(address);
 
-  writer->write_u1(HPROF_GC_OBJ_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_OBJ_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1144,6 +1334,8 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
     oop o = array->obj_at(index);
     writer->write_objectID(o);
   }
+
+  writer->end_sub_record();
 }
 
 #define WRITE_ARRAY(Array, Type, Size, Length) \
@@ -1156,11 +1348,12 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
   short header_size = 2 * 1 + 2 * 4 + sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
   int type_size = type2aelembytes(type);
   u4 length_in_bytes = (u4)length * type_size;
+  u4 size = header_size + length_in_bytes;
 
-  writer->write_u1(HPROF_GC_PRIM_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_PRIM_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1168,6 +1361,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 
   // nothing to copy
   if (length == 0) {
+    writer->end_sub_record();
     return;
   }
 
@@ -1237,6 +1431,8 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
     }
     default : ShouldNotReachHere();
   }
+
+  writer->end_sub_record();
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
@@ -1312,10 +1508,12 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
   // ignore null handles
   oop o = *obj_p;
   if (o != NULL) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_LOCAL);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_LOCAL, size);
     writer()->write_objectID(o);
     writer()->write_u4(_thread_serial_num);
     writer()->write_u4((u4)_frame_num);
+    writer()->end_sub_record();
   }
 }
 
@@ -1343,9 +1541,11 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
   // we ignore global ref to symbols and other internal objects
   if (o->is_instance() || o->is_objArray() || o->is_typeArray()) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_GLOBAL);
+    u4 size = 1 + 2 * sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_GLOBAL, size);
     writer()->write_objectID(o);
     writer()->write_objectID((oopDesc*)obj_p);      // global ref ID
+    writer()->end_sub_record();
   }
 };
 
@@ -1361,8 +1561,10 @@ class MonitorUsedDumper : public OopClosure {
     _writer = writer;
   }
   void do_oop(oop* obj_p) {
-    writer()->write_u1(HPROF_GC_ROOT_MONITOR_USED);
+    u4 size = 1 + sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_MONITOR_USED, size);
     writer()->write_objectID(*obj_p);
+    writer()->end_sub_record();
   }
   void do_oop(narrowOop* obj_p) { ShouldNotReachHere(); }
 };
@@ -1381,31 +1583,25 @@ class StickyClassDumper : public KlassClosure {
   void do_klass(Klass* k) {
     if (k->is_instance_klass()) {
       InstanceKlass* ik = InstanceKlass::cast(k);
-        writer()->write_u1(HPROF_GC_ROOT_STICKY_CLASS);
+        u4 size = 1 + sizeof(address);
+        writer()->start_sub_record(HPROF_GC_ROOT_STICKY_CLASS, size);
         writer()->write_classID(ik);
+        writer()->end_sub_record();
       }
     }
 };
 
 
-class VM_HeapDumper;
-
 // Support class using when iterating over the heap.
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  VM_HeapDumper* _dumper;
   DumpWriter* _writer;
 
-  VM_HeapDumper* dumper()               { return _dumper; }
   DumpWriter* writer()                  { return _writer; }
 
-  // used to indicate that a record has been writen
-  void mark_end_of_record();
-
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
-    _dumper = dumper;
+  HeapObjectDumper(DumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1424,18 +1620,40 @@ void HeapObjectDumper::do_object(oop o) {
   if (o->is_instance()) {
     // create a HPROF_GC_INSTANCE record for each object
     DumperSupport::dump_instance(writer(), o);
-    mark_end_of_record();
   } else if (o->is_objArray()) {
     // create a HPROF_GC_OBJ_ARRAY_DUMP record for each object array
     DumperSupport::dump_object_array(writer(), objArrayOop(o));
-    mark_end_of_record();
   } else if (o->is_typeArray()) {
     // create a HPROF_GC_PRIM_ARRAY_DUMP record for each type array
     DumperSupport::dump_prim_array(writer(), typeArrayOop(o));
-    mark_end_of_record();
   }
 }
 
+// Dumps the objects of the heap from the GC worker threads. Each worker
+// writes the dump segments of the objects it iterates over with a writer
+// of its own, they are appended to the shared dump file as they fill up.
+
+class ParallelHeapDumpTask : public AbstractGangTask {
+ private:
+  DumpFile* _file;
+  int _compression_level;
+  ParallelObjectIterator* _poi;
+
+ public:
+  ParallelHeapDumpTask(DumpFile* file, int compression_level, ParallelObjectIterator* poi) :
+    AbstractGangTask("Parallel Heap Dump"),
+    _file(file),
+    _compression_level(compression_level),
+    _poi(poi) { }
+
+  virtual void work(uint worker_id) {
+    DumpWriter writer(_file, _compression_level);
+    HeapObjectDumper obj_dumper(&writer);
+    _poi->object_iterate(&obj_dumper, worker_id);
+    writer.finish_dump_segment();
+  }
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation {
  private:
@@ -1445,6 +1663,7 @@ class VM_HeapDumper : public VM_GC_Operation {
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
+  uint _num_dump_threads;
   GrowableArray<Klass*>* _klass_map;
   ThreadStackTrace** _stack_traces;
   int _num_threads;
@@ -1481,6 +1700,10 @@ class VM_HeapDumper : public VM_GC_Operation {
   int do_thread(JavaThread* thread, u4 thread_serial_num);
   void do_threads();
 
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records, in parallel if possible
+  void dump_objects();
+
   void add_class_serial_number(Klass* k, int serial_num) {
     _klass_map->at_put_grow(serial_num, k);
   }
@@ -1489,13 +1712,14 @@ class VM_HeapDumper : public VM_GC_Operation {
   void dump_stack_traces();
 
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome, uint num_dump_threads) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump) {
     _local_writer = writer;
     _gc_before_heap_dump = gc_before_heap_dump;
+    _num_dump_threads = num_dump_threads;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
     _stack_traces = NULL;
     _num_threads = 0;
@@ -1523,8 +1747,6 @@ class VM_HeapDumper : public VM_GC_Operation {
   }
 
   VMOp_Type type() const { return VMOp_HeapDumper; }
-  // used to mark sub-record boundary
-  void check_segment_length();
   void doit();
 };
 
@@ -1535,72 +1757,14 @@ bool VM_HeapDumper::skip_operation() const {
   return false;
 }
 
- // writes a HPROF_HEAP_DUMP_SEGMENT record
-void DumperSupport::write_dump_header(DumpWriter* writer) {
-  if (writer->is_open()) {
-    writer->write_u1(HPROF_HEAP_DUMP_SEGMENT);
-    writer->write_u4(0); // current ticks
-
-    // record the starting position for the dump (its length will be fixed up later)
-    writer->set_dump_start(writer->current_offset());
-    writer->write_u4(0);
-  }
-}
-
-// fixes up the length of the current dump record
-void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
-  if (writer->is_open()) {
-    julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
-    julong dump_len = writer->current_record_length();
-
-    // record length must fit in a u4
-    if (dump_len > max_juint) {
-      warning("record is too large");
-    }
-
-    // seek to the dump start and fix-up the length
-    assert(writer->dump_start() >= 0, "no dump start recorded");
-    writer->seek_to_offset(writer->dump_start());
-    writer->write_u4((u4)dump_len);
-
-    // adjust the total size written to keep the bytes written correct.
-    writer->adjust_bytes_written(-((jlong) sizeof(u4)));
-
-    // seek to dump end so we can continue
-    writer->seek_to_offset(dump_end);
-
-    // no current dump record
-    writer->set_dump_start((jlong)-1);
-  }
-}
-
-// used on a sub-record boundary to check if we need to start a
-// new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
-
-    if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
-    }
-  }
-}
-
-// fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+// finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
-  if (writer->is_open()) {
-    write_current_dump_record_length(writer);
+  writer->finish_dump_segment();
 
-    writer->write_u1(HPROF_HEAP_DUMP_END);
-    writer->write_u4(0);
-    writer->write_u4(0);
-  }
-}
-
-// marks sub-record boundary
-void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  writer->write_u1(HPROF_HEAP_DUMP_END);
+  writer->write_u4(0);
+  writer->write_u4(0);
+  writer->flush();
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1690,10 +1854,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
               oop o = locals->obj_at(slot)();
 
               if (o != NULL) {
-                writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                u4 size = 1 + sizeof(address) + 4 + 4;
+                writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                 writer()->write_objectID(o);
                 writer()->write_u4(thread_serial_num);
                 writer()->write_u4((u4) (stack_depth + extra_frames));
+                writer()->end_sub_record();
               }
             }
           }
@@ -1702,10 +1868,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
             if (exprs->at(index)->type() == T_OBJECT) {
                oop o = exprs->obj_at(index)();
                if (o != NULL) {
-                 writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                 u4 size = 1 + sizeof(address) + 4 + 4;
+                 writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                  writer()->write_objectID(o);
                  writer()->write_u4(thread_serial_num);
                  writer()->write_u4((u4) (stack_depth + extra_frames));
+                 writer()->end_sub_record();
                }
              }
           }
@@ -1753,10 +1921,12 @@ void VM_HeapDumper::do_threads() {
     oop threadObj = thread->threadObj();
     u4 thread_serial_num = i+1;
     u4 stack_serial_num = thread_serial_num + STACK_TRACE_ID;
-    writer()->write_u1(HPROF_GC_ROOT_THREAD_OBJ);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_THREAD_OBJ, size);
     writer()->write_objectID(threadObj);
     writer()->write_u4(thread_serial_num);  // thread number
     writer()->write_u4(stack_serial_num);   // stack trace serial number
+    writer()->end_sub_record();
     int num_frames = do_thread(thread, thread_serial_num);
     assert(num_frames == _stack_traces[i]->get_stack_depth(),
            "total number of Java frames not matched");
@@ -1781,12 +1951,12 @@ void VM_HeapDumper::do_threads() {
 // unknown object alloc site.
 //
 // Each HPROF_HEAP_DUMP_SEGMENT record has a length followed by sub-records.
-// To allow the heap dump be generated in a single pass we remember the position
-// of the dump length and fix it up after all sub-records have been written.
+// To allow the heap dump be generated in a single pass the DumpWriter keeps
+// a segment in its buffer and fixes up the length before writing it out.
 // To generate the sub-records we iterate over the heap, writing
 // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP, and HPROF_GC_PRIM_ARRAY_DUMP
-// records as we go. Once that is done we write records for some of the GC
-// roots.
+// records as we go, from the GC worker threads if the heap supports parallel
+// iteration. Once that is done we write records for some of the GC roots.
 
 void VM_HeapDumper::doit() {
 
@@ -1834,41 +2004,31 @@ void VM_HeapDumper::doit() {
   // this must be called after _klass_map is built when iterating the classes above.
   dump_stack_traces();
 
-  // write HPROF_HEAP_DUMP_SEGMENT
-  DumperSupport::write_dump_header(writer());
-
-  // Writes HPROF_GC_CLASS_DUMP records
+  // Writes HPROF_GC_CLASS_DUMP records, the HPROF_HEAP_DUMP_SEGMENT
+  // records are started as needed by the sub-records.
   {
     LockedClassesDo locked_dump_class(&do_class_dump);
     ClassLoaderDataGraph::classes_do(&locked_dump_class);
   }
   Universe::basic_type_classes_do(&do_basic_type_array_class_dump);
-  check_segment_length();
 
   // writes HPROF_GC_INSTANCE_DUMP records.
-  // After each sub-record is written check_segment_length will be invoked
-  // to check if the current segment exceeds a threshold. If so, a new
-  // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  dump_objects();
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
-  check_segment_length();
 
   // HPROF_GC_ROOT_MONITOR_USED
   MonitorUsedDumper mon_dumper(writer());
   ObjectSynchronizer::oops_do(&mon_dumper);
-  check_segment_length();
 
   // HPROF_GC_ROOT_JNI_GLOBAL
   JNIGlobalsDumper jni_dumper(writer());
   JNIHandles::oops_do(&jni_dumper);
   Universe::oops_do(&jni_dumper);  // technically not jni roots, but global roots
                                    // for things like preallocated throwable backtraces
-  check_segment_length();
 
   // HPROF_GC_ROOT_STICKY_CLASS
   // These should be classes in the NULL class loader data, and not all classes
@@ -1876,7 +2036,7 @@ void VM_HeapDumper::doit() {
   StickyClassDumper class_dumper(writer());
   ClassLoaderData::the_null_class_loader_data()->classes_do(&class_dumper);
 
-  // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
+  // finishes the last dump segment and writes the HPROF_HEAP_DUMP_END record.
   DumperSupport::end_of_dump(writer());
 
   // Now we clear the global variables, so that a future dumper might run.
@@ -1884,6 +2044,34 @@ void VM_HeapDumper::doit() {
   clear_global_writer();
 }
 
+void VM_HeapDumper::dump_objects() {
+  CollectedHeap* ch = Universe::heap();
+  WorkGang* workers = ch->get_safepoint_workers();
+  ParallelObjectIterator* poi = NULL;
+  uint num_workers = 0;
+
+  if (workers != NULL && _num_dump_threads != 1) {
+    num_workers = workers->active_workers();
+    if (_num_dump_threads > 1) {
+      num_workers = MIN2(num_workers, _num_dump_threads);
+    }
+    if (num_workers > 1) {
+      poi = ch->parallel_object_iterator(num_workers);
+    }
+  }
+
+  if (poi == NULL) {
+    HeapObjectDumper obj_dumper(writer());
+    ch->safe_object_iterate(&obj_dumper);
+  } else {
+    // The workers write segments of their own, so end ours before they start
+    writer()->finish_dump_segment();
+    ParallelHeapDumpTask task(writer()->file(), writer()->compression_level(), poi);
+    workers->run_task(&task, num_workers);
+    delete poi;
+  }
+}
+
 void VM_HeapDumper::dump_stack_traces() {
   // write a HPROF_TRACE record without any frames to be referenced as object alloc sites
   DumperSupport::write_header(writer(), HPROF_TRACE, 3*sizeof(u4));
@@ -1939,8 +2127,14 @@ void VM_HeapDumper::dump_stack_traces() {
 }
 
 // dump the heap to given path.
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, int compression_level, uint num_dump_threads) {
   assert(path != NULL && strlen(path) > 0, "path missing");
+  assert(compression_level >= 0 && compression_level <= 9, "invalid compression level");
+
+  if (compression_level > 0 && !ClassLoader::supports_gzip()) {
+    set_error((char*)"Compression is not supported by the zip library");
+    return -1;
+  }
 
   // print message in interactive case
   if (print_to_tty()) {
@@ -1948,10 +2142,10 @@ int HeapDumper::dump(const char* path) {
     timer()->start();
   }
 
-  // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
-  if (!writer.is_open()) {
-    set_error(writer.error());
+  // create the dump file. If the file can be opened then bail
+  DumpFile file(path);
+  if (!file.is_open()) {
+    set_error(file.error());
     if (print_to_tty()) {
       tty->print_cr("Unable to create %s: %s", path,
         (error() != NULL) ? error() : "reason unknown");
@@ -1960,30 +2154,33 @@ int HeapDumper::dump(const char* path) {
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
-  if (Thread::current()->is_VM_thread()) {
-    assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
-    dumper.doit();
-  } else {
-    VMThread::execute(&dumper);
+  {
+    DumpWriter writer(&file, compression_level);
+    VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, num_dump_threads);
+    if (Thread::current()->is_VM_thread()) {
+      assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
+      dumper.doit();
+    } else {
+      VMThread::execute(&dumper);
+    }
   }
 
-  // close dump file and record any error that the writer may have encountered
-  writer.close();
-  set_error(writer.error());
+  // close dump file and record any error that the writers may have encountered
+  file.close();
+  set_error(file.error());
 
   // print message in interactive case
   if (print_to_tty()) {
     timer()->stop();
     if (error() == NULL) {
       tty->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
-                    writer.bytes_written(), timer()->seconds());
+                    file.bytes_written(), timer()->seconds());
     } else {
-      tty->print_cr("Dump file is incomplete: %s", writer.error());
+      tty->print_cr("Dump file is incomplete: %s", file.error());
     }
   }
 
-  return (writer.error() == NULL) ? 0 : -1;
+  return (file.error() == NULL) ? 0 : -1;
 }
 
 // stop timer (if still active), and free any error string we might be holding
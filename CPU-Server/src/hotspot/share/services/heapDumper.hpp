@@ -71,7 +71,10 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // compression_level > 0 writes the file gzip compressed at that level,
+  // num_dump_threads != 1 dumps the objects with up to that many GC worker
+  // threads (0 for all of them) if the heap supports parallel iteration.
+  int dump(const char* path, int compression_level = 0, uint num_dump_threads = 1);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -48,8 +48,8 @@ class MallocSite : public AllocationSite<MemoryCounter> {
     AllocationSite<MemoryCounter>(stack), _flags(flags) {}
 
 
-  void allocate(size_t size)      { data()->allocate(size);   }
-  void deallocate(size_t size)    { data()->deallocate(size); }
+  void allocate(size_t size, size_t count)   { data()->allocate(size, count);   }
+  void deallocate(size_t size, size_t count) { data()->deallocate(size, count); }
 
   // Memory allocated from this code path
   size_t size()  const { return peek()->size(); }
@@ -93,8 +93,8 @@ class MallocSiteHashtableEntry : public CHeapObj<mtNMT> {
     return _malloc_site.equals(stack);
   }
   // Allocation/deallocation on this allocation site
-  inline void allocate(size_t size)   { _malloc_site.allocate(size);   }
-  inline void deallocate(size_t size) { _malloc_site.deallocate(size); }
+  inline void allocate(size_t size, size_t count)   { _malloc_site.allocate(size, count);   }
+  inline void deallocate(size_t size, size_t count) { _malloc_site.deallocate(size, count); }
   // Memory counters
   inline size_t size() const  { return _malloc_site.size();  }
   inline size_t count() const { return _malloc_site.count(); }
@@ -195,19 +195,21 @@ class MallocSiteTable : AllStatic {
   }
 
   // Record a new allocation from specified call path.
+  // The allocation is counted as count allocations of size bytes in total,
+  // which is more than one when it stands for the unsampled allocations.
   // Return true if the allocation is recorded successfully, bucket_idx
   // and pos_idx are also updated to indicate the entry where the allocation
   // information was recorded.
   // Return false only occurs under rare scenarios:
   //  1. out of memory
   //  2. overflow hash bucket
-  static inline bool allocation_at(const NativeCallStack& stack, size_t size,
+  static inline bool allocation_at(const NativeCallStack& stack, size_t size, size_t count,
     size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) {
     AccessLock locker(&_access_count);
     if (locker.sharedLock()) {
       NOT_PRODUCT(_peak_count = MAX2(_peak_count, _access_count);)
       MallocSite* site = lookup_or_add(stack, bucket_idx, pos_idx, flags);
-      if (site != NULL) site->allocate(size);
+      if (site != NULL) site->allocate(size, count);
       return site != NULL;
     }
     return false;
@@ -215,13 +217,13 @@ class MallocSiteTable : AllStatic {
 
   // Record memory deallocation. bucket_idx and pos_idx indicate where the allocation
   // information was recorded.
-  static inline bool deallocation_at(size_t size, size_t bucket_idx, size_t pos_idx) {
+  static inline bool deallocation_at(size_t size, size_t count, size_t bucket_idx, size_t pos_idx) {
     AccessLock locker(&_access_count);
     if (locker.sharedLock()) {
       NOT_PRODUCT(_peak_count = MAX2(_peak_count, _access_count);)
       MallocSite* site = malloc_site(bucket_idx, pos_idx);
       if (site != NULL) {
-        site->deallocate(size);
+        site->deallocate(size, count);
         return true;
       }
     }
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 
 #include "runtime/atomic.hpp"
+#include "runtime/os.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/mallocTracker.inline.hpp"
@@ -31,6 +32,49 @@
 
 size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
 
+// The first allocation made with sampling enabled starts the sample sequence
+volatile intx MallocSampler::_bytes_until_sample = 1;
+
+intx MallocSampler::next_sample_distance() {
+  // Exponentially distributed with the mean of the sample interval,
+  // the uniform variate lies in the open interval (0, 1)
+  double u = ((double)os::random() + 1.0) / ((double)max_jint + 2.0);
+  double distance = -log(u) * (double)NativeMemoryTrackingSampleInterval;
+  return (intx)MIN2(distance, (double)(max_intx / 2)) + 1;
+}
+
+double MallocSampler::sample_probability(size_t size) {
+  assert(is_enabled(), "Sampling not enabled");
+  return 1.0 - exp(-(double)MAX2(size, (size_t)1) / (double)NativeMemoryTrackingSampleInterval);
+}
+
+bool MallocSampler::caller_stack(const NativeCallStack& funnel_stack, NativeCallStack* result) {
+  address caller = funnel_stack.get_frame(0);
+  if (caller == NULL) {
+    return false;
+  }
+  // Deep enough for the nested funnels, e.g. ResourceObj::operator new ->
+  // AllocateHeap -> os::malloc -> MallocTracker::record_malloc
+  const int max_funnel_frames = 8;
+  address pcs[NMT_TrackingStackDepth + max_funnel_frames];
+  int frames = os::get_native_stack(pcs, NMT_TrackingStackDepth + max_funnel_frames);
+  for (int i = 0; i < frames; i++) {
+    if (pcs[i] == caller) {
+      *result = NativeCallStack(&pcs[i], frames - i);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t MallocSampler::estimated_size(size_t size) {
+  return (size_t)((double)size / sample_probability(size) + 0.5);
+}
+
+size_t MallocSampler::estimated_count(size_t size) {
+  return (size_t)(1.0 / sample_probability(size) + 0.5);
+}
+
 // Total malloc'd memory amount
 size_t MallocMemorySnapshot::total() const {
   size_t amount = 0;
@@ -71,14 +115,15 @@ void MallocHeader::release() const {
 
   MallocMemorySummary::record_free(size(), flags());
   MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
+  if (MemTracker::tracking_level() == NMT_detail && has_site()) {
+    MallocSiteTable::deallocation_at(site_size(), site_count(), _bucket_idx, _pos_idx);
   }
 }
 
 bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
   size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) const {
-  bool ret = MallocSiteTable::allocation_at(stack, size, bucket_idx, pos_idx, flags);
+  assert(size == this->size(), "Size recorded");
+  bool ret = MallocSiteTable::allocation_at(stack, site_size(), site_count(), bucket_idx, pos_idx, flags);
 
   // Something went wrong, could be OOM or overflow malloc site table.
   // We want to keep tracking data under OOM circumstance, so transition to
@@ -90,7 +135,7 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
-  return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
+  return has_site() && MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
 bool MallocTracker::initialize(NMT_TrackingLevel level) {
@@ -132,7 +177,30 @@ void* MallocTracker::record_malloc(void* malloc_base, size_t size, MEMFLAGS flag
     return malloc_base;
   }
 
-  header = ::new (malloc_base)MallocHeader(size, flags, stack, level);
+  bool record_site = (level == NMT_detail);
+  bool sampled = false;
+  if (record_site && MallocSampler::is_enabled()) {
+    sampled = MallocSampler::should_sample(size);
+    record_site = sampled;
+  }
+
+  if (sampled && stack.frames() <= 1 && NMT_stack_walkable) {
+    // The malloc funnels leave the stack walk to sampled allocations and only
+    // pass their return address, so that the stack starts at their caller.
+    NativeCallStack sampled_stack;
+    if (!MallocSampler::caller_stack(stack, &sampled_stack)) {
+      if (stack.is_empty()) {
+        // No return address, skip this frame and os::malloc()/os::realloc()
+        // to start at the funnel.
+        sampled_stack = NativeCallStack(2, true);
+      } else {
+        sampled_stack = stack;
+      }
+    }
+    header = ::new (malloc_base)MallocHeader(size, flags, sampled_stack, level, record_site, sampled);
+  } else {
+    header = ::new (malloc_base)MallocHeader(size, flags, stack, level, record_site, sampled);
+  }
   memblock = (void*)((char*)malloc_base + sizeof(MallocHeader));
 
   // The alignment check: 8 bytes alignment for 32 bit systems.
@@ -29,6 +29,7 @@
 
 #include "memory/allocation.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/nmtCommon.hpp"
 #include "utilities/nativeCallStack.hpp"
@@ -52,8 +53,8 @@ class MemoryCounter {
     DEBUG_ONLY(_peak_size  = 0;)
   }
 
-  inline void allocate(size_t sz) {
-    Atomic::inc(&_count);
+  inline void allocate(size_t sz, size_t count = 1) {
+    Atomic::add(count, &_count);
     if (sz > 0) {
       Atomic::add(sz, &_size);
       DEBUG_ONLY(_peak_size = MAX2(_peak_size, _size));
@@ -61,10 +62,10 @@ class MemoryCounter {
     DEBUG_ONLY(_peak_count = MAX2(_peak_count, _count);)
   }
 
-  inline void deallocate(size_t sz) {
-    assert(_count > 0, "Nothing allocated yet");
+  inline void deallocate(size_t sz, size_t count = 1) {
+    assert(_count >= count, "Nothing allocated yet");
     assert(_size >= sz, "deallocation > allocated");
-    Atomic::dec(&_count);
+    Atomic::sub(count, &_count);
     if (sz > 0) {
       Atomic::sub(sz, &_size);
     }
@@ -236,6 +237,58 @@ class MallocMemorySummary : AllStatic {
 };
 
 
+/*
+ * Sampling of malloc call sites for detail tracking.
+ * When NativeMemoryTrackingSampleInterval is set, sample points are placed on
+ * the stream of malloc'ed bytes with exponentially distributed gaps of that
+ * mean, and only the allocations that contain a sample point are attributed
+ * to their call sites. An allocation of s bytes is sampled with probability
+ * p(s) = 1 - exp(-s / interval), so recording it as s / p(s) bytes in
+ * 1 / p(s) allocations gives unbiased per site estimates. Summary counters
+ * still account for every allocation.
+ */
+class MallocSampler : AllStatic {
+ private:
+  // Bytes left until the next sample point
+  static volatile intx _bytes_until_sample;
+
+  static intx   next_sample_distance();
+  static double sample_probability(size_t size);
+
+ public:
+  static inline bool is_enabled() {
+    return NativeMemoryTrackingSampleInterval > 0;
+  }
+
+  // Whether an allocation of the specified size contains a sample point
+  static inline bool should_sample(size_t size) {
+    intx remaining = Atomic::sub((intx)size, &_bytes_until_sample);
+    if (remaining > 0 || remaining + (intx)size <= 0) {
+      // No sample point in this allocation, or another thread crossed the
+      // sample point and is about to set the next one
+      return false;
+    }
+    Atomic::store(next_sample_distance(), &_bytes_until_sample);
+    return true;
+  }
+
+  // Estimated number of bytes and allocations a sampled allocation stands for
+  static size_t estimated_size(size_t size);
+  static size_t estimated_count(size_t size);
+
+  // The stack passed by a malloc funnel: only its return address, which
+  // costs no stack walk, or an empty stack if that is not available.
+  static inline NativeCallStack funnel_stack(address return_pc) {
+    return NativeCallStack(&return_pc, return_pc != NULL ? 1 : 0);
+  }
+
+  // Walks the current stack and stores the part that starts at the first
+  // frame of the specified stack, which drops the frames of the malloc
+  // funnels and of NMT itself. Returns false if that frame is not found.
+  static bool caller_stack(const NativeCallStack& funnel_stack, NativeCallStack* result);
+};
+
+
 /*
  * Malloc tracking header.
  * To satisfy malloc alignment requirement, NMT uses 2 machine words for tracking purpose,
@@ -245,22 +298,31 @@ class MallocMemorySummary : AllStatic {
 class MallocHeader {
 #ifdef _LP64
   size_t           _size      : 64;
-  size_t           _flags     : 8;
+  size_t           _flags     : 6;
+  size_t           _has_site  : 1;
+  size_t           _sampled   : 1;
   size_t           _pos_idx   : 16;
   size_t           _bucket_idx: 40;
 #define MAX_MALLOCSITE_TABLE_SIZE right_n_bits(40)
 #define MAX_BUCKET_LENGTH         right_n_bits(16)
 #else
   size_t           _size      : 32;
-  size_t           _flags     : 8;
+  size_t           _flags     : 6;
+  size_t           _has_site  : 1;
+  size_t           _sampled   : 1;
   size_t           _pos_idx   : 8;
   size_t           _bucket_idx: 16;
 #define MAX_MALLOCSITE_TABLE_SIZE  right_n_bits(16)
 #define MAX_BUCKET_LENGTH          right_n_bits(8)
 #endif  // _LP64
+#define MAX_MALLOC_FLAGS           right_n_bits(6)
 
  public:
-  MallocHeader(size_t size, MEMFLAGS flags, const NativeCallStack& stack, NMT_TrackingLevel level) {
+  // record_site is set for detail tracking, unless sampling left this
+  // allocation out. sampled tells that the allocation was recorded with
+  // estimated weights.
+  MallocHeader(size_t size, MEMFLAGS flags, const NativeCallStack& stack, NMT_TrackingLevel level,
+    bool record_site, bool sampled) {
     assert(sizeof(MallocHeader) == sizeof(void*) * 2,
       "Wrong header size");
 
@@ -269,8 +331,10 @@ class MallocHeader {
     }
 
     _flags = flags;
+    _has_site = 0;
+    _sampled = sampled;
     set_size(size);
-    if (level == NMT_detail) {
+    if (record_site) {
       size_t bucket_idx;
       size_t pos_idx;
       if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
@@ -278,6 +342,7 @@ class MallocHeader {
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
         _pos_idx = pos_idx;
+        _has_site = 1;
       }
     }
 
@@ -287,6 +352,7 @@ class MallocHeader {
 
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
+  inline bool has_site() const { return _has_site; }
   bool get_stack(NativeCallStack& stack) const;
 
   // Cleanup tracking information before the memory is released.
@@ -296,6 +362,13 @@ class MallocHeader {
   inline void set_size(size_t size) {
     _size = size;
   }
+  // Number of bytes and allocations recorded at the call site
+  inline size_t site_size() const {
+    return _sampled ? MallocSampler::estimated_size(size()) : size();
+  }
+  inline size_t site_count() const {
+    return _sampled ? MallocSampler::estimated_count(size()) : 1;
+  }
   bool record_malloc_site(const NativeCallStack& stack, size_t size,
     size_t* bucket_idx, size_t* pos_idx, MEMFLAGS flags) const;
 };
@@ -220,6 +220,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (MallocSampler::is_enabled()) {
+    out->print_cr("Malloc sites are sampled every " SIZE_FORMAT " bytes on average, "
+                  "their sizes and counts are estimates\n", NativeMemoryTrackingSampleInterval);
+  }
 
   report_malloc_sites();
   report_virtual_memory_allocation_sites();
@@ -54,9 +54,9 @@ bool MemTracker::_is_nmt_env_valid = true;
 static const size_t buffer_size = 64;
 
 NMT_TrackingLevel MemTracker::init_tracking_level() {
-  // Memory type is encoded into tracking header as a byte field,
+  // Memory type is encoded into tracking header as a 6-bit field,
   // make sure that we don't overflow it.
-  STATIC_ASSERT(mt_number_of_types <= max_jubyte);
+  STATIC_ASSERT(mt_number_of_types <= MAX_MALLOC_FLAGS);
 
   char nmt_env_variable[buffer_size];
   jio_snprintf(nmt_env_variable, sizeof(nmt_env_variable), "NMT_LEVEL_%d", os::current_process_id());
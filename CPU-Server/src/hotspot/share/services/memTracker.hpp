@@ -33,6 +33,7 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define MALLOC_CALLER_PC NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -90,6 +91,12 @@ extern volatile bool NMT_stack_walkable;
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
+// Call stack for the malloc funnels. With sampling only the return address of
+// the funnel is passed, and MallocTracker walks the stack from that caller for
+// the allocations that are sampled.
+#define MALLOC_CALLER_PC (MallocSampler::is_enabled() ?                     \
+                          MallocSampler::funnel_stack(CALLER_RETURN_PC()) : \
+                          CALLER_PC)
 
 class MemBaseline;
 
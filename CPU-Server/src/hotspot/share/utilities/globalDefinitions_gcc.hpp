@@ -272,6 +272,9 @@ inline int wcslen(const jchar* x) { return wcslen((const wchar_t*)x); }
 #define NOINLINE     __attribute__ ((noinline))
 #define ALWAYSINLINE inline __attribute__ ((always_inline))
 
+// Return address of the current function, as it appears in the native stack
+#define CALLER_RETURN_PC() ((address)__builtin_return_address(0))
+
 // Alignment
 //
 // NOTE! The "+0" below is a workaround for a known bug in older GCC versions
@@ -258,6 +258,9 @@ inline int wcslen(const jchar* x) { return wcslen((const wchar_t*)x); }
 #define NOINLINE
 #define ALWAYSINLINE inline __attribute__((always_inline))
 
+// Return address of the current function, not available
+#define CALLER_RETURN_PC() ((address)NULL)
+
 // Alignment
 #define ATTRIBUTE_ALIGNED(x) __attribute__((aligned(x)))
 
@@ -44,6 +44,7 @@
 # include <fcntl.h>
 # include <limits.h>
 # include <inttypes.h>
+# include <intrin.h>  // for _ReturnAddress
 // Need this on windows to get the math constants (e.g., M_PI).
 #define _USE_MATH_DEFINES
 # include <math.h>
@@ -169,6 +170,9 @@ inline int g_isfinite(jdouble f)                 { return _finite(f); }
 #define NOINLINE     __declspec(noinline)
 #define ALWAYSINLINE __forceinline
 
+// Return address of the current function, as it appears in the native stack
+#define CALLER_RETURN_PC() ((address)_ReturnAddress())
+
 // Alignment
 #define ATTRIBUTE_ALIGNED(x) __declspec(align(x))
 
@@ -166,4 +166,7 @@ inline int wcslen(const jchar* x) { return wcslen((const wchar_t*)x); }
 #define NOINLINE     __attribute__((__noinline__))
 #define ALWAYSINLINE inline __attribute__((__always_inline__))
 
+// Return address of the current function, as it appears in the native stack
+#define CALLER_RETURN_PC() ((address)__builtin_return_address(0))
+
 #endif // SHARE_VM_UTILITIES_GLOBALDEFINITIONS_XLC_HPP
@@ -1478,6 +1478,13 @@ void VMError::report_and_die(int id, const char* message, const char* detail_fmt
     log.set_fd(-1);
   }
 
+  static bool skip_async_log = false;
+  if (!skip_async_log) {
+    skip_async_log = true;
+    // Write out the messages still buffered by asynchronous log outputs
+    LogConfiguration::try_write_async_messages();
+  }
+
   static bool skip_replay = ReplayCompiles; // Do not overwrite file during replay
   if (DumpReplayDataOnError && _thread && _thread->is_Compiler_thread() && !skip_replay) {
     skip_replay = true;
@@ -1589,3 +1589,68 @@ ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pm
     inflateEnd(&strm);
     return JNI_TRUE;
 }
+
+/*
+ * Returns the size of the output buffer ZIP_GZip_Fully needs to compress
+ * inLen bytes at the given level, or 0 if the level is not supported.
+ */
+JNIEXPORT jlong
+ZIP_GZip_Bound(jlong inLen, jint level)
+{
+    z_stream strm;
+    jlong bound;
+    memset(&strm, 0, sizeof(z_stream));
+
+    if (deflateInit2(&strm, level, Z_DEFLATED, MAX_WBITS + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    bound = (jlong)deflateBound(&strm, (uLong)inLen);
+    deflateEnd(&strm);
+    return bound;
+}
+
+/*
+ * Compresses the input buffer into the output buffer as one complete gzip
+ * member, so the outputs of several calls can be concatenated to a valid
+ * gzip file. The output buffer must be at least ZIP_GZip_Bound(inLen, level)
+ * bytes long. Returns the number of compressed bytes, or 0 with an error
+ * message in pmsg.
+ */
+JNIEXPORT jlong
+ZIP_GZip_Fully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, jint level,
+               char **pmsg)
+{
+    z_stream strm;
+    jlong result = 0;
+    memset(&strm, 0, sizeof(z_stream));
+
+    *pmsg = 0; /* Reset error message */
+
+    if (deflateInit2(&strm, level, Z_DEFLATED, MAX_WBITS + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        *pmsg = strm.msg != NULL ? strm.msg : "ZIP_GZip_Fully: cannot initialize";
+        return 0;
+    }
+
+    strm.next_in = (Bytef *) inBuf;
+    strm.avail_in = (uInt)inLen;
+    strm.next_out = (Bytef *) outBuf;
+    strm.avail_out = (uInt)outLen;
+
+    switch (deflate(&strm, Z_FINISH)) {
+        case Z_STREAM_END:
+            result = (jlong)strm.total_out;
+            break;
+        case Z_OK:
+        case Z_BUF_ERROR:
+            *pmsg = "ZIP_GZip_Fully: output buffer too small";
+            break;
+        default:
+            *pmsg = "ZIP_GZip_Fully: internal error";
+            break;
+    }
+
+    deflateEnd(&strm);
+    return result;
+}
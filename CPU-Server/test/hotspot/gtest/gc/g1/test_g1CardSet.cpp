@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CardSet.hpp"
+#include "gc/g1/g1CardSetContainers.inline.hpp"
+#include "unittest.hpp"
+
+class G1CardSetTest : public ::testing::Test {
+ public:
+  static const uint CardsInRegion = 1024;
+  static const uint CardsInArray = 16;
+  static const uint NumBuckets = 4;
+  static const uint CoarsenPercent = 10;
+
+  // Adds the given number of distinct cards to the given region, returning
+  // the number of cards that were newly added.
+  static uint add_cards(G1CardSet* card_set, uint region_idx, uint num_cards) {
+    uint num_added = 0;
+    for (uint i = 0; i < num_cards; i++) {
+      if (card_set->add_card(region_idx, i * 3 % CardsInRegion) == Added) {
+        num_added++;
+      }
+    }
+    return num_added;
+  }
+
+  static size_t count_iterated(G1CardSet* card_set) {
+    G1CardSetIterator iter(card_set);
+    uint region_idx;
+    uint card_in_region;
+    size_t count = 0;
+    while (iter.has_next(region_idx, card_in_region)) {
+      EXPECT_TRUE(card_set->contains_card(region_idx, card_in_region));
+      count++;
+    }
+    EXPECT_EQ(count, iter.num_yielded());
+    return count;
+  }
+};
+
+TEST_VM_F(G1CardSetTest, configuration) {
+  G1CardSetConfiguration config(CardsInRegion, CardsInArray, NumBuckets, CoarsenPercent);
+
+  ASSERT_EQ(10u, config.inline_ptr_bits_per_card());
+  ASSERT_EQ(5u, config.num_cards_in_inline_ptr());
+  ASSERT_EQ(CardsInArray, config.num_cards_in_array());
+  ASSERT_EQ(CardsInRegion * CoarsenPercent / 100, config.cards_in_bitmap_threshold());
+  ASSERT_EQ(NumBuckets, config.num_buckets());
+  ASSERT_LT(config.array_size_in_bytes(), config.bitmap_size_in_bytes());
+
+  // The array never gets larger than the bitmap, and the number of buckets is
+  // a power of two.
+  G1CardSetConfiguration config2(CardsInRegion, CardsInRegion, NumBuckets + 1, CoarsenPercent);
+  ASSERT_EQ(CardsInRegion / 32, config2.num_cards_in_array());
+  ASSERT_EQ(NumBuckets, config2.num_buckets());
+}
+
+TEST_VM_F(G1CardSetTest, inline_ptr) {
+  G1CardSet::CardSetPtr value = (G1CardSet::CardSetPtr)G1CardSet::CardSetInlinePtr;
+  G1CardSetInlinePtr cards(&value, value);
+  const uint bits_per_card = 10;
+  const uint max_cards = G1CardSetInlinePtr::max_cards_in_inline_ptr(bits_per_card);
+
+  for (uint i = 0; i < max_cards; i++) {
+    ASSERT_EQ(Added, cards.add(CardsInRegion - 1 - i, bits_per_card, max_cards));
+    ASSERT_EQ(Found, cards.add(CardsInRegion - 1 - i, bits_per_card, max_cards));
+  }
+  ASSERT_EQ(Overflow, cards.add(0, bits_per_card, max_cards));
+
+  G1CardSetInlinePtr result(value);
+  ASSERT_EQ(max_cards, result.num_cards());
+  for (uint i = 0; i < max_cards; i++) {
+    ASSERT_EQ(CardsInRegion - 1 - i, result.card_at(i, bits_per_card));
+    ASSERT_TRUE(result.contains(CardsInRegion - 1 - i, bits_per_card));
+  }
+  ASSERT_FALSE(result.contains(0, bits_per_card));
+}
+
+TEST_VM_F(G1CardSetTest, add_and_coarsen) {
+  G1CardSetConfiguration config(CardsInRegion, CardsInArray, NumBuckets, CoarsenPercent);
+  G1CardSet card_set(&config);
+  const jint num_coarsenings = G1CardSet::num_coarsenings();
+
+  ASSERT_TRUE(card_set.is_empty());
+  ASSERT_EQ(0u, card_set.occupied());
+
+  // Regions 1 and 5 share a bucket; each ends up in a different container type.
+  const uint inline_cards = config.num_cards_in_inline_ptr();
+  const uint array_cards = config.num_cards_in_array();
+  const uint bitmap_cards = config.cards_in_bitmap_threshold();
+
+  ASSERT_EQ(inline_cards, add_cards(&card_set, 1, inline_cards));
+  ASSERT_EQ(array_cards, add_cards(&card_set, 5, array_cards));
+  ASSERT_EQ(bitmap_cards, add_cards(&card_set, 2, bitmap_cards));
+  // The card that overflows the bitmap turns it into a full container,
+  // which already contains that card.
+  ASSERT_EQ(bitmap_cards, add_cards(&card_set, 3, bitmap_cards + 1));
+
+  // Adding the same cards again does not change anything.
+  ASSERT_EQ(0u, add_cards(&card_set, 1, inline_cards));
+  ASSERT_EQ(0u, add_cards(&card_set, 2, bitmap_cards));
+
+  ASSERT_FALSE(card_set.is_empty());
+  ASSERT_EQ(4u, card_set.num_regions());
+  ASSERT_EQ(num_coarsenings + 1, G1CardSet::num_coarsenings());
+
+  ASSERT_TRUE(card_set.contains_card(1, 0));
+  ASSERT_FALSE(card_set.contains_card(1, 1));
+  ASSERT_TRUE(card_set.contains_card(5, (array_cards - 1) * 3));
+  ASSERT_FALSE(card_set.contains_card(5, array_cards * 3));
+  // The full region contains all cards.
+  ASSERT_TRUE(card_set.contains_card(3, 1));
+  ASSERT_FALSE(card_set.contains_card(4, 0));
+
+  const size_t expected = inline_cards + array_cards + bitmap_cards + CardsInRegion;
+  ASSERT_EQ(expected, card_set.occupied());
+  ASSERT_TRUE(card_set.occupancy_less_or_equal_to(expected));
+  ASSERT_FALSE(card_set.occupancy_less_or_equal_to(expected - 1));
+
+  G1CardSetIterator iter(&card_set);
+  uint region_idx;
+  uint card_in_region;
+  while (iter.has_next(region_idx, card_in_region)) { }
+  ASSERT_EQ(expected, iter.num_yielded());
+  ASSERT_EQ((size_t)inline_cards, iter.num_yielded(G1CardSet::CardSetInlinePtr));
+  ASSERT_EQ((size_t)array_cards, iter.num_yielded(G1CardSet::CardSetArrayOfCards));
+  ASSERT_EQ((size_t)bitmap_cards, iter.num_yielded(G1CardSet::CardSetBitMap));
+  ASSERT_EQ((size_t)CardsInRegion, iter.num_yielded(G1CardSet::CardSetFull));
+  ASSERT_EQ(expected, count_iterated(&card_set));
+
+  // Replaced containers are kept until the card set is cleared.
+  ASSERT_GT(G1CardSet::retired_mem_size(), 0u);
+  ASSERT_GT(card_set.mem_size(), sizeof(G1CardSet));
+
+  card_set.clear();
+  ASSERT_TRUE(card_set.is_empty());
+  ASSERT_EQ(0u, card_set.occupied());
+  ASSERT_EQ(sizeof(G1CardSet), card_set.mem_size());
+  ASSERT_EQ(0u, count_iterated(&card_set));
+  ASSERT_FALSE(card_set.contains_card(1, 0));
+}
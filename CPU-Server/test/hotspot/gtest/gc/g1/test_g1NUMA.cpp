@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2014, 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#include "precompiled.hpp"
+#include "gc/g1/g1NUMA.hpp"
+#include "unittest.hpp"
+
+// Exercises the node id to node index mapping of G1NUMA with fake node
+// ids, so that the multi-node paths are covered on any machine.
+class G1NUMATest : public ::testing::Test {
+ protected:
+  G1NUMA* _numa;
+
+  void create(const int* node_ids, uint num_node_ids) {
+    _numa = new G1NUMA();
+    _numa->init_node_id_to_index_map(node_ids, num_node_ids);
+  }
+
+  uint index_of_node_id(int node_id) const {
+    return _numa->index_of_node_id(node_id);
+  }
+
+  uint len_node_id_to_index_map() const {
+    return (uint)_numa->_len_node_id_to_index_map;
+  }
+
+  uint node_id_to_index(int node_id) const {
+    return _numa->_node_id_to_index_map[node_id];
+  }
+
+ public:
+  G1NUMATest() : _numa(NULL) { }
+  ~G1NUMATest() { delete _numa; }
+};
+
+TEST_VM_F(G1NUMATest, single_node) {
+  const int node_ids[] = { 0 };
+  create(node_ids, 1);
+
+  EXPECT_EQ(1u, _numa->num_active_nodes());
+  EXPECT_FALSE(_numa->is_enabled());
+  EXPECT_EQ(0, _numa->numa_id(0));
+  EXPECT_EQ(0u, index_of_node_id(0));
+}
+
+TEST_VM_F(G1NUMATest, sparse_node_ids) {
+  // Node ids need not be dense or sorted.
+  const int node_ids[] = { 5, 0, 7, 2 };
+  const uint num_node_ids = sizeof(node_ids) / sizeof(node_ids[0]);
+  create(node_ids, num_node_ids);
+
+  EXPECT_EQ(num_node_ids, _numa->num_active_nodes());
+  EXPECT_TRUE(_numa->is_enabled());
+  EXPECT_EQ(8u, len_node_id_to_index_map());
+  for (uint i = 0; i < num_node_ids; i++) {
+    EXPECT_EQ(node_ids[i], _numa->numa_id(i));
+    EXPECT_EQ(node_ids[i], _numa->node_ids()[i]);
+    EXPECT_EQ(i, index_of_node_id(node_ids[i]));
+  }
+  // Ids between the active ones are unknown.
+  EXPECT_EQ(G1NUMA::UnknownNodeIndex, node_id_to_index(1));
+  EXPECT_EQ(G1NUMA::UnknownNodeIndex, node_id_to_index(3));
+  EXPECT_EQ(G1NUMA::UnknownNodeIndex, node_id_to_index(4));
+  EXPECT_EQ(G1NUMA::UnknownNodeIndex, node_id_to_index(6));
+}
+
+TEST_VM_F(G1NUMATest, preferred_node_index) {
+  const int node_ids[] = { 1, 3, 4 };
+  create(node_ids, 3);
+
+  // Pages no larger than a region: regions alternate over the nodes.
+  _numa->set_region_info(4 * M, 4 * K);
+  for (uint region = 0; region < 12; region++) {
+    EXPECT_EQ(region % 3, _numa->preferred_node_index_for_index(region));
+  }
+
+  // Several regions per page: all regions of a page prefer the same node.
+  _numa->set_region_info(1 * M, 4 * M);
+  for (uint region = 0; region < 24; region++) {
+    EXPECT_EQ((region / 4) % 3, _numa->preferred_node_index_for_index(region));
+  }
+}
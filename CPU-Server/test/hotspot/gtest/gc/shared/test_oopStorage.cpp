@@ -862,6 +862,7 @@ public:
 
   template<bool concurrent, bool is_const> class Task;
   template<bool concurrent, bool is_const> class TaskUsingOopsDo;
+  class CountDeadTask;
 
 private:
   static WorkGang* _workers;
@@ -1012,6 +1013,55 @@ TEST_VM_F(OopStorageTestParIteration, par_state_concurrent_const_oops_do) {
   vstate.check();
 }
 
+// Treats every visited entry as dead and adds the per-worker count to
+// the ParState.
+class OopStorageTestParIteration::CountDeadTask : public AbstractGangTask {
+  class CountFn {
+    size_t* _count;
+  public:
+    CountFn(size_t* count) : _count(count) {}
+    void operator()(oop* ptr) const { ++*_count; }
+  };
+
+public:
+  CountDeadTask(OopStorage* storage) :
+    AbstractGangTask("test"),
+    _state(storage)
+  {}
+
+  virtual void work(uint worker_id) {
+    size_t count = 0;
+    _state.iterate(CountFn(&count));
+    _state.increment_num_dead(count);
+  }
+
+  size_t num_dead() const { return _state.num_dead(); }
+  void report_num_dead() const { _state.report_num_dead(); }
+
+private:
+  OopStorage::ParState<true, false> _state;
+};
+
+static size_t reported_num_dead = 0;
+
+static void record_num_dead(size_t num_dead) {
+  reported_num_dead = num_dead;
+}
+
+TEST_VM_F(OopStorageTestParIteration, par_state_report_num_dead) {
+  EXPECT_FALSE(_storage.should_report_num_dead());
+  _storage.register_num_dead_callback(&record_num_dead);
+  EXPECT_TRUE(_storage.should_report_num_dead());
+
+  reported_num_dead = 0;
+  CountDeadTask task(&_storage);
+  workers()->run_task(&task);
+  EXPECT_EQ(_max_entries, task.num_dead());
+
+  task.report_num_dead();
+  EXPECT_EQ(_max_entries, reported_num_dead);
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, delete_empty_blocks) {
   size_t initial_active_size = active_count(_storage);
   EXPECT_EQ(initial_active_size, _storage.block_count());
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/z/zMemory.inline.hpp"
+#include "unittest.hpp"
+
+TEST(ZMemoryManager, alloc_at_most) {
+  const size_t PageSize = 2 * M;
+
+  ZMemoryManager manager;
+  manager.free(0 * PageSize, 4 * PageSize);
+  manager.free(6 * PageSize, 4 * PageSize);
+
+  // Partial allocation, limited by the first area
+  size_t allocated = 0;
+  EXPECT_EQ(manager.alloc_from_front_at_most(6 * PageSize, &allocated), 0 * PageSize);
+  EXPECT_EQ(allocated, 4 * PageSize);
+
+  // Allocation smaller than the last area
+  EXPECT_EQ(manager.alloc_from_back_at_most(1 * PageSize, &allocated), 9 * PageSize);
+  EXPECT_EQ(allocated, 1 * PageSize);
+
+  // Partial allocation, limited by the last area
+  EXPECT_EQ(manager.alloc_from_back_at_most(6 * PageSize, &allocated), 6 * PageSize);
+  EXPECT_EQ(allocated, 3 * PageSize);
+
+  // Empty
+  EXPECT_EQ(manager.alloc_from_front_at_most(1 * PageSize, &allocated), UINTPTR_MAX);
+  EXPECT_EQ(manager.alloc_from_back_at_most(1 * PageSize, &allocated), UINTPTR_MAX);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "logging/logAsyncWriter.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/os.hpp"
+#include "unittest.hpp"
+
+static char* make_line(const char* str) {
+  return os::strdup_check_oom(str, mtLogging);
+}
+
+TEST_VM(LogAsyncBuffer, fifo) {
+  LogAsyncBuffer buffer(4);
+  ASSERT_EQ(NULL, buffer.dequeue());
+
+  // Wrap around the slots a few times
+  char name[8];
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 3; i++) {
+      jio_snprintf(name, sizeof(name), "%d-%d", round, i);
+      EXPECT_TRUE(buffer.enqueue(make_line(name)));
+    }
+    for (int i = 0; i < 3; i++) {
+      jio_snprintf(name, sizeof(name), "%d-%d", round, i);
+      char* line = buffer.dequeue();
+      ASSERT_TRUE(line != NULL);
+      EXPECT_STREQ(name, line);
+      os::free(line);
+    }
+    EXPECT_EQ(NULL, buffer.dequeue());
+  }
+  EXPECT_EQ(0u, buffer.take_dropped());
+}
+
+TEST_VM(LogAsyncBuffer, full) {
+  LogAsyncBuffer buffer(2);
+  EXPECT_TRUE(buffer.enqueue(make_line("a")));
+  EXPECT_TRUE(buffer.enqueue(make_line("b")));
+
+  char* line = make_line("c");
+  EXPECT_FALSE(buffer.enqueue(line));
+  os::free(line);
+  line = make_line("d");
+  EXPECT_FALSE(buffer.enqueue(line));
+  os::free(line);
+  EXPECT_EQ(2u, buffer.take_dropped());
+  EXPECT_EQ(0u, buffer.take_dropped());
+
+  // Freeing a slot makes room for the next line
+  line = buffer.dequeue();
+  EXPECT_STREQ("a", line);
+  os::free(line);
+  EXPECT_TRUE(buffer.enqueue(make_line("e")));
+
+  // Lines left in the buffer are freed with it
+}
@@ -54,7 +54,7 @@ TEST_VM(FlagGuard, uint_flag) {
 }
 
 TEST_VM(FlagGuard, uintx_flag) {
-  TEST_FLAG(GCTaskTimeStampEntries, uint, 1337);
+  TEST_FLAG(ConcGCThreads, uint, 1337);
 }
 
 TEST_VM(FlagGuard, size_t_flag) {
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+
+// Included early because the NMT flags don't include it.
+#include "utilities/macros.hpp"
+
+#if INCLUDE_NMT
+
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "services/mallocTracker.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "unittest.hpp"
+
+class SampleIntervalMark : public StackObj {
+ private:
+  size_t _saved;
+ public:
+  SampleIntervalMark(size_t interval) : _saved(NativeMemoryTrackingSampleInterval) {
+    NativeMemoryTrackingSampleInterval = interval;
+  }
+  ~SampleIntervalMark() {
+    NativeMemoryTrackingSampleInterval = _saved;
+  }
+};
+
+TEST_VM(NMT, malloc_sampler_estimates) {
+  SampleIntervalMark mark(4 * K);
+  ASSERT_TRUE(MallocSampler::is_enabled());
+
+  // Large allocations are always sampled and stand for themselves
+  EXPECT_EQ((size_t)(1 * M), MallocSampler::estimated_size(1 * M));
+  EXPECT_EQ((size_t)1, MallocSampler::estimated_count(1 * M));
+
+  // Small allocations stand for about interval / size allocations
+  EXPECT_NEAR(4.0 * K, (double)MallocSampler::estimated_count(1), 1.0);
+  EXPECT_NEAR(4.0 * K, (double)MallocSampler::estimated_size(1), 1.0);
+
+  for (size_t size = 1; size <= 64 * K; size *= 2) {
+    EXPECT_GE(MallocSampler::estimated_size(size), size);
+    EXPECT_GE(MallocSampler::estimated_count(size), (size_t)1);
+  }
+}
+
+TEST_VM(NMT, malloc_sampler_unbiased) {
+  SampleIntervalMark mark(4 * K);
+
+  const int allocations = 200000;
+  double total_size = 0.0;
+  double estimated_size = 0.0;
+  double estimated_count = 0.0;
+  for (int i = 0; i < allocations; i++) {
+    size_t size = 16 + (size_t)(os::random() % (2 * K));
+    total_size += (double)size;
+    if (MallocSampler::should_sample(size)) {
+      estimated_size += (double)MallocSampler::estimated_size(size);
+      estimated_count += (double)MallocSampler::estimated_count(size);
+    }
+  }
+
+  EXPECT_NEAR(total_size, estimated_size, total_size * 0.05);
+  EXPECT_NEAR((double)allocations, estimated_count, allocations * 0.05);
+}
+
+// A malloc funnel: the sampled stack must start at its caller, not in here.
+static NOINLINE NativeCallStack sampled_stack_from_funnel() {
+  NativeCallStack funnel = MallocSampler::funnel_stack(CALLER_RETURN_PC());
+  NativeCallStack stack;
+  if (!MallocSampler::caller_stack(funnel, &stack)) {
+    return NativeCallStack();
+  }
+  return stack;
+}
+
+static volatile int call_sites_called = 0;
+
+// The increments keep the funnel calls from becoming tail calls.
+static NOINLINE void malloc_call_site_a(NativeCallStack* stack) {
+  *stack = sampled_stack_from_funnel();
+  call_sites_called++;
+}
+
+static NOINLINE void malloc_call_site_b(NativeCallStack* stack) {
+  *stack = sampled_stack_from_funnel();
+  call_sites_called++;
+}
+
+static void check_top_frame(const NativeCallStack& stack, const char* call_site) {
+  char buf[256];
+  int offset;
+  if (os::dll_address_to_function_name(stack.get_frame(0), buf, sizeof(buf), &offset)) {
+    EXPECT_TRUE(strstr(buf, call_site) != NULL) << "top frame " << buf << " is not in " << call_site;
+  }
+}
+
+TEST_VM(NMT, malloc_sampler_stack_starts_at_caller) {
+  if (CALLER_RETURN_PC() == NULL) {
+    return; // the funnels pass no return address on this platform
+  }
+
+  NativeCallStack stack_a;
+  NativeCallStack stack_b;
+  malloc_call_site_a(&stack_a);
+  malloc_call_site_b(&stack_b);
+  ASSERT_FALSE(stack_a.is_empty());
+  ASSERT_FALSE(stack_b.is_empty());
+
+  // Different call sites of the same funnel must not collapse into one site
+  EXPECT_NE(stack_a.get_frame(0), stack_b.get_frame(0));
+  // and the stack goes on into this test
+  EXPECT_GE(stack_a.frames(), 2);
+
+  check_top_frame(stack_a, "malloc_call_site_a");
+  check_top_frame(stack_b, "malloc_call_site_b");
+}
+
+#endif // INCLUDE_NMT
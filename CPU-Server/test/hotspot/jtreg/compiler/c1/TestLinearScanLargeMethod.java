@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary C1 code stays correct when LinearScan limits the split position
+ *          search of very large methods.
+ * @requires vm.compiler1.enabled
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1 -XX:LinearScanLargeMethodThreshold=1
+ *                   compiler.c1.TestLinearScanLargeMethod
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1 -XX:LinearScanLargeMethodThreshold=0
+ *                   compiler.c1.TestLinearScanLargeMethod
+ */
+
+package compiler.c1;
+
+public class TestLinearScanLargeMethod {
+    // Many values live across loops and calls force interval splitting.
+    static long test(int n) {
+        long a = n, b = n + 1, c = n + 2, d = n + 3, e = n + 4, f = n + 5, g = n + 6, h = n + 7;
+        long i = n * 2, j = n * 3, k = n * 5, l = n * 7, m = n * 11, o = n * 13;
+        for (int x = 0; x < n; x++) {
+            a += b ^ x; b += c * x; c += d - x; d += e + x;
+            if ((x & 1) == 0) {
+                e += f; f += g; g += h; h += a;
+                i = Long.rotateLeft(i, 3) + j;
+            } else {
+                j += k; k += l; l += m; m += o; o += i;
+            }
+            for (int y = 0; y < 3; y++) {
+                a = a * 31 + callee(b, c, y);
+                h = h * 17 + callee(g, f, y);
+            }
+        }
+        return a + b + c + d + e + f + g + h + i + j + k + l + m + o;
+    }
+
+    static long callee(long p, long q, int r) {
+        return (p ^ q) + r;
+    }
+
+    public static void main(String[] args) {
+        long expected = test(100);
+        for (int iter = 0; iter < 20_000; iter++) {
+            long result = test(100);
+            if (result != expected) {
+                throw new RuntimeException("iteration " + iter + ": expected " + expected + " but got " + result);
+            }
+        }
+    }
+}
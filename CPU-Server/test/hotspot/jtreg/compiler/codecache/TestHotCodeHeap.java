@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The hot code heap is reserved next to the non-profiled code heap,
+ *          hot level 4 code is recompiled into it, and it is ignored
+ *          without a segmented code cache.
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver compiler.codecache.TestHotCodeHeap
+ */
+
+package compiler.codecache;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestHotCodeHeap {
+    static class Workload {
+        // Not inlined and long running, so that the frequent guaranteed
+        // safepoints (see main) mostly find the thread in its nmethod.
+        static long hot(long n) {
+            long sum = 0;
+            for (long i = 0; i < n; i++) {
+                sum += (i & 1) == 0 ? i * 7 : i - 3;
+            }
+            return sum;
+        }
+
+        public static void main(String[] args) {
+            long sum = 0;
+            long end = System.currentTimeMillis() + 2000;
+            while (System.currentTimeMillis() < end) {
+                sum += hot(100_000);
+            }
+            System.out.println("sum " + sum);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        OutputAnalyzer out = run("-XX:+SegmentedCodeCache",
+                                 "-XX:ReservedCodeCacheSize=240m",
+                                 "-XX:HotCodeHeapSize=8m",
+                                 "-XX:HotCodeSampleThreshold=1",
+                                 "-XX:HotCodeSweepInterval=10",
+                                 "-XX:+PrintCodeCache",
+                                 "-XX:CompileCommand=dontinline,*Workload::hot",
+                                 "-XX:+UnlockDiagnosticVMOptions",
+                                 "-XX:GuaranteedSafepointInterval=10",
+                                 "-Xlog:codecache+sweep=debug");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("CodeHeap 'hot nmethods'");
+        out.shouldContain("CodeHeap 'non-profiled nmethods'");
+        out.shouldMatch("Recompiling hot nmethod [0-9]+ .* of .*Workload\\.hot\\(J\\)J into the hot code heap");
+        out.shouldMatch("Installed nmethod [0-9]+ of .*Workload\\.hot\\(J\\)J in the hot code heap");
+
+        out = run("-XX:-SegmentedCodeCache",
+                  "-XX:HotCodeHeapSize=8m",
+                  "-XX:+PrintCodeCache");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("HotCodeHeapSize is ignored because SegmentedCodeCache is disabled");
+        out.shouldNotContain("CodeHeap 'hot nmethods'");
+    }
+
+    static OutputAnalyzer run(String... flags) throws Exception {
+        String[] args = new String[flags.length + 1];
+        System.arraycopy(flags, 0, args, 0, flags.length);
+        args[flags.length] = Workload.class.getName();
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true, args);
+        return new OutputAnalyzer(pb.start());
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Field loads through Phis which merge allocations are split so
+ *          the allocations can be scalar replaced; check the results and
+ *          that the compiled merges no longer allocate.
+ * @requires vm.compiler2.enabled
+ * @modules java.management
+ *
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:CompileCommand=exclude,compiler.escapeAnalysis.TestAllocationMerges::main
+ *                   -XX:CompileCommand=exclude,compiler.escapeAnalysis.TestAllocationMerges::checkEliminated
+ *                   compiler.escapeAnalysis.TestAllocationMerges eliminated
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:-ReduceAllocationMerges
+ *                   -XX:CompileCommand=exclude,compiler.escapeAnalysis.TestAllocationMerges::main
+ *                   compiler.escapeAnalysis.TestAllocationMerges
+ */
+
+package compiler.escapeAnalysis;
+
+import java.lang.management.ManagementFactory;
+
+public class TestAllocationMerges {
+    static class Point {
+        int x;
+        int y;
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static class Box {
+        Object o;
+        long l;
+        Box(Object o, long l) {
+            this.o = o;
+            this.l = l;
+        }
+    }
+
+    static Object sink;
+
+    static int simpleMerge(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : new Point(b, a);
+        return p.x * 31 + p.y;
+    }
+
+    static int threeWayMerge(int k, int a, int b) {
+        Point p;
+        if (k == 0) {
+            p = new Point(a, b);
+        } else if (k == 1) {
+            p = new Point(b, a);
+        } else {
+            p = new Point(a + b, a - b);
+        }
+        return p.x - p.y;
+    }
+
+    static long oopFieldMerge(boolean c, String s, long l) {
+        Box b = c ? new Box(s, l) : new Box("other", -l);
+        return ((String)b.o).length() + b.l;
+    }
+
+    static int storeAfterMerge(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : new Point(b, a);
+        p.x += 1;
+        return p.x + p.y;
+    }
+
+    static int escapingMerge(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : new Point(b, a);
+        if (a == 42) {
+            sink = p;
+        }
+        return p.x + p.y * 3;
+    }
+
+    static int mergeAcrossCall(boolean c, int a, int b) {
+        Point p = c ? new Point(a, b) : new Point(b, a);
+        dontInline(a);
+        return p.x + p.y;
+    }
+
+    static void dontInline(int a) {
+        if (a == Integer.MIN_VALUE) {
+            sink = new Object();
+        }
+    }
+
+    static void check(long expected, long actual, String what) {
+        if (expected != actual) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    static long allocatedBytes() {
+        com.sun.management.ThreadMXBean bean =
+            (com.sun.management.ThreadMXBean)ManagementFactory.getThreadMXBean();
+        return bean.getThreadAllocatedBytes(Thread.currentThread().getId());
+    }
+
+    // Runs the compiled merges which are expected to be scalar replaced and
+    // checks that they allocate well below one Point per call.
+    static void checkEliminated() {
+        final int calls = 10_000;
+        long sum = 0;
+        allocatedBytes();
+        long before = allocatedBytes();
+        for (int i = 0; i < calls; i++) {
+            sum += simpleMerge((i & 1) == 0, i, i + 1);
+            sum += threeWayMerge(i % 3, i, i + 1);
+        }
+        long allocated = allocatedBytes() - before;
+        if (allocated >= calls * 8L) {
+            throw new RuntimeException("merged allocations were not eliminated: " +
+                                       allocated + " bytes allocated by " + calls +
+                                       " calls (sum " + sum + ")");
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20_000; i++) {
+            boolean c = (i & 1) == 0;
+            int a = i;
+            int b = i * 7 + 3;
+            check(c ? a * 31 + b : b * 31 + a, simpleMerge(c, a, b), "simpleMerge");
+            int k = i % 3;
+            int exp = (k == 0) ? a - b : (k == 1) ? b - a : 2 * b;
+            check(exp, threeWayMerge(k, a, b), "threeWayMerge");
+            check(c ? 3 + i : 5 - i, oopFieldMerge(c, "abc", i), "oopFieldMerge");
+            check(a + b + 1, storeAfterMerge(c, a, b), "storeAfterMerge");
+            check(c ? a + b * 3 : b + a * 3, escapingMerge(c, a, b), "escapingMerge");
+            check(a + b, mergeAcrossCall(c, a, b), "mergeAcrossCall");
+        }
+        // Take the uncommon paths in the compiled code.
+        check(42 + 9 * 3, escapingMerge(true, 42, 9), "escapingMerge");
+        if (((Point)sink).x != 42) {
+            throw new RuntimeException("escaped object has wrong state");
+        }
+        check(Integer.MIN_VALUE + 1, mergeAcrossCall(false, Integer.MIN_VALUE, 1), "mergeAcrossCall");
+
+        if (args.length > 0 && args[0].equals("eliminated")) {
+            checkEliminated();
+        }
+    }
+}
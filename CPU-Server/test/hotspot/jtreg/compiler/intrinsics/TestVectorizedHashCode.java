@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary The vectorized String.hashCode() and Arrays.hashCode() intrinsics
+ *          produce the same values as the scalar polynomial hash.
+ * @requires vm.compiler2.enabled & (os.arch == "amd64" | os.arch == "x86_64")
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UseVectorizedHashCodeIntrinsic
+ *                   -XX:-TieredCompilation -XX:CompileThreshold=100
+ *                   compiler.intrinsics.TestVectorizedHashCode
+ */
+
+package compiler.intrinsics;
+
+import java.util.Arrays;
+import java.util.Random;
+
+public class TestVectorizedHashCode {
+    static final int ITERATIONS = 2_000;
+    static final int MAX_LENGTH = 200;
+
+    static int hashB(byte[] a)  { return Arrays.hashCode(a); }
+    static int hashC(char[] a)  { return Arrays.hashCode(a); }
+    static int hashS(short[] a) { return Arrays.hashCode(a); }
+    static int hashI(int[] a)   { return Arrays.hashCode(a); }
+    static int hashStr(String s) { return s.hashCode(); }
+
+    static void check(String what, int len, int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException(what + " of length " + len + ": expected " +
+                                       expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        Random r = new Random(42);
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            int len = iter % MAX_LENGTH;
+            byte[] b = new byte[len];
+            char[] c = new char[len];
+            short[] s = new short[len];
+            int[] i = new int[len];
+            r.nextBytes(b);
+            for (int k = 0; k < len; k++) {
+                c[k] = (char) r.nextInt();
+                s[k] = (short) r.nextInt();
+                i[k] = r.nextInt();
+            }
+
+            int hb = 1, hc = 1, hs = 1, hi = 1, hl = 0, hu = 0;
+            char[] latin1 = new char[len];
+            for (int k = 0; k < len; k++) {
+                hb = 31 * hb + b[k];
+                hc = 31 * hc + c[k];
+                hs = 31 * hs + s[k];
+                hi = 31 * hi + i[k];
+                latin1[k] = (char) (b[k] & 0xff);
+                hl = 31 * hl + latin1[k];
+                hu = 31 * hu + c[k];
+            }
+            check("byte[]", len, hb, hashB(b));
+            check("char[]", len, hc, hashC(c));
+            check("short[]", len, hs, hashS(s));
+            check("int[]", len, hi, hashI(i));
+            // Fresh strings so that the cached String.hash is not used.
+            check("Latin1 String", len, hl, hashStr(new String(latin1)));
+            check("UTF16 String", len, hu, hashStr(new String(c)));
+        }
+        check("null byte[]", 0, 0, hashB(null));
+        check("null char[]", 0, 0, hashC(null));
+        check("null short[]", 0, 0, hashS(null));
+        check("null int[]", 0, 0, hashI(null));
+    }
+}
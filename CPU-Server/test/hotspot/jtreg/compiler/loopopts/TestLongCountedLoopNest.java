@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Loops with a long induction variable are turned into a loop
+ *          nest around an int counted loop; check they compute the same
+ *          results, including around the ends of the long range.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::main
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:LoopStripMiningIter=1000
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::main
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:-UseLongCountedLoopNests
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::main
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ */
+
+package compiler.loopopts;
+
+public class TestLongCountedLoopNest {
+    private static final int ITERATIONS = 20_000;
+
+    static long sumUp(long start, long stop, long[] a) {
+        long sum = 0;
+        for (long i = start; i < stop; i++) {
+            sum += a[(int)(i - start)] + i;
+        }
+        return sum;
+    }
+
+    static long sumDown(long start, long stop, long[] a) {
+        long sum = 0;
+        for (long i = start; i > stop; i -= 3) {
+            sum += a[(int)((start - i) / 3)] ^ i;
+        }
+        return sum;
+    }
+
+    static long count(long start, long stop, long stride) {
+        long n = 0;
+        for (long i = start; i < stop; i += stride) {
+            n++;
+        }
+        return n;
+    }
+
+    static void fill(long[] a, long from, long to, long v) {
+        for (long i = from; i < to; i++) {
+            a[(int)i] = v + i;
+        }
+    }
+
+    static void check(String name, long expected, long actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        long[] a = new long[1000];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 31L;
+        }
+
+        // Reference results, computed by this method which is never compiled.
+        long[][] ranges = {
+            { 0, 1000 },
+            { Long.MAX_VALUE - 1000, Long.MAX_VALUE },
+            { Long.MIN_VALUE, Long.MIN_VALUE + 1000 },
+            { -500, 500 },
+            { 10, 10 },
+            { 20, 10 },
+        };
+        long[] expectedUp = new long[ranges.length];
+        long[] expectedDown = new long[ranges.length];
+        for (int r = 0; r < ranges.length; r++) {
+            long start = ranges[r][0];
+            long stop = ranges[r][1];
+            long sum = 0;
+            for (long i = start; i < stop; i++) {
+                sum += a[(int)(i - start)] + i;
+            }
+            expectedUp[r] = sum;
+            sum = 0;
+            for (long i = stop; i > start; i -= 3) {
+                sum += a[(int)((stop - i) / 3)] ^ i;
+            }
+            expectedDown[r] = sum;
+        }
+
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            for (int r = 0; r < ranges.length; r++) {
+                check("sumUp " + r, expectedUp[r], sumUp(ranges[r][0], ranges[r][1], a));
+                check("sumDown " + r, expectedDown[r], sumDown(ranges[r][1], ranges[r][0], a));
+            }
+            check("count small stride", 1000, count(Long.MAX_VALUE - 1000, Long.MAX_VALUE, 1));
+            check("count large stride", 3, count(0, 3L * Integer.MAX_VALUE, Integer.MAX_VALUE));
+            fill(a, 0, a.length, 0);
+            for (int i = 0; i < a.length; i++) {
+                check("fill " + i, i, a[i]);
+            }
+            for (int i = 0; i < a.length; i++) {
+                a[i] = i * 31L;
+            }
+        }
+
+        // More iterations than fit in one inner int loop
+        check("count long", (1L << 32) + 5, count(-5, 1L << 32, 1));
+    }
+}
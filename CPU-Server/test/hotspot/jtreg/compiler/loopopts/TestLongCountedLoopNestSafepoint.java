@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary The inner int loop of a long loop nest must keep polling for
+ *          safepoints, so that time to safepoint stays short while a
+ *          compiled long-indexed loop is running.
+ * @requires vm.compiler2.enabled & vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver compiler.loopopts.TestLongCountedLoopNestSafepoint
+ */
+
+package compiler.loopopts;
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.Utils;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestLongCountedLoopNestSafepoint {
+
+    private static final Pattern STOPPING =
+        Pattern.compile("Stopping threads took: ([0-9.]+) seconds");
+
+    // Far below the time of the 2^31 iterations an inner loop without a
+    // safepoint poll would run, and far above a normal time to safepoint.
+    private static final double MAX_TTSP_SECONDS = 0.5 * Utils.TIMEOUT_FACTOR;
+
+    public static void main(String[] args) throws Exception {
+        runTest();                                 // defaults: strip mined
+        runTest("-XX:LoopStripMiningIter=1");      // poll on every backedge
+    }
+
+    private static void runTest(String... extraFlags) throws Exception {
+        String[] flags = new String[extraFlags.length + 7];
+        int i = 0;
+        flags[i++] = "-XX:+UseG1GC";
+        flags[i++] = "-XX:-TieredCompilation";
+        flags[i++] = "-XX:-BackgroundCompilation";
+        flags[i++] = "-XX:+UseLongCountedLoopNests";
+        for (String f : extraFlags) {
+            flags[i++] = f;
+        }
+        flags[i++] = "-Xlog:safepoint";
+        flags[i++] = "-Xmx64m";
+        flags[i++] = Spinner.class.getName();
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(flags);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain(Spinner.SPINNING);
+
+        // Only look at the safepoints after the spinning thread started.
+        String out = output.getStdout();
+        out = out.substring(out.indexOf(Spinner.SPINNING));
+        Matcher m = STOPPING.matcher(out);
+        int count = 0;
+        double max = 0.0;
+        while (m.find()) {
+            max = Math.max(max, Double.parseDouble(m.group(1)));
+            count++;
+        }
+        if (count < Spinner.GCS) {
+            throw new RuntimeException("Expected at least " + Spinner.GCS + " safepoints, found " + count);
+        }
+        if (max > MAX_TTSP_SECONDS) {
+            throw new RuntimeException("Time to safepoint " + max + "s exceeds " + MAX_TTSP_SECONDS + "s");
+        }
+    }
+
+    static class Spinner {
+        static final String SPINNING = "Spinner is spinning";
+        static final int GCS = 10;
+
+        static volatile long result;
+
+        // A long-indexed loop turned into a loop nest. The multiplication
+        // chain makes 2^31 iterations of the inner loop take seconds.
+        static long spin(long n) {
+            long sum = 1;
+            for (long i = 0; i < n; i++) {
+                sum = sum * 31 + i;
+            }
+            return sum;
+        }
+
+        public static void main(String[] args) throws Exception {
+            // Compile spin() before it runs for a long time.
+            for (int i = 0; i < 20_000; i++) {
+                result = spin(1_000);
+            }
+
+            Thread t = new Thread(() -> { result = spin(Long.MAX_VALUE); });
+            t.setDaemon(true);
+            t.start();
+            Thread.sleep(500);
+
+            System.out.println(SPINNING);
+            for (int i = 0; i < GCS; i++) {
+                System.gc();
+                Thread.sleep(100);
+            }
+        }
+    }
+}
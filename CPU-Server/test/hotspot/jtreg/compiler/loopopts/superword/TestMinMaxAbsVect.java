@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary SuperWord vectorization of int min/max/abs, as element-wise
+ *          operations and as reductions, written with Math calls or as
+ *          the conditional expressions that C2 turns into MinI/MaxI/AbsI
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:+SuperWordReductions -XX:LoopUnrollLimit=250
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.superword.TestMinMaxAbsVect::main
+ *                   compiler.loopopts.superword.TestMinMaxAbsVect
+ * @run main/othervm -XX:-TieredCompilation -XX:-BackgroundCompilation
+ *                   -XX:-SuperWordReductions -XX:LoopUnrollLimit=250
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.superword.TestMinMaxAbsVect::main
+ *                   compiler.loopopts.superword.TestMinMaxAbsVect
+ */
+
+package compiler.loopopts.superword;
+
+import java.util.Random;
+
+public class TestMinMaxAbsVect {
+    private static final int LENGTH = 1024;
+    private static final int ITERATIONS = 20_000;
+
+    static int minReduction(int[] a) {
+        int m = Integer.MAX_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = Math.min(m, a[i]);
+        }
+        return m;
+    }
+
+    static int maxReduction(int[] a) {
+        int m = Integer.MIN_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = Math.max(m, a[i]);
+        }
+        return m;
+    }
+
+    static int minDiamond(int[] a) {
+        int m = Integer.MAX_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] < m) {
+                m = a[i];
+            }
+        }
+        return m;
+    }
+
+    static int maxDiamond(int[] a) {
+        int m = Integer.MIN_VALUE;
+        for (int i = 0; i < a.length; i++) {
+            m = (a[i] > m) ? a[i] : m;
+        }
+        return m;
+    }
+
+    static void minElements(int[] a, int[] b, int[] r) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = Math.min(a[i], b[i]);
+        }
+    }
+
+    static void maxElements(int[] a, int[] b, int[] r) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = (a[i] >= b[i]) ? a[i] : b[i];
+        }
+    }
+
+    static void absElements(int[] a, int[] r) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = Math.abs(a[i]);
+        }
+    }
+
+    static void absDiamond(int[] a, int[] r) {
+        for (int i = 0; i < a.length; i++) {
+            int x = a[i];
+            r[i] = (x < 0) ? -x : x;
+        }
+    }
+
+    static int absSumReduction(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += Math.abs(a[i]);
+        }
+        return sum;
+    }
+
+    static void check(String name, int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    static void check(String name, int[] expected, int[] actual) {
+        for (int i = 0; i < expected.length; i++) {
+            check(name + "[" + i + "]", expected[i], actual[i]);
+        }
+    }
+
+    public static void main(String[] args) {
+        Random rnd = new Random(42);
+        int[] a = new int[LENGTH];
+        int[] b = new int[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            a[i] = rnd.nextInt();
+            b[i] = rnd.nextInt();
+        }
+        // Corner cases: abs(MIN_VALUE) == MIN_VALUE, and extremes in the tail
+        a[7] = Integer.MIN_VALUE;
+        a[LENGTH - 1] = Integer.MAX_VALUE;
+        b[LENGTH - 2] = Integer.MIN_VALUE;
+
+        // Reference results, computed by this method which is never compiled.
+        int[] expectedMin = new int[LENGTH];
+        int[] expectedMax = new int[LENGTH];
+        int[] expectedAbs = new int[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            expectedMin[i] = (a[i] < b[i]) ? a[i] : b[i];
+            expectedMax[i] = (a[i] > b[i]) ? a[i] : b[i];
+            expectedAbs[i] = (a[i] < 0) ? -a[i] : a[i];
+        }
+        int expectedMinA = Integer.MAX_VALUE;
+        int expectedMaxA = Integer.MIN_VALUE;
+        int expectedAbsSum = 0;
+        for (int i = 0; i < LENGTH; i++) {
+            expectedMinA = (a[i] < expectedMinA) ? a[i] : expectedMinA;
+            expectedMaxA = (a[i] > expectedMaxA) ? a[i] : expectedMaxA;
+            expectedAbsSum += expectedAbs[i];
+        }
+
+        int[] r = new int[LENGTH];
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            check("minReduction", expectedMinA, minReduction(a));
+            check("maxReduction", expectedMaxA, maxReduction(a));
+            check("minDiamond", expectedMinA, minDiamond(a));
+            check("maxDiamond", expectedMaxA, maxDiamond(a));
+            check("absSumReduction", expectedAbsSum, absSumReduction(a));
+            minElements(a, b, r);
+            check("minElements", expectedMin, r);
+            maxElements(a, b, r);
+            check("maxElements", expectedMax, r);
+            absElements(a, r);
+            check("absElements", expectedAbs, r);
+            absDiamond(a, r);
+            check("absDiamond", expectedAbs, r);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Profiles of hot methods written at exit by one run are read
+ *          back and seeded into the next run, which compiles them with C2
+ *          without profiling them in tier 3 first.
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver compiler.profiling.TestProfileCache
+ */
+
+package compiler.profiling;
+
+import java.io.File;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestProfileCache {
+    // PrintCompilation lines of Workload.hot at tiers 3 and 4
+    static final String TIER3_HOT = " 3 +compiler\\.profiling\\.TestProfileCache\\$Workload::hot \\(";
+    static final String TIER4_HOT = " 4 +compiler\\.profiling\\.TestProfileCache\\$Workload::hot \\(";
+
+    static class Workload {
+        static int hot(int i) {
+            if ((i & 3) == 0) {
+                return i * 3;
+            }
+            return i + 1;
+        }
+
+        public static void main(String[] args) {
+            long sum = 0;
+            for (int i = 0; i < 200_000; i++) {
+                sum += hot(i);
+            }
+            System.out.println("sum " + sum);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        String file = "profiles." + ProcessHandle.current().pid() + ".txt";
+
+        OutputAnalyzer out = run("-XX:ProfileCacheFile=" + file,
+                                 "-XX:+DumpProfileCacheAtExit",
+                                 "-Xbatch",
+                                 "-XX:+PrintCompilation",
+                                 "-Xlog:jit+compilation=info");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("Wrote profiles of");
+        out.shouldMatch(TIER3_HOT);
+        out.shouldMatch(TIER4_HOT);
+        if (!new File(file).exists()) {
+            throw new RuntimeException("profile cache file " + file + " was not written");
+        }
+
+        out = run("-XX:ProfileCacheFile=" + file,
+                  "-XX:+UseProfileCache",
+                  "-Xbatch",
+                  "-XX:+PrintCompilation",
+                  "-Xlog:jit+compilation=debug");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("Seeded profile of compiler.profiling.TestProfileCache$Workload.hot(I)I");
+        // The seeded method goes from the interpreter straight to C2.
+        out.shouldNotMatch(TIER3_HOT);
+        out.shouldMatch(TIER4_HOT);
+
+        // A missing file must not prevent startup.
+        out = run("-XX:ProfileCacheFile=" + file + ".missing",
+                  "-XX:+UseProfileCache");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("Could not open profile cache file");
+    }
+
+    static OutputAnalyzer run(String... flags) throws Exception {
+        String[] args = new String[flags.length + 1];
+        System.arraycopy(flags, 0, args, 0, flags.length);
+        args[flags.length] = Workload.class.getName();
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true, args);
+        return new OutputAnalyzer(pb.start());
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Red Hat, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestSlidingGC
+ * @key gc
+ * @requires vm.gc.Epsilon & !vm.graal.enabled
+ * @summary Epsilon sliding mark-compact reclaims garbage and keeps live objects intact
+ *
+ * @run main/othervm -Xmx64m -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *                   -XX:+EpsilonSlidingGC
+ *                   TestSlidingGC
+ *
+ * @run main/othervm -Xmx64m -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *                   -XX:+EpsilonSlidingGC -XX:+EpsilonUncommit
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+EpsilonVerify
+ *                   TestSlidingGC
+ *
+ * @run main/othervm -Xmx64m -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *                   -XX:+EpsilonSlidingGC -XX:-UseTLAB
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+EpsilonVerify
+ *                   TestSlidingGC
+ */
+
+public class TestSlidingGC {
+
+  static final int LIVE_COUNT = 100_000;
+
+  // Allocate several times more than the heap can hold
+  static final long TOTAL_BYTES = 1024L * 1024 * 1024;
+
+  static Object sink;
+
+  static class Node {
+    final int id;
+    Node next;
+    Node(int id) { this.id = id; }
+  }
+
+  public static void main(String... args) {
+    Node[] live = new Node[LIVE_COUNT];
+    for (int c = 0; c < LIVE_COUNT; c++) {
+      live[c] = new Node(c);
+      if (c > 0) {
+        live[c - 1].next = live[c];
+      }
+      // Hash some objects, so that their mark words are preserved
+      if ((c % 1000) == 0) {
+        System.identityHashCode(live[c]);
+      }
+    }
+
+    int[] hashes = new int[LIVE_COUNT];
+    for (int c = 0; c < LIVE_COUNT; c += 1000) {
+      hashes[c] = System.identityHashCode(live[c]);
+    }
+
+    long allocated = 0;
+    while (allocated < TOTAL_BYTES) {
+      sink = new byte[1024];
+      allocated += 1024;
+      if ((allocated % (1024 * 1024)) == 0) {
+        synchronized (live[(int) (allocated / 1024) % LIVE_COUNT]) {
+          sink = new Object[128];
+        }
+      }
+    }
+
+    Node n = live[0];
+    for (int c = 0; c < LIVE_COUNT; c++) {
+      if (n != live[c] || n.id != c) {
+        throw new IllegalStateException("Live object " + c + " is broken");
+      }
+      n = n.next;
+    }
+    if (n != null) {
+      throw new IllegalStateException("Live list is not terminated");
+    }
+
+    for (int c = 0; c < LIVE_COUNT; c += 1000) {
+      if (System.identityHashCode(live[c]) != hashes[c]) {
+        throw new IllegalStateException("Identity hash code of " + c + " is not preserved");
+      }
+    }
+  }
+}
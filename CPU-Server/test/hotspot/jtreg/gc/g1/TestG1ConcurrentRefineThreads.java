@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestG1ConcurrentRefineThreads
+ * @key gc
+ * @summary The number of refinement threads wanted follows the rate at which
+ *          cards are dirtied: it goes up under load and back down afterwards.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver TestG1ConcurrentRefineThreads
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestG1ConcurrentRefineThreads {
+
+    private static final Pattern WANTED =
+        Pattern.compile("Refinement threads wanted \\((\\w+)\\): (\\d+) \\(was (\\d+)\\)");
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xms256m",
+            "-Xmx256m",
+            "-Xmn32m",
+            "-XX:G1ConcRefinementThreads=4",
+            "-XX:+G1UseAdaptiveConcRefinement",
+            "-Xlog:gc+refine=debug",
+            CardDirtier.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain(CardDirtier.DONE);
+
+        // The log lines are in order: look for an increase, and a later
+        // decrease once the mutators stop dirtying cards.
+        boolean increased = false;
+        boolean decreasedAfterIncrease = false;
+        Matcher m = WANTED.matcher(output.getStdout());
+        while (m.find()) {
+            int wanted = Integer.parseInt(m.group(2));
+            int was = Integer.parseInt(m.group(3));
+            if (wanted > was) {
+                increased = true;
+            } else if (wanted < was && increased) {
+                decreasedAfterIncrease = true;
+            }
+        }
+        if (!increased) {
+            throw new RuntimeException("The number of refinement threads wanted never went up");
+        }
+        if (!decreasedAfterIncrease) {
+            throw new RuntimeException("The number of refinement threads wanted never went down after going up");
+        }
+    }
+
+    static class CardDirtier {
+        static final String DONE = "CardDirtier done";
+        static final int OLD_OBJECTS = 200_000;
+        static final long PHASE_MS = 5_000;
+
+        static Object sink;
+
+        static class Holder {
+            Object ref;
+        }
+
+        public static void main(String[] args) throws Exception {
+            Holder[] old = new Holder[OLD_OBJECTS];
+            for (int i = 0; i < OLD_OBJECTS; i++) {
+                old[i] = new Holder();
+            }
+            // Promote the holders, so that storing young objects into them
+            // dirties cards.
+            System.gc();
+
+            // Load: store freshly allocated objects all over the old
+            // generation from several threads.
+            Thread[] threads = new Thread[4];
+            for (int t = 0; t < threads.length; t++) {
+                final int seed = t;
+                threads[t] = new Thread(() -> {
+                    long end = System.currentTimeMillis() + PHASE_MS;
+                    int i = seed;
+                    while (System.currentTimeMillis() < end) {
+                        for (int j = 0; j < 10_000; j++) {
+                            i = (i * 1103515245 + 12345) & Integer.MAX_VALUE;
+                            old[i % OLD_OBJECTS].ref = new int[4];
+                        }
+                    }
+                });
+                threads[t].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+
+            // Quiet: keep allocating so that young collections measure the
+            // lower card dirtying rate, but do not touch the old objects.
+            long end = System.currentTimeMillis() + PHASE_MS;
+            while (System.currentTimeMillis() < end) {
+                for (int j = 0; j < 10_000; j++) {
+                    sink = new int[4];
+                }
+            }
+            System.out.println(DONE);
+        }
+    }
+}
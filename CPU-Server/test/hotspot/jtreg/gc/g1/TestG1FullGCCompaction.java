@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestG1FullGCCompaction
+ * @key gc
+ * @summary Run G1 full collections with many workers, compaction chains and
+ *          regions that are skipped because they are mostly live.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver TestG1FullGCCompaction
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestG1FullGCCompaction {
+
+    private static final Pattern PREPARED =
+        Pattern.compile("Prepared (\\d+) compaction chains, skipped compaction of (\\d+) regions");
+
+    public static void main(String[] args) throws Exception {
+        // A high dead ratio skips compaction of most of the dense regions.
+        runTest(90, 16, true);
+        runTest(90, 3, true);
+        // Without dead space allowance every region is compacted.
+        runTest(0, 16, false);
+        // Many short chains spread over many workers.
+        runTest(50, 16, true, "-XX:G1HeapWastePercent=1");
+    }
+
+    private static void runTest(int deadRatio, int threads, boolean expectSkipped, String... extraFlags) throws Exception {
+        List<String> flags = new ArrayList<>();
+        flags.add("-XX:+UseG1GC");
+        flags.add("-Xms128m");
+        flags.add("-Xmx128m");
+        flags.add("-XX:G1HeapRegionSize=1m");
+        flags.add("-XX:MarkSweepDeadRatio=" + deadRatio);
+        flags.add("-XX:ParallelGCThreads=" + threads);
+        flags.add("-XX:-UseDynamicNumberOfGCThreads");
+        for (String f : extraFlags) {
+            flags.add(f);
+        }
+        flags.add("-XX:+UnlockDiagnosticVMOptions");
+        flags.add("-XX:+VerifyBeforeGC");
+        flags.add("-XX:+VerifyAfterGC");
+        flags.add("-Xlog:gc+phases=debug");
+        flags.add(GCWorkload.class.getName());
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(flags.toArray(new String[0]));
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain(GCWorkload.DONE);
+
+        int fullGCs = 0;
+        int maxChains = 0;
+        int skipped = 0;
+        Matcher m = PREPARED.matcher(output.getStdout());
+        while (m.find()) {
+            fullGCs++;
+            maxChains = Math.max(maxChains, Integer.parseInt(m.group(1)));
+            skipped += Integer.parseInt(m.group(2));
+        }
+        if (fullGCs < GCWorkload.ROUNDS) {
+            throw new RuntimeException("Expected at least " + GCWorkload.ROUNDS + " full GCs, found " + fullGCs);
+        }
+        if (threads > 1 && maxChains < 2) {
+            throw new RuntimeException("Expected compaction to be split into several chains, found " + maxChains);
+        }
+        if (expectSkipped && skipped == 0) {
+            throw new RuntimeException("Expected some regions to skip compaction");
+        }
+        if (!expectSkipped && skipped != 0) {
+            throw new RuntimeException("Expected all regions to be compacted, " + skipped + " were skipped");
+        }
+    }
+
+    static class GCWorkload {
+        static final String DONE = "GCWorkload done";
+        static final int ROUNDS = 4;
+        static final int CHUNKS = 6_000;
+        static final int CHUNK_SIZE = 8 * 1024;
+
+        public static void main(String[] args) {
+            // Fill most of the heap with chunks whose contents identify them.
+            byte[][] chunks = new byte[CHUNKS][];
+            for (int i = 0; i < CHUNKS; i++) {
+                chunks[i] = newChunk(i);
+            }
+            System.gc();
+
+            for (int round = 0; round < ROUNDS; round++) {
+                // Empty one part of the heap almost completely and leave the
+                // rest dense, so that regions differ widely in liveness.
+                int from = (round * CHUNKS / ROUNDS);
+                int to = from + CHUNKS / ROUNDS;
+                for (int i = from; i < to; i++) {
+                    if ((i % 8) != 0) {
+                        chunks[i] = null;
+                    }
+                }
+                System.gc();
+                verify(chunks);
+
+                // Refill, so that the next round has objects to move again.
+                for (int i = from; i < to; i++) {
+                    if (chunks[i] == null) {
+                        chunks[i] = newChunk(i);
+                    }
+                }
+            }
+            System.gc();
+            verify(chunks);
+            System.out.println(DONE);
+        }
+
+        static byte[] newChunk(int i) {
+            byte[] b = new byte[CHUNK_SIZE];
+            for (int j = 0; j < b.length; j += 512) {
+                b[j] = (byte) (i + j);
+            }
+            return b;
+        }
+
+        static void verify(byte[][] chunks) {
+            for (int i = 0; i < chunks.length; i++) {
+                byte[] b = chunks[i];
+                if (b == null) {
+                    continue;
+                }
+                for (int j = 0; j < b.length; j += 512) {
+                    if (b[j] != (byte) (i + j)) {
+                        throw new RuntimeException("Chunk " + i + " is corrupted at " + j);
+                    }
+                }
+            }
+        }
+    }
+}
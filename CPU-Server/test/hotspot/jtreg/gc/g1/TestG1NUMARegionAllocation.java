@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestG1NUMARegionAllocation
+ * @summary Young collections with -XX:+UseNUMA run to completion and, on
+ *          machines with more than one memory node, report NUMA placement
+ *          statistics.
+ * @requires vm.gc.G1
+ * @requires os.family == "linux"
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main TestG1NUMARegionAllocation
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestG1NUMARegionAllocation {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-XX:+UseNUMA",
+            "-Xms64m",
+            "-Xmx64m",
+            "-XX:G1HeapRegionSize=1m",
+            "-Xlog:gc+heap+numa=info",
+            GarbageProducer.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        // Placement statistics are only printed if more than one node is active.
+        if (output.getStdout().contains("Placement match ratio")) {
+            output.shouldContain("Worker task locality match ratio");
+        }
+    }
+
+    static class GarbageProducer {
+        private static Object[] holder = new Object[1024];
+
+        public static void main(String[] args) {
+            for (int i = 0; i < 200_000; i++) {
+                holder[i % holder.length] = new byte[1024];
+            }
+            System.gc();
+        }
+    }
+}
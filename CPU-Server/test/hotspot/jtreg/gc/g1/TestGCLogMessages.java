@@ -99,11 +99,15 @@ public class TestGCLogMessages {
         new LogMessageWithLevel("Scanned Cards", Level.DEBUG),
         new LogMessageWithLevel("Skipped Cards", Level.DEBUG),
         new LogMessageWithLevel("Scan HCC", Level.TRACE),
+        // Merge RS
+        new LogMessageWithLevel("Merge Remembered Sets", Level.DEBUG),
+        new LogMessageWithLevel("Merged Cards", Level.TRACE),
+        new LogMessageWithLevel("Duplicate Cards", Level.TRACE),
         // Scan RS
         new LogMessageWithLevel("Scan RS", Level.DEBUG),
         new LogMessageWithLevel("Scanned Cards", Level.DEBUG),
         new LogMessageWithLevel("Claimed Cards", Level.DEBUG),
-        new LogMessageWithLevel("Skipped Cards", Level.DEBUG),
+        new LogMessageWithLevel("Empty Cards", Level.DEBUG),
         // Ext Root Scan
         new LogMessageWithLevel("Thread Roots", Level.TRACE),
         new LogMessageWithLevel("StringTable Roots", Level.TRACE),
@@ -143,6 +147,8 @@ public class TestGCLogMessages {
         new LogMessageWithLevel("Reference Processing", Level.DEBUG),
         // VM internal reference processing
         new LogMessageWithLevel("Weak Processing", Level.DEBUG),
+        new LogMessageWithLevel("Dead Items", Level.DEBUG),
+        new LogMessageWithLevel("Total Items", Level.DEBUG),
 
         new LogMessageWithLevelC2OrJVMCIOnly("DerivedPointerTable Update", Level.DEBUG),
         new LogMessageWithLevel("Start New Collection Set", Level.DEBUG),
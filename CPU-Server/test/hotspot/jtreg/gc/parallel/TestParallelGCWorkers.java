@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelGCWorkers
+ * @key gc
+ * @summary Run ParallelGC young and full collections on the work gang with
+ *          different worker counts, with and without dynamic worker counts.
+ * @requires vm.gc.Parallel
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ * @run driver TestParallelGCWorkers
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestParallelGCWorkers {
+
+    private static final String[] FULL_GC_FLAGS = { "-XX:+UseParallelOldGC", "-XX:-UseParallelOldGC" };
+    private static final int[] GC_THREADS = { 1, 2, 4, 7 };
+
+    public static void main(String[] args) throws Exception {
+        for (String fullGC : FULL_GC_FLAGS) {
+            for (int threads : GC_THREADS) {
+                runTest(fullGC, threads, "-XX:-UseDynamicNumberOfGCThreads");
+                runTest(fullGC, threads, "-XX:+UseDynamicNumberOfGCThreads");
+            }
+            // Vary the active worker count between collections.
+            runTest(fullGC, 4, "-XX:+UseDynamicNumberOfGCThreads",
+                    "-XX:+UnlockDiagnosticVMOptions", "-XX:+ForceDynamicNumberOfGCThreads");
+        }
+    }
+
+    private static void runTest(String fullGC, int threads, String... extraFlags) throws Exception {
+        List<String> flags = new ArrayList<>();
+        flags.add("-XX:+UseParallelGC");
+        flags.add(fullGC);
+        flags.add("-XX:ParallelGCThreads=" + threads);
+        for (String f : extraFlags) {
+            flags.add(f);
+        }
+        flags.add("-Xmx64m");
+        flags.add("-Xmn16m");
+        flags.add("-XX:+UnlockDiagnosticVMOptions");
+        flags.add("-XX:+VerifyBeforeGC");
+        flags.add("-XX:+VerifyAfterGC");
+        flags.add("-Xlog:gc");
+        flags.add(GCWorkload.class.getName());
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(flags.toArray(new String[0]));
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Pause Young");
+        output.shouldContain("Pause Full");
+        output.shouldContain(GCWorkload.DONE);
+    }
+
+    static class GCWorkload {
+        static final String DONE = "GCWorkload done";
+        static final int LIVE_COUNT = 50_000;
+        static final int ROUNDS = 6;
+
+        static Object sink;
+
+        static class Node {
+            final int id;
+            Node next;
+            Object payload;
+            Node(int id) { this.id = id; }
+        }
+
+        public static void main(String[] args) {
+            // Keep a linked list alive across collections so that every
+            // phase has objects to mark, copy, promote and compact.
+            Node[] live = new Node[LIVE_COUNT];
+            for (int i = 0; i < LIVE_COUNT; i++) {
+                live[i] = new Node(i);
+                if (i > 0) {
+                    live[i - 1].next = live[i];
+                }
+            }
+
+            for (int round = 0; round < ROUNDS; round++) {
+                // Young collections: churn short-lived garbage and replace
+                // some payloads so old-to-young references exist.
+                for (int i = 0; i < 200_000; i++) {
+                    byte[] b = new byte[128];
+                    sink = b;
+                    if ((i & 15) == 0) {
+                        live[i % LIVE_COUNT].payload = b;
+                    }
+                }
+                // Full collection: drop every other payload so compaction
+                // has holes to close.
+                for (int i = round & 1; i < LIVE_COUNT; i += 2) {
+                    live[i].payload = null;
+                }
+                System.gc();
+
+                int count = 0;
+                for (Node n = live[0]; n != null; n = n.next) {
+                    if (n.id != count) {
+                        throw new RuntimeException("Broken list at " + count + ": " + n.id);
+                    }
+                    count++;
+                }
+                if (count != LIVE_COUNT) {
+                    throw new RuntimeException("Expected " + LIVE_COUNT + " nodes, found " + count);
+                }
+            }
+            System.out.println(DONE);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2019, Red Hat, Inc. All rights reserved.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test TestLRBExpansion
+ * @summary C2 load-reference barriers resolve forwarded objects on loads, CAS and GetAndSet
+ * @key gc
+ * @requires vm.gc.Shenandoah & !vm.graal.enabled
+ * @requires vm.flavor == "server"
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *                   -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahVerify
+ *                   -XX:-TieredCompilation -Xbatch -XX:+UseCompressedOops
+ *                   TestLRBExpansion
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *                   -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahVerify
+ *                   -XX:-TieredCompilation -Xbatch -XX:-UseCompressedOops
+ *                   TestLRBExpansion
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *                   -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahVerify
+ *                   -XX:-TieredCompilation -Xbatch -XX:+UseCompressedOops -XX:-ShenandoahLoopOptsAfterExpansion
+ *                   TestLRBExpansion
+ */
+
+/* @test TestLRBExpansion-verify-opto
+ * @summary Check C2 barrier expansion with the barrier verifier
+ * @key gc
+ * @requires vm.gc.Shenandoah & !vm.graal.enabled
+ * @requires vm.flavor == "server" & vm.debug
+ *
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *                   -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahVerify
+ *                   -XX:+ShenandoahVerifyOptoBarriers
+ *                   -XX:-TieredCompilation -Xbatch -XX:+UseCompressedOops
+ *                   TestLRBExpansion
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UnlockExperimentalVMOptions -Xmx128m
+ *                   -XX:+UseShenandoahGC -XX:ShenandoahGCHeuristics=aggressive -XX:+ShenandoahVerify
+ *                   -XX:+ShenandoahVerifyOptoBarriers
+ *                   -XX:-TieredCompilation -Xbatch -XX:-UseCompressedOops
+ *                   TestLRBExpansion
+ */
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+
+public class TestLRBExpansion {
+
+    static final int ITERS = 20_000;
+    static final int NODES = 1_000;
+
+    static class Node {
+        final int id;
+        Node next;
+        Node(int id) { this.id = id; }
+    }
+
+    static class Holder {
+        Node ref;
+    }
+
+    static final VarHandle REF;
+    static final VarHandle ARR;
+
+    static {
+        try {
+            REF = MethodHandles.lookup().findVarHandle(Holder.class, "ref", Node.class);
+        } catch (ReflectiveOperationException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+        ARR = MethodHandles.arrayElementVarHandle(Node[].class);
+    }
+
+    static Object sink;
+
+    // Plain loads: LRB on the loaded field, with DecodeN under compressed oops.
+    static int walk(Node head) {
+        int sum = 0;
+        for (Node n = head; n != null; n = n.next) {
+            sum += n.id;
+        }
+        return sum;
+    }
+
+    // Stores: the stored value is EncodeP'ed under compressed oops.
+    static void relink(Node[] nodes) {
+        for (int i = 0; i < nodes.length - 1; i++) {
+            nodes[i].next = nodes[i + 1];
+        }
+        nodes[nodes.length - 1].next = null;
+    }
+
+    // CAS and exchange on fields: the expected value may be a from-space copy.
+    static boolean casField(Holder h, Node expected, Node update) {
+        return REF.compareAndSet(h, expected, update);
+    }
+
+    static Node caeField(Holder h, Node expected, Node update) {
+        return (Node) REF.compareAndExchange(h, expected, update);
+    }
+
+    static boolean weakCasField(Holder h, Node expected, Node update) {
+        return REF.weakCompareAndSet(h, expected, update);
+    }
+
+    static Node gasField(Holder h, Node update) {
+        return (Node) REF.getAndSet(h, update);
+    }
+
+    // The same operations on array elements.
+    static boolean casArray(Node[] a, int i, Node expected, Node update) {
+        return ARR.compareAndSet(a, i, expected, update);
+    }
+
+    static Node gasArray(Node[] a, int i, Node update) {
+        return (Node) ARR.getAndSet(a, i, update);
+    }
+
+    static void check(boolean cond, String msg) {
+        if (!cond) {
+            throw new RuntimeException(msg);
+        }
+    }
+
+    public static void main(String... args) {
+        Node[] nodes = new Node[NODES];
+        int expectedSum = 0;
+        for (int i = 0; i < NODES; i++) {
+            nodes[i] = new Node(i);
+            expectedSum += i;
+        }
+        relink(nodes);
+
+        Holder h = new Holder();
+        Node[] slots = new Node[16];
+
+        for (int iter = 0; iter < ITERS; iter++) {
+            // Churn the heap so the aggressive heuristics keep evacuating
+            // the live objects under the compiled code.
+            sink = new byte[1024];
+
+            relink(nodes);
+            check(walk(nodes[0]) == expectedSum, "list walk");
+
+            Node a = nodes[iter % NODES];
+            Node b = nodes[(iter + 1) % NODES];
+
+            h.ref = a;
+            check(casField(h, a, b), "CAS field should succeed");
+            check(h.ref == b, "CAS field stored value");
+            check(!casField(h, a, b), "CAS field should fail");
+
+            check(caeField(h, b, a) == b, "CAE field witness");
+            check(h.ref == a, "CAE field stored value");
+            check(caeField(h, b, a) == a, "CAE field failing witness");
+
+            while (!weakCasField(h, a, b)) {
+                // spurious failures are allowed
+            }
+            check(h.ref == b, "weak CAS field stored value");
+
+            check(gasField(h, a) == b, "GetAndSet field old value");
+            check(h.ref == a, "GetAndSet field stored value");
+
+            int s = iter & (slots.length - 1);
+            slots[s] = a;
+            check(casArray(slots, s, a, b), "CAS array should succeed");
+            check(!casArray(slots, s, a, b), "CAS array should fail");
+            check(gasArray(slots, s, a) == b, "GetAndSet array old value");
+            check(slots[s] == a, "GetAndSet array stored value");
+
+            check(a.id == iter % NODES, "node identity after evacuation");
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Idle monitors are deflated by the ServiceThread while threads
+ *          keep entering, waiting on and hashing the same objects.
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver runtime.Monitor.TestAsyncDeflation
+ */
+
+package runtime.Monitor;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestAsyncDeflation {
+    static class Workload {
+        static final int OBJECTS = 1024;
+        static final Object[] locks = new Object[OBJECTS];
+        static final int[] hashes = new int[OBJECTS];
+        static volatile long counter;
+
+        public static void main(String[] args) throws Exception {
+            for (int i = 0; i < OBJECTS; i++) {
+                locks[i] = new Object();
+                hashes[i] = System.identityHashCode(locks[i]);
+            }
+            Thread[] threads = new Thread[8];
+            for (int t = 0; t < threads.length; t++) {
+                final int seed = t;
+                threads[t] = new Thread(() -> {
+                    long deadline = System.currentTimeMillis() + 3000;
+                    int i = seed;
+                    while (System.currentTimeMillis() < deadline) {
+                        i = (i * 31 + 7) & (OBJECTS - 1);
+                        Object o = locks[i];
+                        synchronized (o) {
+                            counter++;
+                            if ((i & 15) == 0) {
+                                try {
+                                    o.wait(1);
+                                } catch (InterruptedException e) {
+                                    throw new RuntimeException(e);
+                                }
+                            }
+                        }
+                        if (System.identityHashCode(o) != hashes[i]) {
+                            throw new RuntimeException("identity hash of object " + i + " changed");
+                        }
+                    }
+                });
+                threads[t].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+            System.out.println("counter " + counter);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true,
+            "-XX:+AsyncDeflateIdleMonitors",
+            "-XX:AsyncDeflationInterval=10",
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:MonitorUsedDeflationThreshold=0",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:GuaranteedSafepointInterval=100",
+            "-Xlog:monitorinflation=info",
+            Workload.class.getName());
+        OutputAnalyzer out = new OutputAnalyzer(pb.start());
+        out.shouldHaveExitValue(0);
+        out.shouldMatch("async deflation: \\d+ monitors in use, [1-9]\\d* deflated");
+    }
+}
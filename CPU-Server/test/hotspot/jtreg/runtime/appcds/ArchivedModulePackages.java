@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary The packages of the boot layer modules are archived at dump time
+ *          and used to define the same modules when the archive is mapped.
+ * @requires vm.cds
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver ArchivedModulePackages
+ */
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class ArchivedModulePackages {
+    public static void main(String[] args) throws Exception {
+        String archive = "archived-module-packages." + ProcessHandle.current().pid() + ".jsa";
+
+        OutputAnalyzer out = run("-Xshare:dump",
+                                 "-XX:SharedArchiveFile=" + archive,
+                                 "-Xlog:cds+module=info");
+        out.shouldHaveExitValue(0);
+        out.shouldMatch("Archived [0-9]+ packages of [0-9]+ modules");
+
+        out = run("-Xshare:on",
+                  "-XX:SharedArchiveFile=" + archive,
+                  "-Xlog:cds+module=debug",
+                  "-version");
+        out.shouldHaveExitValue(0);
+        out.shouldMatch("Defined module java.base with [0-9]+ archived packages");
+        out.shouldMatch("Defined module java.sql with [0-9]+ archived packages");
+
+        out = run("-Xshare:off",
+                  "-Xlog:cds+module=debug",
+                  "-version");
+        out.shouldHaveExitValue(0);
+        out.shouldMatch("Defined module java.base with [0-9]+ checked packages");
+        out.shouldNotContain("archived packages");
+    }
+
+    static OutputAnalyzer run(String... args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true, args);
+        return new OutputAnalyzer(pb.start());
+    }
+}
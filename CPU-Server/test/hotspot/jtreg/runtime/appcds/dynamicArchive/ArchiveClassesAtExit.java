@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary -XX:ArchiveClassesAtExit writes an archive at exit that the
+ *          next run maps and loads the application classes from.
+ * @requires vm.cds
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @build ArchiveClassesAtExitApp
+ * @run driver ClassFileInstaller -jar archive-at-exit.jar ArchiveClassesAtExitApp ArchiveClassesAtExitApp$Extra
+ * @run driver ArchiveClassesAtExit
+ */
+
+import java.io.File;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class ArchiveClassesAtExit {
+    // The archive is dumped by a detached process after the run exits.
+    static final long DUMP_TIMEOUT_MS = 120_000;
+
+    public static void main(String[] args) throws Exception {
+        String appJar = new File("archive-at-exit.jar").getAbsolutePath();
+        String archive = "archive-at-exit." + ProcessHandle.current().pid() + ".jsa";
+        File archiveFile = new File(archive);
+
+        // The first run loads its classes from the jar and writes the archive.
+        OutputAnalyzer out = run(appJar, archive);
+        out.shouldHaveExitValue(0);
+        out.shouldContain("Hello from ArchiveClassesAtExitApp");
+        out.shouldContain("Dumping archive " + archive + " in the background");
+        waitForDump(archiveFile, 0);
+
+        // The second run maps the archive and leaves it alone.
+        out = run(appJar, archive);
+        out.shouldHaveExitValue(0);
+        out.shouldContain("ArchiveClassesAtExitApp source: shared objects file");
+        out.shouldContain("All classes were loaded from " + archive);
+
+        // The third run loads one more class from the jar, so the archive
+        // is rewritten from a class list that also records the classes the
+        // run loaded from the archive.
+        long lastModified = archiveFile.lastModified();
+        out = run(appJar, archive, "extra");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("ArchiveClassesAtExitApp source: shared objects file");
+        out.shouldContain("ArchiveClassesAtExitApp$Extra source: file:");
+        out.shouldContain("Dumping archive " + archive + " in the background");
+        waitForDump(archiveFile, lastModified);
+
+        // The rewritten archive has both the old and the new class.
+        out = run(appJar, archive, "extra");
+        out.shouldHaveExitValue(0);
+        out.shouldContain("ArchiveClassesAtExitApp source: shared objects file");
+        out.shouldContain("ArchiveClassesAtExitApp$Extra source: shared objects file");
+        out.shouldContain("All classes were loaded from " + archive);
+    }
+
+    static void waitForDump(File archive, long lastModified) throws Exception {
+        long deadline = System.currentTimeMillis() + DUMP_TIMEOUT_MS;
+        while (!archive.exists() || archive.lastModified() == lastModified) {
+            if (System.currentTimeMillis() > deadline) {
+                throw new RuntimeException("archive " + archive + " was not written");
+            }
+            Thread.sleep(100);
+        }
+    }
+
+    static OutputAnalyzer run(String appJar, String archive, String... appArgs) throws Exception {
+        String[] cmd = new String[6 + appArgs.length];
+        cmd[0] = "-XX:ArchiveClassesAtExit=" + archive;
+        cmd[1] = "-Xlog:cds=info";
+        cmd[2] = "-Xlog:class+load=info";
+        cmd[3] = "-cp";
+        cmd[4] = appJar;
+        cmd[5] = "ArchiveClassesAtExitApp";
+        System.arraycopy(appArgs, 0, cmd, 6, appArgs.length);
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(true, cmd);
+        return new OutputAnalyzer(pb.start());
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Compiler.dump_profiles writes the profiles of the methods
+ *          compiled by C2 to the given file.
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main/othervm -Xbatch -XX:CompileCommand=dontinline,DumpProfilesTest::hot DumpProfilesTest
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+public class DumpProfilesTest {
+    static int hot(int i) {
+        return (i & 3) == 0 ? i * 3 : i + 1;
+    }
+
+    public static void main(String[] args) throws Exception {
+        long sum = 0;
+        for (int i = 0; i < 200_000; i++) {
+            sum += hot(i);
+        }
+        System.out.println("sum " + sum);
+
+        File file = new File("profiles." + ProcessHandle.current().pid() + ".txt");
+        file.delete();
+        OutputAnalyzer out = new PidJcmdExecutor().execute("Compiler.dump_profiles " + file.getPath());
+        out.shouldMatch("Wrote profiles of [1-9][0-9]* methods to " + file.getPath());
+        String profiles = new String(Files.readAllBytes(file.toPath()));
+        if (!profiles.contains("\nmethod DumpProfilesTest hot (I)I 4 ")) {
+            throw new RuntimeException("No level 4 profile of DumpProfilesTest.hot in " + file);
+        }
+
+        // Without a file name the command falls back to ProfileCacheFile.
+        out = new PidJcmdExecutor().execute("Compiler.dump_profiles");
+        out.shouldContain("No file name given and ProfileCacheFile is not set");
+    }
+}
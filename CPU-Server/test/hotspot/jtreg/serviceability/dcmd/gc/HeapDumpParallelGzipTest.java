@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary GC.heap_dump writes valid HPROF files in parallel and gzipped.
+ * @requires vm.gc.G1
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 HeapDumpParallelGzipTest
+ */
+
+import java.io.BufferedInputStream;
+import java.io.DataInputStream;
+import java.io.EOFException;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.zip.GZIPInputStream;
+
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+
+public class HeapDumpParallelGzipTest {
+    static final int HPROF_HEAP_DUMP_SEGMENT    = 0x1C;
+    static final int HPROF_HEAP_DUMP_END        = 0x2C;
+
+    static final int HPROF_NORMAL_OBJECT        = 0x02;
+    static final int HPROF_BOOLEAN              = 0x04;
+    static final int HPROF_CHAR                 = 0x05;
+    static final int HPROF_FLOAT                = 0x06;
+    static final int HPROF_DOUBLE               = 0x07;
+    static final int HPROF_BYTE                 = 0x08;
+    static final int HPROF_SHORT                = 0x09;
+    static final int HPROF_INT                  = 0x0A;
+    static final int HPROF_LONG                 = 0x0B;
+
+    static final int HPROF_GC_ROOT_UNKNOWN      = 0xFF;
+    static final int HPROF_GC_ROOT_JNI_GLOBAL   = 0x01;
+    static final int HPROF_GC_ROOT_JNI_LOCAL    = 0x02;
+    static final int HPROF_GC_ROOT_JAVA_FRAME   = 0x03;
+    static final int HPROF_GC_ROOT_NATIVE_STACK = 0x04;
+    static final int HPROF_GC_ROOT_STICKY_CLASS = 0x05;
+    static final int HPROF_GC_ROOT_THREAD_BLOCK = 0x06;
+    static final int HPROF_GC_ROOT_MONITOR_USED = 0x07;
+    static final int HPROF_GC_ROOT_THREAD_OBJ   = 0x08;
+    static final int HPROF_GC_CLASS_DUMP        = 0x20;
+    static final int HPROF_GC_INSTANCE_DUMP     = 0x21;
+    static final int HPROF_GC_OBJ_ARRAY_DUMP    = 0x22;
+    static final int HPROF_GC_PRIM_ARRAY_DUMP   = 0x23;
+
+    // larger than any dump buffer, so it is written in a segment of its own
+    static final int HUGE_ARRAY_LENGTH = 4 * 1024 * 1024;
+
+    static Object[] retained;
+
+    static int idSize;
+    static int hugeArrays;
+
+    public static void main(String[] args) throws Exception {
+        retained = new Object[100_000];
+        for (int i = 0; i < retained.length; i++) {
+            retained[i] = (i % 3 == 0) ? new int[i % 100] : "s" + i;
+        }
+        retained[0] = new long[HUGE_ARRAY_LENGTH];
+
+        check(dump("serial", "-parallel=1"), false, false);
+        check(dump("parallel", "-parallel=4"), false, true);
+        check(dump("gzip", "-gz=1 -parallel=1"), true, false);
+        check(dump("parallel-gzip", "-gz=1"), true, true);
+
+        OutputAnalyzer out = new PidJcmdExecutor().execute("GC.heap_dump -gz=10 invalid.hprof");
+        out.shouldContain("Compression level out of range (0-9)");
+    }
+
+    static File dump(String name, String options) throws Exception {
+        File file = new File("heapdump-" + name + ".hprof");
+        file.delete();
+        OutputAnalyzer out = new PidJcmdExecutor().execute("GC.heap_dump " + options + " " + file.getPath());
+        out.shouldContain("Heap dump file created");
+        return file;
+    }
+
+    // Walks the top level records by their lengths, which must end exactly
+    // with the HPROF_HEAP_DUMP_END record, and the sub-records of every
+    // HPROF_HEAP_DUMP_SEGMENT.
+    static void check(File file, boolean gzipped, boolean parallel) throws IOException {
+        InputStream in = new BufferedInputStream(new FileInputStream(file));
+        if (gzipped) {
+            in = new GZIPInputStream(in);
+        }
+        try (DataInputStream data = new DataInputStream(in)) {
+            StringBuilder header = new StringBuilder();
+            int c;
+            while ((c = data.read()) > 0) {
+                header.append((char) c);
+            }
+            if (!header.toString().equals("JAVA PROFILE 1.0.2")) {
+                throw new RuntimeException(file + ": unexpected header " + header);
+            }
+            idSize = data.readInt();
+            if (idSize != 4 && idSize != 8) {
+                throw new RuntimeException(file + ": unexpected identifier size " + idSize);
+            }
+            data.readLong(); // time stamp
+
+            int segments = 0;
+            hugeArrays = 0;
+            while (true) {
+                int tag = data.read();
+                if (tag < 0) {
+                    throw new RuntimeException(file + ": missing HPROF_HEAP_DUMP_END");
+                }
+                data.readInt(); // time
+                long length = data.readInt() & 0xFFFFFFFFL;
+                if (tag == HPROF_HEAP_DUMP_END) {
+                    if (length != 0 || data.read() != -1) {
+                        throw new RuntimeException(file + ": data after HPROF_HEAP_DUMP_END");
+                    }
+                    break;
+                }
+                if (tag == HPROF_HEAP_DUMP_SEGMENT) {
+                    segments++;
+                    checkSegment(file, data, length);
+                } else {
+                    skipFully(data, length);
+                }
+            }
+            if (hugeArrays != 1) {
+                throw new RuntimeException(file + ": found " + hugeArrays + " long[" + HUGE_ARRAY_LENGTH + "] arrays");
+            }
+            if (segments < (parallel ? 2 : 1)) {
+                throw new RuntimeException(file + ": only " + segments + " heap dump segments");
+            }
+            System.out.println(file + ": " + segments + " segments");
+        } finally {
+            file.delete();
+        }
+    }
+
+    // The sub-records must end exactly at the end of the segment, and the
+    // huge array must be the only sub-record of its segment.
+    static void checkSegment(File file, DataInputStream data, long length) throws IOException {
+        long left = length;
+        int records = 0;
+        boolean huge = false;
+        while (left > 0) {
+            int tag = data.readUnsignedByte();
+            long size = 1;
+            switch (tag) {
+            case HPROF_GC_ROOT_UNKNOWN:
+            case HPROF_GC_ROOT_STICKY_CLASS:
+            case HPROF_GC_ROOT_MONITOR_USED:
+                size += skip(data, idSize);
+                break;
+            case HPROF_GC_ROOT_JNI_GLOBAL:
+                size += skip(data, 2 * idSize);
+                break;
+            case HPROF_GC_ROOT_NATIVE_STACK:
+            case HPROF_GC_ROOT_THREAD_BLOCK:
+                size += skip(data, idSize + 4);
+                break;
+            case HPROF_GC_ROOT_JNI_LOCAL:
+            case HPROF_GC_ROOT_JAVA_FRAME:
+            case HPROF_GC_ROOT_THREAD_OBJ:
+                size += skip(data, idSize + 8);
+                break;
+            case HPROF_GC_CLASS_DUMP: {
+                // class, stack trace, super, loader, signers, protection
+                // domain, two reserved ids and the instance size
+                size += skip(data, 7 * idSize + 8);
+                int constants = data.readUnsignedShort();
+                size += 2;
+                for (int i = 0; i < constants; i++) {
+                    data.readUnsignedShort(); // constant pool index
+                    size += 2 + 1 + skip(data, valueSize(file, data.readUnsignedByte()));
+                }
+                int statics = data.readUnsignedShort();
+                size += 2;
+                for (int i = 0; i < statics; i++) {
+                    skip(data, idSize); // name
+                    size += idSize + 1 + skip(data, valueSize(file, data.readUnsignedByte()));
+                }
+                int fields = data.readUnsignedShort();
+                size += 2;
+                for (int i = 0; i < fields; i++) {
+                    skip(data, idSize); // name
+                    valueSize(file, data.readUnsignedByte());
+                    size += idSize + 1;
+                }
+                break;
+            }
+            case HPROF_GC_INSTANCE_DUMP: {
+                size += skip(data, 2 * idSize + 4);
+                long fieldsLength = data.readInt() & 0xFFFFFFFFL;
+                size += 4 + skip(data, fieldsLength);
+                break;
+            }
+            case HPROF_GC_OBJ_ARRAY_DUMP: {
+                size += skip(data, idSize + 4);
+                long elements = data.readInt() & 0xFFFFFFFFL;
+                size += 4 + skip(data, idSize) + skip(data, elements * idSize);
+                break;
+            }
+            case HPROF_GC_PRIM_ARRAY_DUMP: {
+                size += skip(data, idSize + 4);
+                long elements = data.readInt() & 0xFFFFFFFFL;
+                int type = data.readUnsignedByte();
+                size += 4 + 1 + skip(data, elements * valueSize(file, type));
+                if (type == HPROF_LONG && elements == HUGE_ARRAY_LENGTH) {
+                    huge = true;
+                    hugeArrays++;
+                }
+                break;
+            }
+            default:
+                throw new RuntimeException(file + ": unexpected sub-record tag 0x" + Integer.toHexString(tag));
+            }
+            left -= size;
+            records++;
+        }
+        if (left != 0) {
+            throw new RuntimeException(file + ": sub-records overrun the segment by " + (-left) + " bytes");
+        }
+        if (huge && records != 1) {
+            throw new RuntimeException(file + ": huge array shares its segment with " + (records - 1) + " sub-records");
+        }
+    }
+
+    static int valueSize(File file, int type) {
+        switch (type) {
+        case HPROF_NORMAL_OBJECT: return idSize;
+        case HPROF_BOOLEAN:
+        case HPROF_BYTE:          return 1;
+        case HPROF_CHAR:
+        case HPROF_SHORT:         return 2;
+        case HPROF_FLOAT:
+        case HPROF_INT:           return 4;
+        case HPROF_DOUBLE:
+        case HPROF_LONG:          return 8;
+        default:
+            throw new RuntimeException(file + ": unexpected basic type 0x" + Integer.toHexString(type));
+        }
+    }
+
+    static long skip(DataInputStream data, long length) throws IOException {
+        skipFully(data, length);
+        return length;
+    }
+
+    static void skipFully(DataInputStream data, long length) throws IOException {
+        while (length > 0) {
+            long n = data.skip(length);
+            if (n <= 0) {
+                if (data.read() < 0) {
+                    throw new EOFException();
+                }
+                n = 1;
+            }
+            length -= n;
+        }
+    }
+}
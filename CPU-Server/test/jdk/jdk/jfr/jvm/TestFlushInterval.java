@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jdk.jfr.jvm;
+
+import java.io.RandomAccessFile;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.List;
+import java.util.stream.Collectors;
+import java.util.stream.Stream;
+
+import jdk.jfr.Event;
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordingFile;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+/*
+ * @test
+ * @summary With a flush interval, the chunk that is being written can be
+ *          read up to its last flush point while the recording runs.
+ * @key jfr
+ * @requires vm.hasJFR
+ * @library /test/lib
+ * @run main/othervm -XX:FlightRecorderOptions=flush-interval=1s,repository=flush-repository jdk.jfr.jvm.TestFlushInterval
+ */
+
+/*
+ * @test
+ * @summary Flush intervals below one second are rejected, since every flush
+ *          is a safepoint.
+ * @key jfr
+ * @requires vm.hasJFR
+ * @library /test/lib
+ * @run driver jdk.jfr.jvm.TestFlushInterval rejected
+ */
+public class TestFlushInterval {
+    static class FlushedEvent extends Event {
+        int value;
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && args[0].equals("rejected")) {
+            testRejected();
+            return;
+        }
+        try (Recording recording = new Recording()) {
+            recording.enable(FlushedEvent.class);
+            recording.setToDisk(true);
+            recording.start();
+
+            FlushedEvent event = new FlushedEvent();
+            event.value = 4711;
+            event.commit();
+
+            List<RecordedEvent> events = readFlushedEvents(60_000);
+            if (events.stream().noneMatch(e -> e.getEventType().getName().equals(FlushedEvent.class.getName())
+                                               && e.getInt("value") == 4711)) {
+                throw new RuntimeException("Committed event was not found in the flushed chunk");
+            }
+            recording.stop();
+        }
+    }
+
+    static void testRejected() throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:StartFlightRecording", "-XX:FlightRecorderOptions=flush-interval=500ms", "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("flush-interval must be 0 or at least 1 s");
+        output.shouldNotHaveExitValue(0);
+    }
+
+    // Reads the events of the current chunk up to its last flush point.
+    static List<RecordedEvent> readFlushedEvents(long timeoutMillis) throws Exception {
+        long deadline = System.currentTimeMillis() + timeoutMillis;
+        while (System.currentTimeMillis() < deadline) {
+            Thread.sleep(1000);
+            for (Path chunk : chunks()) {
+                List<RecordedEvent> events = readFlushed(chunk);
+                if (events.stream().anyMatch(e -> e.getEventType().getName().equals(FlushedEvent.class.getName()))) {
+                    return events;
+                }
+            }
+        }
+        throw new RuntimeException("No flushed chunk with the committed event within " + timeoutMillis + " ms");
+    }
+
+    static List<Path> chunks() throws Exception {
+        try (Stream<Path> paths = Files.walk(Paths.get("flush-repository"))) {
+            return paths.filter(p -> p.toString().endsWith(".jfr")).collect(Collectors.toList());
+        }
+    }
+
+    static final int HEADER_SIZE = 68;
+    static final int CHUNK_SIZE_POSITION = 8;
+    static final int FILE_STATE_POSITION = 64;
+    static final byte FILE_STATE_GUARD = (byte) 0xff;
+
+    // Copies the chunk up to its last flush point. The header is only used
+    // if the file state was not GUARD and the chunk size did not change
+    // while it was read, see JfrChunkWriter::flush_chunk().
+    static List<RecordedEvent> readFlushed(Path chunk) throws Exception {
+        byte[] flushed = null;
+        try (RandomAccessFile file = new RandomAccessFile(chunk.toFile(), "r")) {
+            while (flushed == null) {
+                if (file.length() < HEADER_SIZE) {
+                    return List.of();
+                }
+                file.seek(FILE_STATE_POSITION);
+                byte state = file.readByte();
+                file.seek(CHUNK_SIZE_POSITION);
+                long size = file.readLong();
+                if (state == FILE_STATE_GUARD) {
+                    Thread.sleep(10);
+                    continue;
+                }
+                if (size < HEADER_SIZE || size > file.length()) {
+                    return List.of();
+                }
+                byte[] bytes = new byte[(int) size];
+                file.seek(0);
+                file.readFully(bytes);
+                file.seek(CHUNK_SIZE_POSITION);
+                long sizeAfter = file.readLong();
+                file.seek(FILE_STATE_POSITION);
+                byte stateAfter = file.readByte();
+                if (sizeAfter == size && stateAfter != FILE_STATE_GUARD) {
+                    flushed = bytes;
+                }
+            }
+        }
+        Path copy = Files.createTempFile(Paths.get("."), "flushed", ".jfr");
+        Files.write(copy, flushed);
+        return RecordingFile.readAllEvents(copy);
+    }
+}